@@ -0,0 +1,130 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*
+ * Benchmark for FarFlashReader. Compares the time taken to copy a 128x128 16-bit block of flash
+ * to the panel with the per-byte pgm_read_byte_near/pgm_read_byte_far loop that rawFlashTransfer()
+ * used to run and with drawUncompressedBitmap(), which now streams the block with 'elpm Z+'.
+ *
+ * The block starts 16Kb below the first 64Kb boundary so that both readers cross a segment. It is
+ * whatever program code happens to be there, so the panel shows noise. The results are printed to
+ * the serial port at 115200 baud. Change the typedef to measure other access modes.
+ *
+ * test/host/FlashReadTest runs the same comparison on a desktop host with counted cycle costs.
+ */
+
+#include "Generic16BitILI9325.h"
+
+using namespace lcd;
+
+typedef ILI9325_Portrait_64K_Xmem16 TftPanel;
+typedef Xmem16AccessMode TftAccessMode;
+
+TftPanel *tft;
+
+enum {
+  BLOCK_ADDRESS = 0xc000,
+  BLOCK_WIDTH = 128,
+  BLOCK_HEIGHT = 128,
+  ITERATIONS = 20
+};
+
+
+/*
+ * The reader that the drivers used before FarFlashReader
+ */
+
+void oldFlashTransfer(uint32_t data,uint32_t numBytes) {
+
+  uint32_t numPixels;
+
+  numPixels=numBytes/2;
+
+  while(data<65536 && numPixels>0) {
+    TftAccessMode::writeData(pgm_read_byte_near(data),pgm_read_byte_near(data+1));
+    data+=2;
+    numPixels--;
+  }
+
+  while(numPixels>0) {
+    TftAccessMode::writeData(pgm_read_byte_far(data),pgm_read_byte_far(data+1));
+    data+=2;
+    numPixels--;
+  }
+}
+
+
+void setup() {
+
+  Serial.begin(115200);
+
+  tft=new TftPanel;
+  tft->setBackground(ColourNames::BLACK);
+  tft->clearScreen();
+}
+
+
+void loop() {
+
+  Bitmap bm;
+  uint32_t start,oldTime,newTime;
+  uint8_t i;
+
+  bm.Dimensions.Width=BLOCK_WIDTH;
+  bm.Dimensions.Height=BLOCK_HEIGHT;
+  bm.Pixels=BLOCK_ADDRESS;
+  bm.DataSize=static_cast<uint32_t>(BLOCK_WIDTH)*BLOCK_HEIGHT*2;
+
+  // the old per-byte reader
+
+  start=micros();
+
+  for(i=0;i<ITERATIONS;i++) {
+    tft->moveTo(Rectangle(0,0,BLOCK_WIDTH,BLOCK_HEIGHT));
+    tft->beginWriting();
+    oldFlashTransfer(bm.Pixels,bm.DataSize);
+  }
+
+  oldTime=(micros()-start)/ITERATIONS;
+
+  // FarFlashReader via the access mode
+
+  start=micros();
+
+  for(i=0;i<ITERATIONS;i++)
+    tft->drawUncompressedBitmap(Point(0,BLOCK_HEIGHT),bm);
+
+  newTime=(micros()-start)/ITERATIONS;
+
+  Serial.print("pixels: ");
+  Serial.println(static_cast<uint32_t>(BLOCK_WIDTH)*BLOCK_HEIGHT);
+  Serial.print("old reader us: ");
+  Serial.println(oldTime);
+  Serial.print("FarFlashReader us: ");
+  Serial.println(newTime);
+  Serial.print("old cycles/pixel: ");
+  Serial.println(oldTime*(F_CPU/1000000)/(static_cast<uint32_t>(BLOCK_WIDTH)*BLOCK_HEIGHT));
+  Serial.print("new cycles/pixel: ");
+  Serial.println(newTime*(F_CPU/1000000)/(static_cast<uint32_t>(BLOCK_WIDTH)*BLOCK_HEIGHT));
+  Serial.println();
+
+  delay(5000);
+}
@@ -34,15 +34,19 @@ namespace lcd {
 
 	/**
 	 * Constructor
-	 * @param type FONT_BITMAP or FONT_LZG.
+	 * @param type FONT_BITMAP, FONT_LZG or FONT_SPAN.
 	 * @param firstChar The first character in this font, usually an ASCII code.
 	 * @param characterCount The number of consecutive characters in this font.
 	 * @param height The font height in pixels.
 	 * @param spacing The spacing between characters in pixels.
 	 * @param characters A pointer to an array of FontChar structures that define each sequential character
+	 * @param index Optional table of the position in the characters array of each code from firstChar
+	 * onwards, with NO_CHARACTER for codes that the font does not have, or null.
+	 * @param indexSize The number of entries in the index table.
+	 * @param widths Optional table of the pixel width of each character, or null.
 	 */
 
-	FontBase::FontBase(FontType type,uint8_t firstChar,uint8_t characterCount,uint8_t height,uint8_t spacing,const struct FontChar *characters) {
+	FontBase::FontBase(FontType type,uint8_t firstChar,uint8_t characterCount,uint8_t height,uint8_t spacing,const struct FontChar *characters,const uint8_t *index,uint16_t indexSize,const uint8_t *widths) {
 
 		_fontType=type;
 		_characterCount=characterCount;
@@ -50,59 +54,89 @@ namespace lcd {
 		_height=height;
 		_characterSpacing=spacing;
 		_characters=characters;
+		_index=index;
+		_indexSize=indexSize;
+		_widths=widths;
 	}
 
 
 	/**
-	 * Get the font character definition in progmem space
+	 * Find the position of a character in the FontChar array. If the font has an index table
+	 * then the position is read from the entry for the character. Fonts without an index table
+	 * must have sequential character codes and the position is calculated directly.
 	 * @param character The character code.
-	 * @param fc The strucutre to fill in.
+	 * @return The position in the FontChar array, or -1 if the font does not have the character.
 	 */
 
-	void FontBase::getCharacter(uint8_t character,FontChar& fc) const {
+	int16_t FontBase::getCharacterIndex(uint8_t character) const {
 
 		const FontChar *ptr;
-		uint8_t c;
-		int16_t i;
-
-		// the bulk of the characters are in sequential order, see if we can
-		// index directly into the character array to find it
+		uint8_t c,index;
 
-		if(character-_firstCharacter<_characterCount) {
+		// codes below the first character wrap around to large offsets
 
-			// don't try this at home kids...
+		c=character-_firstCharacter;
 
-			ptr=&_characters[character-_firstCharacter];
-			c=pgm_read_byte(reinterpret_cast<const uint8_t *>(ptr)+offsetof(FontChar,Code));
+		if(_index) {
 
-			// ...ok you can start looking again
+			if(c>=_indexSize)
+				return -1;
 
-			if(c==character) {
-				memcpy_P(&fc,ptr,sizeof(FontChar));
-				return;
-			}
+			index=pgm_read_byte(_index+c);
+			return index==NO_CHARACTER ? -1 : index;
 		}
 
-		// did't find it, search for it going backwards because the likelihood is that
-		// it's towards the end of the array
+		if(c>=_characterCount)
+			return -1;
 
-		for(i=_characterCount-1;i>=0;i--) {
+		// don't try this at home kids...
 
-			// this is the stuff that gives C a bad name...
+		ptr=&_characters[c];
 
-			ptr=&_characters[i];
-			c=pgm_read_byte(reinterpret_cast<const uint8_t *>(ptr)+offsetof(FontChar,Code));
+		// ...ok you can start looking again
 
-			// ...ok you can start looking again
+		if(pgm_read_byte(reinterpret_cast<const uint8_t *>(ptr)+offsetof(FontChar,Code))!=character)
+			return -1;
 
-			if(c==character) {
-				memcpy_P(&fc,ptr,sizeof(FontChar));
-				return;
-			}
-		}
+		return c;
+	}
+
+
+	/**
+	 * Get the font character definition in progmem space
+	 * @param character The character code.
+	 * @param fc The strucutre to fill in.
+	 */
+
+	void FontBase::getCharacter(uint8_t character,FontChar& fc) const {
+
+		int16_t index;
+
+		if((index=getCharacterIndex(character))<0)
+			index=1;								// default to first char if not found
+
+		memcpy_P(&fc,&_characters[index],sizeof(FontChar));
+	}
+
+
+	/**
+	 * Get the pixel width of a character without copying out its FontChar definition. The width
+	 * table is used if the font has one.
+	 * @param character The character code.
+	 * @return The width in pixels.
+	 */
+
+	uint8_t FontBase::getCharacterWidth(uint8_t character) const {
+
+		int16_t index;
+
+		if((index=getCharacterIndex(character))<0)
+			index=1;
+
+		if(_widths)
+			return pgm_read_byte(_widths+index);
 
-		ptr=&_characters[1]; 		// default to first char if not found
-		memcpy_P(&fc,ptr,sizeof(fc));
+		return pgm_read_byte(reinterpret_cast<const uint8_t *>(&_characters[index])+offsetof(FontChar,PixelWidth));
 	}
 
 
@@ -128,7 +162,7 @@ namespace lcd {
 
 	/**
 	 * Get the font type
-	 * @return FONT_BITMAP or FONT_LZG
+	 * @return FONT_BITMAP, FONT_LZG or FONT_SPAN
 	 */
 
 	FontBase::FontType FontBase::getType() const {
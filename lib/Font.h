@@ -49,9 +49,14 @@ namespace lcd {
 	class FontBase {
 
 		public:
+			enum {
+				NO_CHARACTER = 0xff			///< index table entry for a code that is not in the font
+			};
+
 			enum FontType {
 				FONT_BITMAP,
-				FONT_LZG
+				FONT_LZG,
+				FONT_SPAN
 			} _fontType;
 
 		protected:
@@ -59,12 +64,17 @@ namespace lcd {
 			uint8_t _height;
 			uint8_t _characterSpacing;
 			uint8_t _firstCharacter;
+			uint16_t _indexSize;
 			const struct FontChar * _characters;
+			const uint8_t * _index;
+			const uint8_t * _widths;
 
 		public:
-			FontBase(FontType type,uint8_t firstChar,uint8_t characterCount,uint8_t height,uint8_t spacing,const struct FontChar *characters);
+			FontBase(FontType type,uint8_t firstChar,uint8_t characterCount,uint8_t height,uint8_t spacing,const struct FontChar *characters,const uint8_t *index,uint16_t indexSize,const uint8_t *widths);
 
+			int16_t getCharacterIndex(uint8_t character) const;
 			void getCharacter(uint8_t character,FontChar& fc) const;
+			uint8_t getCharacterWidth(uint8_t character) const;
 			uint16_t getId() const;
 			uint8_t getHeight() const;
 			uint8_t getCharacterSpacing() const;
@@ -90,10 +100,13 @@ namespace lcd {
 			 * @param height The font height in pixels.
 			 * @param spacing The spacing between characters in pixels.
 			 * @param characters A pointer to an array of FontChar structures that define each sequential character
+			 * @param index Optional table of the position in the characters array of each code from firstChar onwards.
+			 * @param indexSize The number of entries in the index table.
+			 * @param widths Optional table of the pixel width of each character, in the same order as the characters array.
 			 */
 
-			Font(uint8_t firstChar,uint8_t characterCount,uint8_t height,uint8_t spacing,const struct FontChar *characters)
-				: FontBase(FONT_BITMAP,firstChar,characterCount,height,spacing,characters) {
+			Font(uint8_t firstChar,uint8_t characterCount,uint8_t height,uint8_t spacing,const struct FontChar *characters,const uint8_t *index=0,uint16_t indexSize=0,const uint8_t *widths=0)
+				: FontBase(FONT_BITMAP,firstChar,characterCount,height,spacing,characters,index,indexSize,widths) {
 			}
 	};
 
@@ -116,10 +129,45 @@ namespace lcd {
 			 * @param height The font height in pixels.
 			 * @param spacing The spacing between characters in pixels.
 			 * @param characters A pointer to an array of FontChar structures that define each sequential character
+			 * @param index Optional table of the position in the characters array of each code from firstChar onwards.
+			 * @param indexSize The number of entries in the index table.
+			 * @param widths Optional table of the pixel width of each character, in the same order as the characters array.
+			 */
+
+			LzgFont(uint8_t firstChar,uint8_t characterCount,uint8_t height,uint8_t spacing,const struct FontChar *characters,const uint8_t *index=0,uint16_t indexSize=0,const uint8_t *widths=0)
+				: FontBase(FONT_LZG,firstChar,characterCount,height,spacing,characters,index,indexSize,widths) {
+			}
+	};
+
+
+	/**
+	 * @brief Span font structure for transparent text.
+	 *
+	 * Each character is stored as the runs of foreground pixels on each of its rows. The data for a
+	 * row is a count byte followed by that many pairs of (x offset, length) bytes. Background pixels
+	 * are not stored and are never written so text can be drawn over any existing content.
+	 * FontConv creates instances of this class when the "Arduino spans" target is selected.
+	 *
+	 * @ingroup Fonts
+	 */
+
+	class SpanFont : public FontBase {
+		public:
+
+			/**
+			 * Constructor
+			 * @param firstChar The first character in this font, usually an ASCII code.
+			 * @param characterCount The number of consecutive characters in this font.
+			 * @param height The font height in pixels.
+			 * @param spacing The spacing between characters in pixels.
+			 * @param characters A pointer to an array of FontChar structures that define each sequential character
+			 * @param index Optional table of the position in the characters array of each code from firstChar onwards.
+			 * @param indexSize The number of entries in the index table.
+			 * @param widths Optional table of the pixel width of each character, in the same order as the characters array.
 			 */
 
-			LzgFont(uint8_t firstChar,uint8_t characterCount,uint8_t height,uint8_t spacing,const struct FontChar *characters)
-				: FontBase(FONT_LZG,firstChar,characterCount,height,spacing,characters) {
+			SpanFont(uint8_t firstChar,uint8_t characterCount,uint8_t height,uint8_t spacing,const struct FontChar *characters,const uint8_t *index=0,uint16_t indexSize=0,const uint8_t *widths=0)
+				: FontBase(FONT_SPAN,firstChar,characterCount,height,spacing,characters,index,indexSize,widths) {
 			}
 	};
 }
@@ -7,11 +7,13 @@ namespace lcd {
   // helper so the user can just do 'new fontname' without having to know the parameters
 
   extern const struct FontChar FDEF_APPLE_CHAR[];
+  extern const uint8_t FDEF_APPLE_INDEX[];
+  extern const uint8_t FDEF_APPLE_WIDTHS[];
 
   class Font_APPLE8 : public Font {
     public:
       Font_APPLE8()
-        : Font(32,95,8,0,FDEF_APPLE_CHAR) {
+        : Font(32,95,8,0,FDEF_APPLE_CHAR,FDEF_APPLE_INDEX,95,FDEF_APPLE_WIDTHS) {
       }
   };
 }
@@ -7,11 +7,13 @@ namespace lcd {
   // helper so the user can just do 'new fontname' without having to know the parameters
 
   extern const struct FontChar FDEF_KYROU_9_REGULAR_BOLD_CHAR[];
+  extern const uint8_t FDEF_KYROU_9_REGULAR_BOLD_INDEX[];
+  extern const uint8_t FDEF_KYROU_9_REGULAR_BOLD_WIDTHS[];
 
   class Font_KYROU_9_REGULAR_BOLD8 : public Font {
     public:
       Font_KYROU_9_REGULAR_BOLD8()
-        : Font(32,95,12,0,FDEF_KYROU_9_REGULAR_BOLD_CHAR) {
+        : Font(32,95,12,0,FDEF_KYROU_9_REGULAR_BOLD_CHAR,FDEF_KYROU_9_REGULAR_BOLD_INDEX,95,FDEF_KYROU_9_REGULAR_BOLD_WIDTHS) {
       }
   };
 }
@@ -7,11 +7,13 @@ namespace lcd {
   // helper so the user can just do 'new fontname' without having to know the parameters
 
   extern const struct FontChar FDEF_KYROU_9_REGULAR_CHAR[];
+  extern const uint8_t FDEF_KYROU_9_REGULAR_INDEX[];
+  extern const uint8_t FDEF_KYROU_9_REGULAR_WIDTHS[];
 
   class Font_KYROU_9_REGULAR8 : public Font {
     public:
       Font_KYROU_9_REGULAR8()
-        : Font(32,95,12,0,FDEF_KYROU_9_REGULAR_CHAR) {
+        : Font(32,95,12,0,FDEF_KYROU_9_REGULAR_CHAR,FDEF_KYROU_9_REGULAR_INDEX,95,FDEF_KYROU_9_REGULAR_WIDTHS) {
       }
   };
 }
@@ -7,11 +7,13 @@ namespace lcd {
   // helper so the user can just do 'new fontname' without having to know the parameters
 
   extern const struct FontChar FDEF_TAMA_SS01_CHAR[];
+  extern const uint8_t FDEF_TAMA_SS01_INDEX[];
+  extern const uint8_t FDEF_TAMA_SS01_WIDTHS[];
 
   class Font_TAMA_SS0117 : public Font {
     public:
       Font_TAMA_SS0117()
-        : Font(32,95,13,2,FDEF_TAMA_SS01_CHAR) {
+        : Font(32,95,13,2,FDEF_TAMA_SS01_CHAR,FDEF_TAMA_SS01_INDEX,95,FDEF_TAMA_SS01_WIDTHS) {
       }
   };
 }
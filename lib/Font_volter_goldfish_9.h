@@ -7,11 +7,13 @@ namespace lcd {
   // helper so the user can just do 'new fontname' without having to know the parameters
 
   extern const struct FontChar FDEF_VOLTER__28GOLDFISH_29_CHAR[];
+  extern const uint8_t FDEF_VOLTER__28GOLDFISH_29_INDEX[];
+  extern const uint8_t FDEF_VOLTER__28GOLDFISH_29_WIDTHS[];
 
   class Font_VOLTER__28GOLDFISH_299 : public Font {
     public:
       Font_VOLTER__28GOLDFISH_299()
-        : Font(32,95,10,1,FDEF_VOLTER__28GOLDFISH_29_CHAR) {
+        : Font(32,95,10,1,FDEF_VOLTER__28GOLDFISH_29_CHAR,FDEF_VOLTER__28GOLDFISH_29_INDEX,95,FDEF_VOLTER__28GOLDFISH_29_WIDTHS) {
       }
   };
 }
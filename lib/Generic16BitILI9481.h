@@ -32,18 +32,29 @@
 #include "PanelConfiguration.h"
 #include "gl/Point.h"
 #include "gl/Rectangle.h"
+#include "gl/DirtyRegion.h"
 #include "gl/Size.h"
+#include "gl/Span.h"
+#include "gl/Gradient.h"
 #include "gl/Bitmap.h"
 #include "gl/DoublePrecision.h"
+#include "gl/NumberFormat.h"
 #include "gl/ColourNames.h"
+#include "drv/accessModes/FarFlashReader.h"
 #include "drv/accessModes/Xmem16AccessMode.h"
 #include "drv/accessModes/Gpio16LatchAccessMode.h"
-#include "drv/ILI9481/ILI9481.h"
+#include "drv/ili9481/ILI9481.h"
 #include "GetFarAddress.h"
 #include "Font.h"
+#include "decoders/ByteSources.h"
 #include "decoders/PicoJpeg.h"
 #include "decoders/LzgFlashDecoder.h"
+#include "drv/accessModes/ClippingStreamAccessMode.h"
+#include "drv/accessModes/SramStreamAccessMode.h"
 #include "gl/GraphicsLibrary.h"
+#include "gl/DrawList.h"
+#include "gl/GlyphCache.h"
+#include "gl/NumericField.h"
 #include "Backlight.h"
 #include "terminal/TerminalPortraitImpl.h"
 #include "terminal/TerminalLandscapeImpl.h"
@@ -0,0 +1,112 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file HostSimulation.h
+ * @brief Typedefs for running the library on a desktop host against a model of the panel GRAM.
+ *
+ * Build with the 'host' directory first on the include path, e.g.
+ *
+ *   g++ -no-pie -Ilib/host -Ilib mytest.cpp lib/Font.cpp lib/gl/Point.cpp
+ *
+ * then draw with the usual GraphicsLibrary API and inspect the result through
+ * HostAccessMode<...>::getGramModel().
+ */
+
+
+#pragma once
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+#include "PanelConfiguration.h"
+#include "gl/Point.h"
+#include "gl/Rectangle.h"
+#include "gl/DirtyRegion.h"
+#include "gl/Size.h"
+#include "gl/Span.h"
+#include "gl/Gradient.h"
+#include "gl/Bitmap.h"
+#include "gl/DoublePrecision.h"
+#include "gl/NumberFormat.h"
+#include "gl/ColourNames.h"
+#include "drv/accessModes/HostAccessMode.h"
+#include "drv/ili9325/ILI9325.h"
+#include "drv/ili9325/ILI9325GramModel.h"
+#include "drv/mc2pa8201/panelTraits/Nokia6300_TypeA.h"
+#include "drv/mc2pa8201/MC2PA8201.h"
+#include "drv/mc2pa8201/MC2PA8201GramModel.h"
+#include "GetFarAddress.h"
+#include "Font.h"
+#include "decoders/ByteSources.h"
+#include "decoders/PicoJpeg.h"
+#include "decoders/LzgFlashDecoder.h"
+#include "drv/accessModes/ClippingStreamAccessMode.h"
+#include "drv/accessModes/SramStreamAccessMode.h"
+#include "gl/GraphicsLibrary.h"
+#include "gl/DrawList.h"
+#include "gl/GlyphCache.h"
+#include "gl/NumericField.h"
+#include "terminal/TerminalPortraitImpl.h"
+#include "terminal/TerminalLandscapeImpl.h"
+
+
+namespace lcd {
+
+#if !defined(__AVR__)
+
+	/*
+	 * Host access modes backed by each of the GRAM models
+	 */
+
+	typedef HostAccessMode<ILI9325GramModel> ILI9325HostAccessMode;
+	typedef HostAccessMode<MC2PA8201GramModel> MC2PA8201HostAccessMode;
+
+	/*
+	 * ILI9325 on the host: 64K and 262K colours, portrait and landscape
+	 */
+
+	typedef GraphicsLibrary<ILI9325<PORTRAIT,COLOURS_16BIT,ILI9325HostAccessMode>,ILI9325HostAccessMode> ILI9325_Portrait_64K_Host;
+	typedef GraphicsLibrary<ILI9325<LANDSCAPE,COLOURS_16BIT,ILI9325HostAccessMode>,ILI9325HostAccessMode> ILI9325_Landscape_64K_Host;
+
+	typedef GraphicsLibrary<ILI9325<PORTRAIT,COLOURS_18BIT,ILI9325HostAccessMode>,ILI9325HostAccessMode> ILI9325_Portrait_262K_Host;
+	typedef GraphicsLibrary<ILI9325<LANDSCAPE,COLOURS_18BIT,ILI9325HostAccessMode>,ILI9325HostAccessMode> ILI9325_Landscape_262K_Host;
+
+	typedef TerminalPortraitImpl<ILI9325_Portrait_64K_Host> ILI9325_Terminal_Portrait_64K_Host;
+	typedef TerminalLandscapeImpl<ILI9325_Landscape_64K_Host> ILI9325_Terminal_Landscape_64K_Host;
+
+	/*
+	 * MC2PA8201 (Nokia 6300 type A) on the host: 64K, 262K, 16M colours, portrait and landscape
+	 */
+
+	typedef GraphicsLibrary<MC2PA8201<PORTRAIT,COLOURS_16BIT,MC2PA8201HostAccessMode,Nokia6300_TypeA>,MC2PA8201HostAccessMode> Nokia6300_Portrait_64K_Host;
+	typedef GraphicsLibrary<MC2PA8201<LANDSCAPE,COLOURS_16BIT,MC2PA8201HostAccessMode,Nokia6300_TypeA>,MC2PA8201HostAccessMode> Nokia6300_Landscape_64K_Host;
+
+	typedef GraphicsLibrary<MC2PA8201<PORTRAIT,COLOURS_18BIT,MC2PA8201HostAccessMode,Nokia6300_TypeA>,MC2PA8201HostAccessMode> Nokia6300_Portrait_262K_Host;
+	typedef GraphicsLibrary<MC2PA8201<LANDSCAPE,COLOURS_18BIT,MC2PA8201HostAccessMode,Nokia6300_TypeA>,MC2PA8201HostAccessMode> Nokia6300_Landscape_262K_Host;
+
+	typedef GraphicsLibrary<MC2PA8201<PORTRAIT,COLOURS_24BIT,MC2PA8201HostAccessMode,Nokia6300_TypeA>,MC2PA8201HostAccessMode> Nokia6300_Portrait_16M_Host;
+	typedef GraphicsLibrary<MC2PA8201<LANDSCAPE,COLOURS_24BIT,MC2PA8201HostAccessMode,Nokia6300_TypeA>,MC2PA8201HostAccessMode> Nokia6300_Landscape_16M_Host;
+
+	typedef TerminalPortraitImpl<Nokia6300_Portrait_64K_Host> Nokia6300_Terminal_Portrait_64K_Host;
+	typedef TerminalLandscapeImpl<Nokia6300_Landscape_64K_Host> Nokia6300_Terminal_Landscape_64K_Host;
+
+#endif
+}
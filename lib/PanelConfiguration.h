@@ -67,6 +67,18 @@ namespace lcd {
 
 	enum Direction {
 		HORIZONTAL,						///< going horizontally
-		VERTICAL							///< going vertically
+		VERTICAL,							///< going vertically
+		DIAGONAL							///< going from the top-left to the bottom-right
+	};
+
+
+	/**
+	 * Whether the driver keeps a shadow copy of the window registers so that moveTo() only
+	 * writes the registers whose values have changed. Not every driver supports shadowing.
+	 */
+
+	enum WindowShadowing {
+		WINDOW_SHADOW_OFF,			///< always write every window register
+		WINDOW_SHADOW_ON				///< skip window register writes that would not change the value
 	};
 }
@@ -0,0 +1,487 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file ByteSources.h
+ * @brief Flash, SRAM, serial and file sources for the bitmap decoders.
+ * @ingroup Decoders
+ */
+
+#pragma once
+
+
+namespace lcd {
+
+	/**
+	 * @brief Base class for the sources that bitmaps are read from.
+	 *
+	 * A source hands out the bytes of one asset in blocks. The LZG and uncompressed bitmap decoders
+	 * pull from a source in chunks, so an asset may live in internal flash, SRAM, external storage
+	 * reached through an Arduino Stream or, on a host build, a file.
+	 *
+	 * @ingroup Decoders
+	 */
+
+	class ByteSource {
+
+		public:
+			virtual ~ByteSource() {}
+
+			/**
+			 * Read the next block of bytes.
+			 * @param buffer Where to store the bytes.
+			 * @param maxBytes The most bytes to read.
+			 * @return The number of bytes actually read. Zero means that the source is exhausted.
+			 */
+
+			virtual uint16_t readBytes(uint8_t *buffer,uint16_t maxBytes)=0;
+
+			virtual void skip(uint32_t numBytes);
+			uint16_t readFully(uint8_t *buffer,uint16_t numBytes);
+	};
+
+
+	/**
+	 * Skip over bytes that are not needed. This implementation reads and discards them, sources
+	 * that can seek override it.
+	 * @param numBytes The number of bytes to skip.
+	 */
+
+	inline void ByteSource::skip(uint32_t numBytes) {
+
+		uint8_t discard[16];
+		uint16_t count;
+
+		while(numBytes) {
+
+			if((count=readBytes(discard,numBytes<sizeof(discard) ? numBytes : sizeof(discard)))==0)
+				return;
+
+			numBytes-=count;
+		}
+	}
+
+
+	/**
+	 * Read exactly the number of bytes asked for unless the source runs out first. Sources such as
+	 * a Stream may return fewer bytes than asked for from each call to readBytes().
+	 * @param buffer Where to store the bytes.
+	 * @param numBytes The number of bytes to read.
+	 * @return The number of bytes read. This is less than numBytes only at the end of the source.
+	 */
+
+	inline uint16_t ByteSource::readFully(uint8_t *buffer,uint16_t numBytes) {
+
+		uint16_t count,total;
+
+		for(total=0;total<numBytes;total+=count)
+			if((count=readBytes(buffer+total,numBytes-total))==0)
+				break;
+
+		return total;
+	}
+
+
+	/**
+	 * @brief Source for reading from flash memory. The full range of flash memory is supported.
+	 *
+	 * Blocks are copied out of flash with the sequential FarFlashReader so the segment register
+	 * is loaded once per block rather than once per byte.
+	 *
+	 * @ingroup Decoders
+	 */
+
+	class FlashByteSource : public ByteSource {
+
+		protected:
+			uint32_t _address;
+			uint32_t _remaining;
+
+		public:
+
+			/**
+			 * Constructor
+			 * @param address The 32-bit address of the data in flash, e.g. from GET_FAR_ADDRESS().
+			 * @param size The size of the data.
+			 */
+
+			FlashByteSource(uint32_t address,uint32_t size)
+				: _address(address),
+				  _remaining(size) {
+			}
+
+
+			/**
+			 * Virtual destructor
+			 */
+
+			virtual ~FlashByteSource() {}
+
+
+			/**
+			 * Read the next block of bytes from flash.
+			 * @param buffer Where to store the bytes.
+			 * @param maxBytes The most bytes to read.
+			 * @return The number of bytes actually read.
+			 */
+
+			virtual uint16_t readBytes(uint8_t *buffer,uint16_t maxBytes) {
+
+				uint16_t count;
+#if defined(__AVR__)
+				uint16_t address,segment,numBytes;
+#endif
+
+				count=_remaining<maxBytes ? _remaining : maxBytes;
+				_remaining-=count;
+
+#if defined(__AVR__)
+
+				numBytes=count;
+
+				while(numBytes) {
+
+					segment=FarFlashReader::beginSegment(_address,numBytes);
+					address=_address;
+					_address+=segment;
+					numBytes-=segment;
+
+					while(segment--)
+						*buffer++=FarFlashReader::read(address);
+				}
+#else
+				memcpy(buffer,reinterpret_cast<const void *>(static_cast<uintptr_t>(_address)),count);
+				_address+=count;
+#endif
+
+				return count;
+			}
+
+
+			/**
+			 * Skip bytes by moving the address on.
+			 * @param numBytes The number of bytes to skip.
+			 */
+
+			virtual void skip(uint32_t numBytes) {
+
+				if(numBytes>_remaining)
+					numBytes=_remaining;
+
+				_address+=numBytes;
+				_remaining-=numBytes;
+			}
+	};
+
+
+	/**
+	 * @brief Source for reading from SRAM, including external SRAM.
+	 * @ingroup Decoders
+	 */
+
+	class SramByteSource : public ByteSource {
+
+		protected:
+			const uint8_t *_data;
+			uint32_t _remaining;
+
+		public:
+
+			/**
+			 * Constructor
+			 * @param data The address of the data.
+			 * @param size The size of the data.
+			 */
+
+			SramByteSource(const uint8_t *data,uint32_t size)
+				: _data(data),
+				  _remaining(size) {
+			}
+
+
+			/**
+			 * Virtual destructor
+			 */
+
+			virtual ~SramByteSource() {}
+
+
+			/**
+			 * Read the next block of bytes from SRAM.
+			 * @param buffer Where to store the bytes.
+			 * @param maxBytes The most bytes to read.
+			 * @return The number of bytes actually read.
+			 */
+
+			virtual uint16_t readBytes(uint8_t *buffer,uint16_t maxBytes) {
+
+				uint16_t count;
+
+				count=_remaining<maxBytes ? _remaining : maxBytes;
+				_remaining-=count;
+
+				memcpy(buffer,_data,count);
+				_data+=count;
+
+				return count;
+			}
+
+
+			/**
+			 * Skip bytes by moving the pointer on.
+			 * @param numBytes The number of bytes to skip.
+			 */
+
+			virtual void skip(uint32_t numBytes) {
+
+				if(numBytes>_remaining)
+					numBytes=_remaining;
+
+				_data+=numBytes;
+				_remaining-=numBytes;
+			}
+	};
+
+
+	/**
+	 * @brief Source for reading from an Arduino Stream such as a serial port or a file on an SD card.
+	 *
+	 * Each block waits until its bytes have arrived so the sender must supply the whole asset.
+	 *
+	 * @ingroup Decoders
+	 */
+
+	class StreamByteSource : public ByteSource {
+
+		protected:
+			Stream *_stream;
+			uint32_t _remaining;
+
+		public:
+
+			/**
+			 * Constructor
+			 * @param stream The stream to read from.
+			 * @param size The number of bytes in the asset.
+			 */
+
+			StreamByteSource(Stream& stream,uint32_t size)
+				: _stream(&stream),
+				  _remaining(size) {
+			}
+
+
+			/**
+			 * Virtual destructor
+			 */
+
+			virtual ~StreamByteSource() {}
+
+
+			/**
+			 * Read the next block of bytes from the stream.
+			 * @param buffer Where to store the bytes.
+			 * @param maxBytes The most bytes to read.
+			 * @return The number of bytes actually read.
+			 */
+
+			virtual uint16_t readBytes(uint8_t *buffer,uint16_t maxBytes) {
+
+				uint16_t count,i;
+
+				count=_remaining<maxBytes ? _remaining : maxBytes;
+				_remaining-=count;
+
+				for(i=0;i<count;i++) {
+					while(_stream->available()==0);
+					*buffer++=_stream->read();
+				}
+
+				return count;
+			}
+	};
+
+
+#if !defined(__AVR__)
+
+	/**
+	 * @brief Source for reading from a file on a host build.
+	 * @ingroup Decoders
+	 */
+
+	class FileByteSource : public ByteSource {
+
+		protected:
+			FILE *_file;
+			uint32_t _remaining;
+
+		public:
+
+			/**
+			 * Constructor
+			 * @param file The file to read from, positioned at the start of the asset.
+			 * @param size The number of bytes in the asset.
+			 */
+
+			FileByteSource(FILE *file,uint32_t size)
+				: _file(file),
+				  _remaining(size) {
+			}
+
+
+			/**
+			 * Virtual destructor
+			 */
+
+			virtual ~FileByteSource() {}
+
+
+			/**
+			 * Read the next block of bytes from the file.
+			 * @param buffer Where to store the bytes.
+			 * @param maxBytes The most bytes to read.
+			 * @return The number of bytes actually read.
+			 */
+
+			virtual uint16_t readBytes(uint8_t *buffer,uint16_t maxBytes) {
+
+				uint16_t count;
+
+				count=fread(buffer,1,_remaining<maxBytes ? _remaining : maxBytes,_file);
+				_remaining-=count;
+
+				return count;
+			}
+
+
+			/**
+			 * Skip bytes by seeking forward.
+			 * @param numBytes The number of bytes to skip.
+			 */
+
+			virtual void skip(uint32_t numBytes) {
+
+				if(numBytes>_remaining)
+					numBytes=_remaining;
+
+				if(fseek(_file,numBytes,SEEK_CUR)==0)
+					_remaining-=numBytes;
+			}
+	};
+
+#endif
+
+
+	/**
+	 * @brief Buffered byte-at-a-time reader on top of a ByteSource.
+	 *
+	 * The LZG decoder consumes its input a byte at a time. This reader refills a small buffer
+	 * from the source in blocks so that the cost of the virtual call and the source's own setup
+	 * is paid once per block instead of once per byte.
+	 *
+	 * @tparam TBufferSize The size of the buffer in bytes.
+	 * @ingroup Decoders
+	 */
+
+	template<uint8_t TBufferSize=32>
+	class BufferedByteReader {
+
+		protected:
+			ByteSource *_source;
+			uint8_t *_next;
+			uint8_t *_end;
+			uint8_t _buffer[TBufferSize];
+
+		protected:
+			void refill();
+
+		public:
+			BufferedByteReader(ByteSource& source);
+
+			uint8_t readByte();
+			void skip(uint32_t numBytes);
+	};
+
+
+	/**
+	 * Constructor
+	 * @param source The source to read from.
+	 */
+
+	template<uint8_t TBufferSize>
+	inline BufferedByteReader<TBufferSize>::BufferedByteReader(ByteSource& source)
+		: _source(&source),
+		  _next(_buffer),
+		  _end(_buffer) {
+	}
+
+
+	/**
+	 * Read the next byte. Zero is returned once the source is exhausted.
+	 * @return The byte.
+	 */
+
+	template<uint8_t TBufferSize>
+	inline uint8_t BufferedByteReader<TBufferSize>::readByte() {
+
+		if(_next==_end) {
+
+			refill();
+
+			if(_next==_end)
+				return 0;
+		}
+
+		return *_next++;
+	}
+
+
+	/**
+	 * Skip over bytes, using up the buffer first.
+	 * @param numBytes The number of bytes to skip.
+	 */
+
+	template<uint8_t TBufferSize>
+	inline void BufferedByteReader<TBufferSize>::skip(uint32_t numBytes) {
+
+		uint16_t buffered;
+
+		buffered=_end-_next;
+
+		if(numBytes<=buffered)
+			_next+=numBytes;
+		else {
+			_next=_end;
+			_source->skip(numBytes-buffered);
+		}
+	}
+
+
+	/**
+	 * Refill the buffer with the next block from the source.
+	 */
+
+	template<uint8_t TBufferSize>
+	inline void BufferedByteReader<TBufferSize>::refill() {
+		_next=_buffer;
+		_end=_buffer+_source->readBytes(_buffer,TBufferSize);
+	}
+}
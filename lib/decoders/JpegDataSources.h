@@ -181,4 +181,46 @@ namespace lcd {
 				}
 			}
 	};
+
+
+	/**
+	 * @brief Data source for reading a JPEG from any ByteSource, e.g. SRAM or a file on the host
+	 * @ingroup Decoders
+	 */
+
+	class JpegByteSourceDataSource : public JpegDataSource {
+
+		protected:
+			ByteSource *_source;
+
+		public:
+
+			/**
+			 * Constructor
+			 * @param source The source of the JPEG data
+			 */
+
+			JpegByteSourceDataSource(ByteSource& source)
+			  : _source(&source) {
+			}
+
+
+			/**
+			 * Virtual destructor
+			 */
+
+			virtual ~JpegByteSourceDataSource() {}
+
+
+			/**
+			 * Get more bytes for the JPEG decoder.
+			 * @param pBuf Where to store the bytes.
+			 * @param bufsize How many bytes to try to read.
+			 * @param[out] The number of bytes that we actually read.
+			 */
+
+			virtual void readNextBytes(uint8_t *pBuf,uint8_t bufsize,uint8_t *actuallyRead) {
+				*actuallyRead=_source->readFully(pBuf,bufsize);
+			}
+	};
 }
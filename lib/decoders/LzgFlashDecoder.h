@@ -31,97 +31,260 @@ namespace lcd {
 
 
 	/**
-	 * LZG decoder template class
-	 * @tparam AccessMode The access mode in use
+	 * Write a run of identical pixels for the LZG decoder. The primary template is used for byte
+	 * streams of unknown format and is never called.
+	 * @tparam TAccessMode The access mode in use
+	 * @tparam TBytesPerPixel The number of bytes in a pixel
+	 * @ingroup Decoders
+	 */
+
+	template<class TAccessMode,uint8_t TBytesPerPixel>
+	struct LzgPixelRun {
+		static void write(uint16_t /* numPixels */,const uint8_t * /* pixel */) {
+		}
+	};
+
+
+	/**
+	 * Write a run of identical 16-bit pixels
 	 * @ingroup Decoders
 	 */
 
 	template<class TAccessMode>
+	struct LzgPixelRun<TAccessMode,2> {
+		static void write(uint16_t numPixels,const uint8_t *pixel) {
+			TAccessMode::writeMultiData(numPixels,pixel[0],pixel[1]);
+		}
+	};
+
+
+	/**
+	 * Write a run of identical 18 or 24-bit pixels
+	 * @ingroup Decoders
+	 */
+
+	template<class TAccessMode>
+	struct LzgPixelRun<TAccessMode,3> {
+		static void write(uint16_t numPixels,const uint8_t *pixel) {
+			TAccessMode::writeMultiData(numPixels,pixel[0],pixel[1],pixel[2]);
+		}
+	};
+
+
+	/**
+	 * Select the pixel size to give LzgFlashDecoder for an access mode. A run can only be sent as a
+	 * burst when a pixel boundary is also a transfer boundary in writeStreamedData(), otherwise the
+	 * burst would not put the same data on the bus as streaming the bytes. That holds for 2 and 3 byte
+	 * pixels on an 8-bit bus and for 2 byte pixels on a 16-bit bus. Any other combination, such as an
+	 * 18-bit ILI9325 on a 16-bit bus, is decoded as plain bytes.
+	 * @tparam TAccessMode The access mode in use
+	 * @tparam TBytesPerPixel The size of the pixels in the stream
+	 * @ingroup Decoders
+	 */
+
+	template<class TAccessMode,uint8_t TBytesPerPixel>
+	struct LzgStreamPixelSize {
+		enum {
+			VALUE = TBytesPerPixel % TAccessMode::STREAM_TRANSFER_BYTES==0 ? TBytesPerPixel : 1		///< the pixel size to decode with
+		};
+	};
+
+
+	/**
+	 * History window for the LZG decoder. Declare a context once, e.g. as a static or global object,
+	 * and pass it to each decode so the window is not set up again on the stack for every bitmap
+	 * or font character.
+	 *
+	 * The window must be at least as large as the one the asset needs. bm2rgbi records that size
+	 * at the end of the asset and the decoder will not decode an asset that needs a larger window
+	 * than the context has. The default of 2056 bytes covers every copy except a distant copy, so it
+	 * decodes anything compressed at level 1. Font characters and small bitmaps are fine with windows
+	 * down to 512 bytes. Windows larger than 2056 bytes allow distant copies and are best placed
+	 * in external SRAM.
+	 *
+	 * @tparam TWindowSize The size of the history window in bytes.
+	 * @ingroup Decoders
+	 */
+
+	template<uint32_t TWindowSize=2056>
+	struct LzgDecoderContext {
+		uint8_t History[TWindowSize];				///< the circular history buffer
+	};
+
+
+	/**
+	 * LZG decoder template class
+	 *
+	 * If the pixel size of the stream is known then the decoder can spot copies that repeat the
+	 * previous pixel, which is how LZG encodes a run of flat colour. A copy whose offset is the pixel
+	 * size and that starts on a pixel boundary is written as a single writeMultiData() burst instead of
+	 * byte by byte. Literals still go through writeStreamedData(), which assembles them into whole bus
+	 * transfers in the access mode.
+	 *
+	 * @tparam TAccessMode The access mode in use
+	 * @tparam TBytesPerPixel The number of bytes in each pixel of the stream, 2 or 3. The default of 1
+	 * treats the stream as plain bytes and must be used with access modes that only implement
+	 * writeStreamedData(), such as ClippingStreamAccessMode. Use LzgStreamPixelSize to choose the
+	 * value so that bursts are only used where they match the streamed transfers.
+	 *
+	 * The compressed data is pulled in chunks from a ByteSource, so it does not have to be in flash
+	 * despite the name of the class.
+	 *
+	 * @ingroup Decoders
+	 */
+
+	template<class TAccessMode,uint8_t TBytesPerPixel=1>
 	class LzgFlashDecoder {
 
 		protected:
+
+			enum {
+				MIN_RUN_PIXELS = 2,				///< shorter runs are cheaper to stream than to set up a burst
+				HEADER_SIZE = 16,					///< magic, decoded size, encoded size, checksum and method
+				TRAILER_SIZE = 4,					///< window size appended by bm2rgbi
+				MAX_MEDIUM_WINDOW = 2056	///< the furthest back that any copy except a distant copy can reach
+			};
+
 			static uint8_t readNextByte(uint32_t src);
+			static uint32_t readNextUint32(uint32_t src);
+
+			template<class TReader>
+			static uint8_t readNextByte(TReader& reader,int32_t& remaining);
 
 		public:
 			static void decode(uint32_t in,uint32_t insize);
+
+			template<class TContext>
+			static void decode(TContext& context,uint32_t in,uint32_t insize);
+
+			template<class TContext>
+			static void decode(TContext& context,ByteSource& source);
+
+			static uint32_t getWindowSize(uint32_t in,uint32_t insize);
 	};
 
 
 	/**
 	 * Decode the LZG stream and write to the LCD. This function costs you
-	 * 2Kb of stack to call (note the circbuf size)
+	 * 2Kb of stack to call because it sets up a default LzgDecoderContext.
 	 * @param in The 32-bit flash address of the data.
 	 * @param insize The size of the compressed data.
 	 */
 
-	template<class TAccessMode>
-	inline void LzgFlashDecoder<TAccessMode>::decode(uint32_t in,uint32_t insize) {
+	template<class TAccessMode,uint8_t TBytesPerPixel>
+	inline void LzgFlashDecoder<TAccessMode,TBytesPerPixel>::decode(uint32_t in,uint32_t insize) {
+
+		LzgDecoderContext<> context;
+		decode(context,in,insize);
+	}
+
+
+	/**
+	 * Decode the LZG stream and write to the LCD using the history window in the given context.
+	 * Nothing is written if the asset needs a larger window than the context has.
+	 * @param context The decoder context that holds the history window.
+	 * @param in The 32-bit flash address of the data.
+	 * @param insize The size of the compressed data, including any window size trailer.
+	 */
+
+	template<class TAccessMode,uint8_t TBytesPerPixel>
+	template<class TContext>
+	inline void LzgFlashDecoder<TAccessMode,TBytesPerPixel>::decode(TContext& context,uint32_t in,uint32_t insize) {
+
+		// the window that the asset needs must fit in the context
+
+		if(getWindowSize(in,insize)>sizeof(context.History))
+			return;
+
+		FlashByteSource source(in,insize);
+		decode(context,source);
+	}
+
+
+	/**
+	 * Decode the LZG stream read from a source and write to the LCD using the history window in the
+	 * given context. The window size trailer cannot be checked before decoding because the source
+	 * may not be able to seek, so decoding stops at the first copy that reaches back beyond the window.
+	 * The whole asset, including any trailer, is consumed from the source.
+	 * @param context The decoder context that holds the history window.
+	 * @param source The source of the compressed data.
+	 */
+
+	template<class TAccessMode,uint8_t TBytesPerPixel>
+	template<class TContext>
+	inline void LzgFlashDecoder<TAccessMode,TBytesPerPixel>::decode(TContext& context,ByteSource& source) {
 
 		static const uint8_t LZG_LENGTH_DECODE_LUT[32]= { 2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,35,48,72,128 };
 
-		uint8_t *dst,*dstEnd,*copy,symbol,b,b2;
+		uint8_t *dst,*dstEnd,*copy,*pixelPtr,symbol,b,b2,phase;
 		uint8_t marker1,marker2,marker3,marker4;
-		uint32_t inEnd,src;
-		uint16_t offset,length,i;
-		char isMarkerSymbolLUT[256];
-		uint8_t circbuf[2056];          // this is the history buffer
+		uint8_t pixel[TBytesPerPixel];
+		uint32_t offset,encodedSize;
+		int32_t remaining;
+		uint16_t length,run,i;
+		BufferedByteReader<> reader(source);
 
-		// Initialize the byte streams
-		src=in;
-		inEnd=in+insize;
-		dst=circbuf;
-		dstEnd=circbuf+sizeof(circbuf);
+		// Initialize the history window
+		dst=context.History;
+		dstEnd=context.History+sizeof(context.History);
+		phase=0;
 
-		// Skip header information
-		src+=16;
+		// Skip the magic number and decoded size. The encoded size that follows excludes the header
+		// and the trailer. Then skip the checksum and method.
+		reader.skip(7);
 
-		// Get marker symbols from the input stream
-		marker1=readNextByte(src++);
-		marker2=readNextByte(src++);
-		marker3=readNextByte(src++);
-		marker4=readNextByte(src++);
+		for(encodedSize=0,i=0;i<4;i++)
+			encodedSize=(encodedSize << 8) | reader.readByte();
 
-		// Initialize marker symbol LUT
-		for(i=0;i<256;++i)
-			isMarkerSymbolLUT[i]=0;
+		remaining=encodedSize;
+		reader.skip(HEADER_SIZE-11);
 
-		isMarkerSymbolLUT[marker1]=1;
-		isMarkerSymbolLUT[marker2]=1;
-		isMarkerSymbolLUT[marker3]=1;
-		isMarkerSymbolLUT[marker4]=1;
+		// Get marker symbols from the input stream
+		marker1=readNextByte(reader,remaining);
+		marker2=readNextByte(reader,remaining);
+		marker3=readNextByte(reader,remaining);
+		marker4=readNextByte(reader,remaining);
 
 		// Main decompression loop
-		while(src<inEnd) {
+		while(remaining>0) {
 			// Get the next symbol
-			symbol=readNextByte(src++);
+			symbol=readNextByte(reader,remaining);
 
 			// Marker symbol?
-			if(!isMarkerSymbolLUT[symbol]) {
+			if(symbol!=marker1 && symbol!=marker2 && symbol!=marker3 && symbol!=marker4) {
 
 				// Literal copy
 
 				TAccessMode::writeStreamedData(symbol);
 				*dst++=symbol;
 				if(dst==dstEnd)
-					dst=circbuf;
+					dst=context.History;
+
+				if(TBytesPerPixel>1 && ++phase==TBytesPerPixel)
+					phase=0;
 
 			} else {
 
-				b=readNextByte(src++);
+				b=readNextByte(reader,remaining);
 
 				if(b) {
 
 					// Decode offset / length parameters
 
 					if(symbol == marker1) {
-						// Distant copy is not supported on the Arduino due to lack of memory
-						return;
+
+						// Distant copy
+
+						length=LZG_LENGTH_DECODE_LUT[b & 0x1f];
+						b2=readNextByte(reader,remaining);
+						offset=(((uint32_t)(b & 0xe0)) << 11) | (((uint32_t)b2) << 8) | readNextByte(reader,remaining);
+						offset+=MAX_MEDIUM_WINDOW;
 					} else if(symbol == marker2) {
 
 						// Medium copy
 
 						length=LZG_LENGTH_DECODE_LUT[b & 0x1f];
-						b2=readNextByte(src++);
+						b2=readNextByte(reader,remaining);
 						offset=(((uint16_t)(b & 0xe0)) << 3) | b2;
 						offset+=8;
 					} else if(symbol == marker3) {
@@ -138,23 +301,53 @@ namespace lcd {
 						offset=(b >> 5) + 1;
 					}
 
+					// a copy from beyond the window means the asset needs a bigger context
+
+					if(offset>sizeof(context.History))
+						return;
+
 					// Copy corresponding data from history window
 
-					if(offset<=static_cast<uint16_t>(dst-circbuf))
+					if(offset<=static_cast<uint32_t>(dst-context.History))
 						copy=dst-offset;
 					else
-						copy=dstEnd-(offset-(uint16_t)(dst-circbuf));
+						copy=dstEnd-(offset-static_cast<uint32_t>(dst-context.History));
+
+					// A copy of the previous pixel that starts on a pixel boundary is a run of that
+					// pixel. The whole pixels go out in a burst and any partial pixel is streamed.
+
+					run=0;
+
+					if(TBytesPerPixel>1 && offset==TBytesPerPixel && phase==0 && length>=TBytesPerPixel*MIN_RUN_PIXELS) {
+
+						pixelPtr=copy;
+
+						for(i=0;i<TBytesPerPixel;i++) {
+							pixel[i]=*pixelPtr++;
+							if(pixelPtr==dstEnd)
+								pixelPtr=context.History;
+						}
+
+						run=length-length % TBytesPerPixel;
+						LzgPixelRun<TAccessMode,TBytesPerPixel>::write(run/TBytesPerPixel,pixel);
+					}
 
 					for(i=0;i<length;i++) {
-						TAccessMode::writeStreamedData(*copy);
+
+						if(i>=run) {
+							TAccessMode::writeStreamedData(*copy);
+
+							if(TBytesPerPixel>1 && ++phase==TBytesPerPixel)
+								phase=0;
+						}
 
 						*dst++=*copy++;
 
 						if(dst==dstEnd)
-							dst=circbuf;
+							dst=context.History;
 
 						if(copy==dstEnd)
-							copy=circbuf;
+							copy=context.History;
 					}
 
 				} else {
@@ -162,10 +355,41 @@ namespace lcd {
 					TAccessMode::writeStreamedData(symbol);
 					*dst++=symbol;
 					if(dst==dstEnd)
-						dst=circbuf;
+						dst=context.History;
+
+					if(TBytesPerPixel>1 && ++phase==TBytesPerPixel)
+						phase=0;
 				}
 			}
 		}
+
+		// consume the window size trailer, if there is one
+
+		reader.skip(TRAILER_SIZE);
+	}
+
+
+	/**
+	 * Get the size of the history window that an asset needs. bm2rgbi appends the size as a
+	 * big-endian 32-bit value after the LZG data. Older assets without it were compressed at
+	 * level 1 and cannot copy from further back than a medium copy or the start of the data.
+	 * @param in The 32-bit flash address of the data.
+	 * @param insize The size of the compressed data, including any window size trailer.
+	 * @return The window size in bytes.
+	 */
+
+	template<class TAccessMode,uint8_t TBytesPerPixel>
+	inline uint32_t LzgFlashDecoder<TAccessMode,TBytesPerPixel>::getWindowSize(uint32_t in,uint32_t insize) {
+
+		uint32_t encodedSize,decodedSize;
+
+		encodedSize=readNextUint32(in+7);
+
+		if(insize>=HEADER_SIZE+encodedSize+TRAILER_SIZE)
+			return readNextUint32(in+HEADER_SIZE+encodedSize);
+
+		decodedSize=readNextUint32(in+3);
+		return decodedSize<MAX_MEDIUM_WINDOW ? decodedSize : MAX_MEDIUM_WINDOW;
 	}
 
 
@@ -175,8 +399,39 @@ namespace lcd {
 	 * @return The next byte
 	 */
 
-	template<class TAccessMode>
-	inline uint8_t LzgFlashDecoder<TAccessMode>::readNextByte(uint32_t src) {
+	template<class TAccessMode,uint8_t TBytesPerPixel>
+	inline uint8_t LzgFlashDecoder<TAccessMode,TBytesPerPixel>::readNextByte(uint32_t src) {
 		return src<65536 ? pgm_read_byte_near(src) : pgm_read_byte_far(src);
 	}
+
+
+	/**
+	 * Read the next byte of the compressed stream from the buffered source
+	 * @param reader The buffered reader
+	 * @param remaining The number of bytes left in the stream. This is decremented.
+	 * @return The next byte
+	 */
+
+	template<class TAccessMode,uint8_t TBytesPerPixel>
+	template<class TReader>
+	inline uint8_t LzgFlashDecoder<TAccessMode,TBytesPerPixel>::readNextByte(TReader& reader,int32_t& remaining) {
+		remaining--;
+		return reader.readByte();
+	}
+
+
+	/**
+	 * Read a big-endian 32-bit value from flash, the byte order used in the LZG header
+	 * @param src flash address
+	 * @return The value
+	 */
+
+	template<class TAccessMode,uint8_t TBytesPerPixel>
+	inline uint32_t LzgFlashDecoder<TAccessMode,TBytesPerPixel>::readNextUint32(uint32_t src) {
+
+		return (static_cast<uint32_t>(readNextByte(src)) << 24)
+		     | (static_cast<uint32_t>(readNextByte(src+1)) << 16)
+		     | (static_cast<uint32_t>(readNextByte(src+2)) << 8)
+		     | readNextByte(src+3);
+	}
 }
@@ -0,0 +1,127 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file RegisterShadow.h
+ * @brief Optional shadow copy of panel registers used to skip redundant writes.
+ */
+
+#pragma once
+
+
+namespace lcd {
+
+	/**
+	 * @brief Shadow copy of a small number of 16-bit panel registers.
+	 *
+	 * The orientation specialisations derive from this and ask update() whether a register
+	 * write is required before issuing it. This generic template is the WINDOW_SHADOW_OFF case
+	 * that always says yes and costs nothing, the WINDOW_SHADOW_ON specialisation below stores
+	 * the values.
+	 *
+	 * @tparam TWindowShadowing WINDOW_SHADOW_ON or WINDOW_SHADOW_OFF
+	 * @tparam TCount The number of registers to shadow
+	 */
+
+	template<WindowShadowing TWindowShadowing,uint8_t TCount>
+	class RegisterShadow {
+
+		protected:
+
+			/**
+			 * Check if a register needs writing.
+			 * @return always true
+			 */
+
+			bool updateShadow(uint8_t /* index */,uint16_t /* value */) const {
+				return true;
+			}
+
+		public:
+
+			/**
+			 * Nothing to invalidate
+			 */
+
+			void invalidateShadow() const {
+			}
+	};
+
+
+	/**
+	 * @brief Shadow copy of a small number of 16-bit panel registers.
+	 *
+	 * The shadow starts out invalid and must be invalidated again whenever the registers are
+	 * changed behind its back, e.g. by a reset or by the application writing directly to the
+	 * access mode. Window co-ordinates never reach 0xffff so that value marks an unknown register.
+	 *
+	 * @tparam TCount The number of registers to shadow
+	 */
+
+	template<uint8_t TCount>
+	class RegisterShadow<WINDOW_SHADOW_ON,TCount> {
+
+		protected:
+			mutable uint16_t _shadow[TCount];
+
+		protected:
+
+			/**
+			 * Constructor, all values unknown
+			 */
+
+			RegisterShadow() {
+				invalidateShadow();
+			}
+
+
+			/**
+			 * Check if a register needs writing. If it does then the shadow is updated on the
+			 * assumption that the caller will go on to write it.
+			 * @param index The shadow index of the register, 0..TCount-1
+			 * @param value The value about to be written
+			 * @return true if the register does not already hold the value
+			 */
+
+			bool updateShadow(uint8_t index,uint16_t value) const {
+
+				if(_shadow[index]==value)
+					return false;
+
+				_shadow[index]=value;
+				return true;
+			}
+
+		public:
+
+			/**
+			 * Forget all shadowed values so that the next write of each register goes to the panel
+			 */
+
+			void invalidateShadow() const {
+
+				uint8_t i;
+
+				for(i=0;i<TCount;i++)
+					_shadow[i]=0xffff;
+			}
+	};
+}
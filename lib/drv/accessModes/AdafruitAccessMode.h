@@ -77,6 +77,14 @@ namespace lcd {
 			};
 
 		public:
+			/**
+			 * writeStreamedData() sends each byte as a transfer of its own
+			 */
+
+			enum {
+				STREAM_TRANSFER_BYTES = 1
+			};
+
 			static void initialise();
 			static void hardReset();
 
@@ -86,7 +94,10 @@ namespace lcd {
 			static void writeCommandData(uint8_t cmd,uint8_t lo8,uint8_t hi8=0);
 			static void writeDataAgain(uint8_t lo8,uint8_t hi8=0);
 			static void writeMultiData(uint32_t howMuch,uint8_t lo8,uint8_t hi8=0);
+			static void writeMultiData(uint32_t howMuch,uint8_t first,uint8_t second,uint8_t third);
 			static void writeStreamedData(uint8_t data);
+			static void writeDataBlock(const uint8_t *data,uint16_t numBytes);
+			static void writeFlashDataBlock(uint32_t data,uint32_t numBytes);
 	};
 
 
@@ -189,6 +200,24 @@ namespace lcd {
 	}
 
 
+	/**
+	 * Repeatedly write out a 3-byte pattern, e.g. an 18-bit pixel in the ILI9325's 3-transfer mode.
+	 * @param howMuch The repeat count.
+	 * @param first The first byte of the pattern
+	 * @param second The second byte of the pattern
+	 * @param third The third byte of the pattern
+	 */
+
+	inline void AdafruitAccessMode::writeMultiData(uint32_t howMuch,uint8_t first,uint8_t second,uint8_t third) {
+
+		while(howMuch--) {
+			writeData(first);
+			writeData(second);
+			writeData(third);
+		}
+	}
+
+
 	/**
 	 * Write a single byte out from a stream of colour values. This is used when streaming
 	 * data to the display from a decompression routine. This interface is 8-bit so we don't
@@ -201,6 +230,65 @@ namespace lcd {
 	}
 
 
+	/**
+	 * Write a block of bytes from SRAM. This interface is 8-bit so a 16-bit value is just two
+	 * consecutive bytes. The bytes are written out in unrolled batches of 8.
+	 * @param data The bytes to write
+	 * @param numBytes The number of bytes to write
+	 */
+
+	inline void AdafruitAccessMode::writeDataBlock(const uint8_t *data,uint16_t numBytes) {
+
+		uint8_t remainder;
+
+		while(numBytes>=8) {
+
+			writeData(*data++);
+			writeData(*data++);
+			writeData(*data++);
+			writeData(*data++);
+			writeData(*data++);
+			writeData(*data++);
+			writeData(*data++);
+			writeData(*data++);
+
+			numBytes-=8;
+		}
+
+		// finish off the last few
+
+		remainder=numBytes;
+
+		while(remainder--)
+			writeData(*data++);
+	}
+
+
+	/**
+	 * Write a block of bytes from flash. The block may be anywhere in flash and may cross 64Kb segment
+	 * boundaries.
+	 * @param data The 24-bit flash address of the bytes
+	 * @param numBytes The number of bytes to write
+	 */
+
+	inline void AdafruitAccessMode::writeFlashDataBlock(uint32_t data,uint32_t numBytes) {
+
+		uint16_t address,count;
+
+		while(numBytes) {
+
+			count=FarFlashReader::beginSegment(data,numBytes);
+			address=data;
+
+			data+=count;
+			numBytes-=count;
+
+			while(count--)
+				writeData(FarFlashReader::read(address));
+		}
+	}
+
+
 	/**
 	 * Write a command and 16-bits of data
 	 * @param cmd The command to write
@@ -0,0 +1,128 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file ClippingStreamAccessMode.h
+ * @ingroup AccessModes
+ * @brief An access mode wrapper that drops streamed bytes that fall outside a clip rectangle.
+ */
+
+#pragma once
+
+
+namespace lcd {
+
+	/**
+	 * @brief Filter the streamed output of a decoder through a clip rectangle.
+	 *
+	 * Decoders such as LzgFlashDecoder write their output a byte at a time with writeStreamedData()
+	 * and have no idea where the bytes end up on the panel. This wrapper counts the bytes as they go past
+	 * and only passes on the ones that are inside the visible area, which must already have been set as the
+	 * drawing window. Whole pixels are always passed on so the access mode's own byte pairing stays in step.
+	 *
+	 * Only writeStreamedData() is provided. The state is static, like the access modes themselves.
+	 *
+	 * @tparam TAccessMode The access mode that receives the visible bytes.
+	 * @ingroup AccessModes
+	 */
+
+	template<class TAccessMode>
+	class ClippingStreamAccessMode {
+
+		protected:
+			static uint16_t _rowBytes;
+			static uint16_t _firstColumnByte;
+			static uint16_t _lastColumnByte;
+			static int16_t _firstRow;
+			static int16_t _lastRow;
+			static uint16_t _column;
+			static int16_t _row;
+
+		public:
+			static void setClip(const Rectangle& full,const Rectangle& visible,uint8_t bytesPerPixel);
+			static void writeStreamedData(uint8_t data);
+	};
+
+
+	/*
+	 * Static member definitions
+	 */
+
+	template<class TAccessMode>
+	uint16_t ClippingStreamAccessMode<TAccessMode>::_rowBytes;
+
+	template<class TAccessMode>
+	uint16_t ClippingStreamAccessMode<TAccessMode>::_firstColumnByte;
+
+	template<class TAccessMode>
+	uint16_t ClippingStreamAccessMode<TAccessMode>::_lastColumnByte;
+
+	template<class TAccessMode>
+	int16_t ClippingStreamAccessMode<TAccessMode>::_firstRow;
+
+	template<class TAccessMode>
+	int16_t ClippingStreamAccessMode<TAccessMode>::_lastRow;
+
+	template<class TAccessMode>
+	uint16_t ClippingStreamAccessMode<TAccessMode>::_column;
+
+	template<class TAccessMode>
+	int16_t ClippingStreamAccessMode<TAccessMode>::_row;
+
+
+	/**
+	 * Set up the filter for a new image and reset the stream position to its top-left.
+	 * @param full The panel rectangle covered by the whole image.
+	 * @param visible The part of 'full' that is to be written.
+	 * @param bytesPerPixel The number of bytes in each pixel of the stream.
+	 */
+
+	template<class TAccessMode>
+	inline void ClippingStreamAccessMode<TAccessMode>::setClip(const Rectangle& full,const Rectangle& visible,uint8_t bytesPerPixel) {
+
+		_rowBytes=full.Width*bytesPerPixel;
+		_firstColumnByte=(visible.X-full.X)*bytesPerPixel;
+		_lastColumnByte=_firstColumnByte+visible.Width*bytesPerPixel;
+		_firstRow=visible.Y-full.Y;
+		_lastRow=_firstRow+visible.Height;
+
+		_column=0;
+		_row=0;
+	}
+
+
+	/**
+	 * Pass the byte on to the access mode if it is inside the visible area.
+	 * @param data The byte to write.
+	 */
+
+	template<class TAccessMode>
+	inline void ClippingStreamAccessMode<TAccessMode>::writeStreamedData(uint8_t data) {
+
+		if(_row>=_firstRow && _row<_lastRow && _column>=_firstColumnByte && _column<_lastColumnByte)
+			TAccessMode::writeStreamedData(data);
+
+		if(++_column==_rowBytes) {
+			_column=0;
+			_row++;
+		}
+	}
+}
@@ -0,0 +1,125 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+/**
+ * @file FarFlashReader.h
+ * @ingroup AccessModes
+ * @brief Sequential reads from flash memory anywhere in the 24-bit program address space.
+ */
+
+#pragma once
+
+#if defined(__AVR__)
+
+
+namespace lcd {
+
+	/**
+	 * @brief Sequential reader for large blocks of data in flash memory.
+	 *
+	 * The access modes use this to stream uncompressed bitmaps straight from flash to the bus. The
+	 * pgm_read_byte_far() macro reloads RAMPZ and Z for every byte that it reads. This reader loads
+	 * RAMPZ once per 64Kb segment and then walks the segment with 'elpm Z+', keeping the address in
+	 * the Z register so that each byte costs just the 3 cycle load. test/host/FlashReadTest counts the
+	 * cycles for both readers on the host (about 9.8 against 31.5 cycles per pixel on Xmem16AccessMode)
+	 * and the FlashReadBenchmark example in examples/arduinoIDE/ILI9325 times them on hardware.
+	 *
+	 * Usage is to call beginSegment() to set up RAMPZ and find out how many bytes may be read
+	 * from the segment, then call read() that many times with the low 16 bits of the address:
+	 *
+	 *   while(numBytes) {
+	 *     count=FarFlashReader::beginSegment(data,numBytes);
+	 *     address=data;
+	 *     data+=count;
+	 *     numBytes-=count;
+	 *     while(count--)
+	 *       writeData(FarFlashReader::read(address));
+	 *   }
+	 *
+	 * On MCUs with 64Kb or less of flash, such as the ATmega328P, there is no RAMPZ and the reads
+	 * are done with 'lpm Z+'.
+	 *
+	 * @ingroup AccessModes
+	 */
+
+	struct FarFlashReader {
+
+		enum {
+			MAX_SEGMENT_BYTES = 0x8000			///< upper limit on the bytes returned by beginSegment()
+		};
+
+		static uint16_t beginSegment(uint32_t address,uint32_t numBytes) __attribute__((always_inline));
+		static uint8_t read(uint16_t& address) __attribute__((always_inline));
+	};
+
+
+	/**
+	 * Prepare to read from the segment that contains the given address. RAMPZ is loaded with the
+	 * segment number.
+	 * @param address The 24-bit flash address of the next byte to read
+	 * @param numBytes The number of bytes that remain to be read
+	 * @return The number of bytes that can be read before the end of the segment. This is never
+	 * more than MAX_SEGMENT_BYTES, which is even.
+	 */
+
+	inline uint16_t FarFlashReader::beginSegment(uint32_t address,uint32_t numBytes) {
+
+		uint32_t count;
+
+#if defined(RAMPZ)
+		RAMPZ=address >> 16;
+		count=0x10000-(address & 0xffff);
+#else
+		count=MAX_SEGMENT_BYTES;
+#endif
+
+		if(count>MAX_SEGMENT_BYTES)
+			count=MAX_SEGMENT_BYTES;
+
+		if(count>numBytes)
+			count=numBytes;
+
+		return count;
+	}
+
+
+	/**
+	 * Read the next byte and advance the address. If the address wraps past the end of the segment
+	 * then the hardware carries into RAMPZ.
+	 * @param address The low 16 bits of the flash address. This is updated.
+	 * @return The byte.
+	 */
+
+	inline uint8_t FarFlashReader::read(uint16_t& address) {
+
+		uint8_t data;
+
+#if defined(RAMPZ)
+		__asm volatile("  elpm %0,Z+  \n\t" : "=r" (data), "+z" (address));
+#else
+		__asm volatile("  lpm %0,Z+   \n\t" : "=r" (data), "+z" (address));
+#endif
+
+		return data;
+	}
+}
+
+
+#endif
@@ -104,23 +104,38 @@ namespace lcd {
 	 *
 	 * Finally, note that the optimised pixel-pusher ensures that global interrupts are off while
 	 * it's running because it cannot have an IRQ handler modify any pin on the port where /WR lives
-	 * while it's running. If you know this will never happen then you can remove that part of the
-	 * assembly language to increase concurrency at the expense of worse pixel throughput if an
-	 * IRQ goes off while it's running.
+	 * while it's running. By default that's for the whole fill, which is over 10ms for a full QVGA
+	 * screen and long enough to lose incoming serial data. Set TInterruptBatches to a non-zero value
+	 * and the fill is split into chunks of that many 40 pixel batches. Interrupts are restored between
+	 * chunks and each chunk reads the state of the /WR port afresh, so changes made to that port by an
+	 * IRQ handler are kept. Smaller values block interrupts for less time but add the cost of
+	 * restoring and disabling them between chunks. Choose the largest value that does not lose
+	 * characters with your own IRQ handlers running.
 	 *
 	 * @tparam TPinMappings A type that contains the constants that define the pins and ports,
 	 * usually in the form of an enum, that represents your physical setup.
+	 * @tparam TInterruptBatches The number of 40 pixel batches to write with interrupts disabled, or
+	 * zero to disable them for the whole of each fill.
 	 * @ingroup AccessModes
 	 */
 
-	template<typename TPinMappings>
+	template<typename TPinMappings,uint8_t TInterruptBatches=0>
 	class Gpio16LatchAccessMode {
 
 		protected:
 			static uint8_t _streamIndex;
 			static void initOutputHigh(uint8_t port,uint8_t pin);
+			static void writeMultiDataBurst(uint32_t howMuch,uint8_t lo8,uint8_t hi8);
 
 		public:
+			/**
+			 * writeStreamedData() pairs bytes into 16-bit (lo8,hi8) transfers
+			 */
+
+			enum {
+				STREAM_TRANSFER_BYTES = 2
+			};
+
 			static void initialise();
 			static void hardReset();
 
@@ -129,7 +144,10 @@ namespace lcd {
 			static void writeData(uint8_t lo8,uint8_t hi8=0);
 			static void writeDataAgain(uint8_t lo8,uint8_t hi8=0);
 			static void writeMultiData(uint32_t howMuch,uint8_t lo8,uint8_t hi8=0);
+			static void writeMultiData(uint32_t howMuch,uint8_t first,uint8_t second,uint8_t third);
 			static void writeStreamedData(uint8_t data);
+			static void writeDataBlock(const uint8_t *data,uint16_t numBytes);
+			static void writeFlashDataBlock(uint32_t data,uint32_t numBytes);
 	};
 
 
@@ -137,8 +155,8 @@ namespace lcd {
 	 * Initialise the static member
 	 */
 
-	template <typename TPinMappings>
-	uint8_t Gpio16LatchAccessMode<TPinMappings>::_streamIndex=0;
+	template<typename TPinMappings,uint8_t TInterruptBatches>
+	uint8_t Gpio16LatchAccessMode<TPinMappings,TInterruptBatches>::_streamIndex=0;
 
 
 	/**
@@ -149,9 +167,9 @@ namespace lcd {
 	 * @param hi8 The high 8 bits of the command to write. Many commands are 8-bits so this parameters defaults to zero.
 	 */
 
-	template<class TPinMappings>
+	template<class TPinMappings,uint8_t TInterruptBatches>
 	__attribute__((always_inline))
-	inline void Gpio16LatchAccessMode<TPinMappings>::writeCommandData(uint8_t cmd,uint8_t lo8,uint8_t hi8) {
+	inline void Gpio16LatchAccessMode<TPinMappings,TInterruptBatches>::writeCommandData(uint8_t cmd,uint8_t lo8,uint8_t hi8) {
 
 		writeCommand(cmd,0);
 		writeData(lo8,hi8);
@@ -164,8 +182,8 @@ namespace lcd {
 	 * @param hi8 The high 8 bits of the command to write. Many commands are 8-bits so this parameters defaults to zero.
 	 */
 
-	template<class TPinMappings>
-	inline void Gpio16LatchAccessMode<TPinMappings>::writeCommand(uint8_t lo8,uint8_t hi8) {
+	template<class TPinMappings,uint8_t TInterruptBatches>
+	inline void Gpio16LatchAccessMode<TPinMappings,TInterruptBatches>::writeCommand(uint8_t lo8,uint8_t hi8) {
 
 	  __asm volatile(
 	  		"  sbi %1, %5   \n\t"			// ALE   = HIGH
@@ -197,8 +215,8 @@ namespace lcd {
 	 * @param data The 8-bits
 	 */
 
-	template<class TPinMappings>
-	inline void Gpio16LatchAccessMode<TPinMappings>::writeStreamedData(uint8_t data) {
+	template<class TPinMappings,uint8_t TInterruptBatches>
+	inline void Gpio16LatchAccessMode<TPinMappings,TInterruptBatches>::writeStreamedData(uint8_t data) {
 
 		if(_streamIndex==0) {
 
@@ -243,8 +261,8 @@ namespace lcd {
 	 * @param hi8 The high 8 bits of the value to write. Many parameter values are 8-bits so this parameters defaults to zero.
 	 */
 
-	template<class TPinMappings>
-	inline void Gpio16LatchAccessMode<TPinMappings>::writeData(uint8_t lo8,uint8_t hi8) {
+	template<class TPinMappings,uint8_t TInterruptBatches>
+	inline void Gpio16LatchAccessMode<TPinMappings,TInterruptBatches>::writeData(uint8_t lo8,uint8_t hi8) {
 
 	  __asm volatile(
 	  		"  sbi %1, %5   \n\t"			// ALE   = HIGH
@@ -277,8 +295,8 @@ namespace lcd {
 	 * @param hi8 The high 8 bits of the value to write. Many parameter values are 8-bits so this parameters defaults to zero.
 	 */
 
-	template<class TPinMappings>
-	inline void Gpio16LatchAccessMode<TPinMappings>::writeDataAgain(uint8_t /* lo8 */,uint8_t /* hi8 */) {
+	template<class TPinMappings,uint8_t TInterruptBatches>
+	inline void Gpio16LatchAccessMode<TPinMappings,TInterruptBatches>::writeDataAgain(uint8_t /* lo8 */,uint8_t /* hi8 */) {
 
 		__asm volatile(
 				"  cbi %0, %1   \n\t"			// /WR   = LOW
@@ -290,18 +308,188 @@ namespace lcd {
 	}
 
 
+	/**
+	 * Write a block of 16-bit values from SRAM to the GPIO interface. The block is a sequence of (lo8,hi8)
+	 * byte pairs, the same layout that writeData() takes its parameters in. There is no block transfer on
+	 * this interface so this is just the writeData() loop unrolled into batches of 8, which pays the loop
+	 * overhead once per batch. Interrupts are not disabled.
+	 * @param data The byte pairs to write
+	 * @param numBytes The number of bytes to write. Must be even.
+	 */
+
+	template<class TPinMappings,uint8_t TInterruptBatches>
+	inline void Gpio16LatchAccessMode<TPinMappings,TInterruptBatches>::writeDataBlock(const uint8_t *data,uint16_t numBytes) {
+
+		uint16_t numValues;
+		uint8_t remainder;
+
+		numValues=numBytes/2;
+
+		while(numValues>=8) {
+
+			writeData(data[0],data[1]);
+			writeData(data[2],data[3]);
+			writeData(data[4],data[5]);
+			writeData(data[6],data[7]);
+			writeData(data[8],data[9]);
+			writeData(data[10],data[11]);
+			writeData(data[12],data[13]);
+			writeData(data[14],data[15]);
+
+			data+=16;
+			numValues-=8;
+		}
+
+		// finish off the last few
+
+		remainder=numValues;
+
+		while(remainder--) {
+			writeData(data[0],data[1]);
+			data+=2;
+		}
+	}
+
+
+	/**
+	 * Write a block of 16-bit values from flash to the GPIO interface. The block is a sequence of (lo8,hi8)
+	 * byte pairs that may be anywhere in flash and may cross 64Kb segment boundaries. RAMPZ is set up once
+	 * per segment and the rest is an unrolled writeData() loop like writeDataBlock(). Interrupts are not
+	 * disabled.
+	 * @param data The 24-bit flash address of the byte pairs
+	 * @param numBytes The number of bytes to write. An odd trailing byte is ignored.
+	 */
+
+	template<class TPinMappings,uint8_t TInterruptBatches>
+	inline void Gpio16LatchAccessMode<TPinMappings,TInterruptBatches>::writeFlashDataBlock(uint32_t data,uint32_t numBytes) {
+
+		uint16_t address,count,numValues;
+		uint8_t remainder,lo8,hi8;
+
+		numBytes&=~1UL;
+
+		while(numBytes) {
+
+			// a pair that straddles the end of the segment is completed by the carry from Z into RAMPZ
+
+			count=FarFlashReader::beginSegment(data,numBytes);
+			count+=count & 1;
+			address=data;
+
+			data+=count;
+			numBytes-=count;
+
+			numValues=count/2;
+
+			while(numValues>=8) {
+
+				lo8=FarFlashReader::read(address);
+				hi8=FarFlashReader::read(address);
+				writeData(lo8,hi8);
+
+				lo8=FarFlashReader::read(address);
+				hi8=FarFlashReader::read(address);
+				writeData(lo8,hi8);
+
+				lo8=FarFlashReader::read(address);
+				hi8=FarFlashReader::read(address);
+				writeData(lo8,hi8);
+
+				lo8=FarFlashReader::read(address);
+				hi8=FarFlashReader::read(address);
+				writeData(lo8,hi8);
+
+				lo8=FarFlashReader::read(address);
+				hi8=FarFlashReader::read(address);
+				writeData(lo8,hi8);
+
+				lo8=FarFlashReader::read(address);
+				hi8=FarFlashReader::read(address);
+				writeData(lo8,hi8);
+
+				lo8=FarFlashReader::read(address);
+				hi8=FarFlashReader::read(address);
+				writeData(lo8,hi8);
+
+				lo8=FarFlashReader::read(address);
+				hi8=FarFlashReader::read(address);
+				writeData(lo8,hi8);
+
+				numValues-=8;
+			}
+
+			// finish off the last few
+
+			remainder=numValues;
+
+			while(remainder--) {
+					lo8=FarFlashReader::read(address);
+					hi8=FarFlashReader::read(address);
+					writeData(lo8,hi8);
+			}
+		}
+	}
+
+
+	/**
+	 * Write a batch of the same data values to the XMEM interface using GPIO. If TInterruptBatches is
+	 * non-zero then the values are written in chunks so that interrupts are not held off for longer than
+	 * TInterruptBatches batches of 40 values.
+	 * @param howMuch The number of 16-bit values to write
+	 * @param lo8 The low 8 bits of the value to write
+	 * @param hi8 The high 8 bits of the value to write. Many parameter values are 8-bits so this parameters defaults to zero.
+	 */
+
+	template<class TPinMappings,uint8_t TInterruptBatches>
+	inline void Gpio16LatchAccessMode<TPinMappings,TInterruptBatches>::writeMultiData(uint32_t howMuch,uint8_t lo8,uint8_t hi8) {
+
+		if(TInterruptBatches!=0) {
+
+			// the burst restores the interrupt flag on exit which gives pending IRQs their chance to run
+
+			while(howMuch>(uint32_t)TInterruptBatches*40) {
+				writeMultiDataBurst((uint32_t)TInterruptBatches*40,lo8,hi8);
+				howMuch-=(uint32_t)TInterruptBatches*40;
+			}
+		}
+
+		writeMultiDataBurst(howMuch,lo8,hi8);
+	}
+
+
+	/**
+	 * Write a batch of the same 3-transfer pattern, e.g. an 18-bit pixel in the ILI9325's 3-transfer mode.
+	 * Each byte of the pattern is a transfer of its own with the upper 8 bits zero.
+	 * @param howMuch The number of times to write the pattern
+	 * @param first The first byte of the pattern
+	 * @param second The second byte of the pattern
+	 * @param third The third byte of the pattern
+	 */
+
+	template<class TPinMappings,uint8_t TInterruptBatches>
+	inline void Gpio16LatchAccessMode<TPinMappings,TInterruptBatches>::writeMultiData(uint32_t howMuch,uint8_t first,uint8_t second,uint8_t third) {
+
+		while(howMuch--) {
+			writeData(first);
+			writeData(second);
+			writeData(third);
+		}
+	}
+
+
 	/**
 	 * Write a batch of the same data values to the XMEM interface using GPIO. The values are written out in a
 	 * highly optimised loop in bursts of 40 at a time. This value seems a good trade off between flash usage
 	 * and speed. The turnaround time between batches has been measured at around 1 microsecond. Note the use
-	 * of %= labels so that inlining doesn't produce duplicate names.
+	 * of %= labels so that inlining doesn't produce duplicate names. Global interrupts are disabled for the
+	 * duration.
 	 * @param howMuch The number of 16-bit values to write
 	 * @param lo8 The low 8 bits of the value to write
-	 * @param hi8 The high 8 bits of the value to write. Many parameter values are 8-bits so this parameters defaults to zero.
+	 * @param hi8 The high 8 bits of the value to write.
 	 */
 
-	template<class TPinMappings>
-	inline void Gpio16LatchAccessMode<TPinMappings>::writeMultiData(uint32_t howMuch,uint8_t lo8,uint8_t hi8) {
+	template<class TPinMappings,uint8_t TInterruptBatches>
+	inline void Gpio16LatchAccessMode<TPinMappings,TInterruptBatches>::writeMultiDataBurst(uint32_t howMuch,uint8_t lo8,uint8_t hi8) {
 
 		__asm volatile(
 				"	   sbi  %9, %7       \n\t"			// ALE   = HIGH
@@ -525,8 +713,8 @@ namespace lcd {
 	 * don't care for its initial state.
 	 */
 
-	template<class TPinMappings>
-	inline void Gpio16LatchAccessMode<TPinMappings>::initialise() {
+	template<class TPinMappings,uint8_t TInterruptBatches>
+	inline void Gpio16LatchAccessMode<TPinMappings,TInterruptBatches>::initialise() {
 
 		// reset pin
 
@@ -550,8 +738,8 @@ namespace lcd {
 	 * @param pin pin 0..7 number in the port
 	 */
 
-	template<class TPinMappings>
-	inline void Gpio16LatchAccessMode<TPinMappings>::initOutputHigh(uint8_t port,uint8_t pin) {
+	template<class TPinMappings,uint8_t TInterruptBatches>
+	inline void Gpio16LatchAccessMode<TPinMappings,TInterruptBatches>::initOutputHigh(uint8_t port,uint8_t pin) {
 
 	  // DDR is always at port address-1
 
@@ -569,8 +757,8 @@ namespace lcd {
 	 * low for anywhere close to that long.
 	 */
 
-	template<class TPinMappings>
-	inline void Gpio16LatchAccessMode<TPinMappings>::hardReset() {
+	template<class TPinMappings,uint8_t TInterruptBatches>
+	inline void Gpio16LatchAccessMode<TPinMappings,TInterruptBatches>::hardReset() {
 
 		// pull reset low for 10ms
 
@@ -586,6 +774,7 @@ namespace lcd {
 	 */
 
 	typedef Gpio16LatchAccessMode<Gpio16LatchAccessModeXmemMapping> DefaultMegaGpio16LatchAccessMode;
+	typedef Gpio16LatchAccessMode<Gpio16LatchAccessModeXmemMapping,8> DefaultMegaGpio16LatchInterruptibleAccessMode;
 }
 
 
@@ -98,13 +98,29 @@ namespace lcd {
 				WR_PIN    = 0						///< port pin #0
 			};
 
+		protected:
+			static void writeStrobes(uint32_t howMuch);
+
 		public:
+			/**
+			 * writeStreamedData() sends each byte as a transfer of its own
+			 */
+
+			enum {
+				STREAM_TRANSFER_BYTES = 1
+			};
+
 			static void initialise();
 			static void hardReset();
 
 			static void writeCommand(uint8_t command) __attribute((always_inline));
 			static void writeData(uint8_t data) __attribute((always_inline));
 			static void writeStreamedData(uint8_t data) __attribute((always_inline));
+			static void writeDataAgain(uint8_t data) __attribute((always_inline));
+			static void writeMultiData(uint32_t howMuch,uint8_t first,uint8_t second);
+			static void writeMultiData(uint32_t howMuch,uint8_t first,uint8_t second,uint8_t third);
+			static void writeDataBlock(const uint8_t *data,uint16_t numBytes);
+			static void writeFlashDataBlock(uint32_t data,uint32_t numBytes);
 	};
 
 
@@ -148,6 +164,275 @@ namespace lcd {
 	}
 
 
+	/**
+	 * Write the same data byte as the previous call to writeData(). The byte is still on the data port
+	 * so all we need to do is strobe /WR. The parameter is present for access modes that cannot do this
+	 * optimisation and must fall back to writeData().
+	 */
+
+	inline void GpioAccessMode::writeDataAgain(uint8_t /* data */) {
+		asm volatile( "cbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+		asm volatile( "sbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+	}
+
+
+	/**
+	 * Strobe /WR a number of times without changing the data port. The strobes are unrolled in batches
+	 * of 16 so that the loop overhead is paid once per batch.
+	 * @param howMuch The number of strobes
+	 */
+
+	inline void GpioAccessMode::writeStrobes(uint32_t howMuch) {
+
+		uint8_t remainder;
+
+		while(howMuch>=16) {
+
+			asm volatile( "cbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "sbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "cbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "sbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "cbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "sbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "cbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "sbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "cbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "sbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "cbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "sbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "cbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "sbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "cbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "sbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "cbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "sbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "cbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "sbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "cbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "sbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "cbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "sbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "cbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "sbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "cbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "sbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "cbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "sbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "cbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+			asm volatile( "sbi %0, %1" :: "I" (WR_PORT), "I" (WR_PIN) );
+
+			howMuch-=16;
+		}
+
+		// finish off the last few
+
+		remainder=howMuch;
+
+		while(remainder--)
+			writeDataAgain(0);
+	}
+
+
+	/**
+	 * Write a batch of the same 2-byte pattern, e.g. a 16-bit pixel. If both bytes are the same, which
+	 * is the case for black and white, then the data port is written once and the rest of the fill is
+	 * just /WR strobes. Otherwise the pixels are written in unrolled batches of 8.
+	 * @param howMuch The number of times to write the pattern
+	 * @param first The first byte of the pattern
+	 * @param second The second byte of the pattern
+	 */
+
+	inline void GpioAccessMode::writeMultiData(uint32_t howMuch,uint8_t first,uint8_t second) {
+
+		uint8_t remainder;
+
+		if(howMuch==0)
+			return;
+
+		if(first==second) {
+			writeData(first);
+			writeStrobes(howMuch*2-1);
+			return;
+		}
+
+		while(howMuch>=8) {
+
+			writeData(first);
+			writeData(second);
+			writeData(first);
+			writeData(second);
+			writeData(first);
+			writeData(second);
+			writeData(first);
+			writeData(second);
+			writeData(first);
+			writeData(second);
+			writeData(first);
+			writeData(second);
+			writeData(first);
+			writeData(second);
+			writeData(first);
+			writeData(second);
+
+			howMuch-=8;
+		}
+
+		// finish off the last few
+
+		remainder=howMuch;
+
+		while(remainder--) {
+			writeData(first);
+			writeData(second);
+		}
+	}
+
+
+	/**
+	 * Write a batch of the same 3-byte pattern, e.g. an 18 or 24-bit pixel. Greys, including black and white,
+	 * have all three bytes the same and are written as a single data port write followed by /WR strobes.
+	 * Otherwise the pixels are written in unrolled batches of 8.
+	 * @param howMuch The number of times to write the pattern
+	 * @param first The first byte of the pattern
+	 * @param second The second byte of the pattern
+	 * @param third The third byte of the pattern
+	 */
+
+	inline void GpioAccessMode::writeMultiData(uint32_t howMuch,uint8_t first,uint8_t second,uint8_t third) {
+
+		uint8_t remainder;
+
+		if(howMuch==0)
+			return;
+
+		if(first==second && second==third) {
+			writeData(first);
+			writeStrobes(howMuch*3-1);
+			return;
+		}
+
+		while(howMuch>=8) {
+
+			writeData(first);
+			writeData(second);
+			writeData(third);
+			writeData(first);
+			writeData(second);
+			writeData(third);
+			writeData(first);
+			writeData(second);
+			writeData(third);
+			writeData(first);
+			writeData(second);
+			writeData(third);
+			writeData(first);
+			writeData(second);
+			writeData(third);
+			writeData(first);
+			writeData(second);
+			writeData(third);
+			writeData(first);
+			writeData(second);
+			writeData(third);
+			writeData(first);
+			writeData(second);
+			writeData(third);
+
+			howMuch-=8;
+		}
+
+		// finish off the last few
+
+		remainder=howMuch;
+
+		while(remainder--) {
+			writeData(first);
+			writeData(second);
+			writeData(third);
+		}
+	}
+
+
+	/**
+	 * Write a block of bytes from SRAM to the data port, one strobe per byte. A GPIO interface has no block
+	 * transfer so this is just the writeData() loop unrolled into batches of 8, which pays the loop overhead
+	 * once per batch.
+	 * @param data The bytes to write
+	 * @param numBytes The number of bytes to write
+	 */
+
+	inline void GpioAccessMode::writeDataBlock(const uint8_t *data,uint16_t numBytes) {
+
+		uint8_t remainder;
+
+		while(numBytes>=8) {
+
+			writeData(*data++);
+			writeData(*data++);
+			writeData(*data++);
+			writeData(*data++);
+			writeData(*data++);
+			writeData(*data++);
+			writeData(*data++);
+			writeData(*data++);
+
+			numBytes-=8;
+		}
+
+		// finish off the last few
+
+		remainder=numBytes;
+
+		while(remainder--)
+			writeData(*data++);
+	}
+
+
+	/**
+	 * Write a block of bytes from flash to the data port, one strobe per byte. The block may be anywhere
+	 * in flash and may cross 64Kb segment boundaries. Like writeDataBlock() this is an unrolled writeData()
+	 * loop, with the flash read done by FarFlashReader.
+	 * @param data The 24-bit flash address of the bytes
+	 * @param numBytes The number of bytes to write
+	 */
+
+	inline void GpioAccessMode::writeFlashDataBlock(uint32_t data,uint32_t numBytes) {
+
+		uint16_t address,count;
+		uint8_t remainder;
+
+		while(numBytes) {
+
+			count=FarFlashReader::beginSegment(data,numBytes);
+			address=data;
+
+			data+=count;
+			numBytes-=count;
+
+			while(count>=8) {
+
+				writeData(FarFlashReader::read(address));
+				writeData(FarFlashReader::read(address));
+				writeData(FarFlashReader::read(address));
+				writeData(FarFlashReader::read(address));
+				writeData(FarFlashReader::read(address));
+				writeData(FarFlashReader::read(address));
+				writeData(FarFlashReader::read(address));
+				writeData(FarFlashReader::read(address));
+
+				count-=8;
+			}
+
+			// finish off the last few
+
+			remainder=count;
+
+			while(remainder--)
+				writeData(FarFlashReader::read(address));
+		}
+	}
+
+
 	/**
 	 * Setup the pin modes and directions
 	 */
@@ -0,0 +1,281 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file HostAccessMode.h
+ * @ingroup AccessModes
+ * @brief An access mode that runs on a desktop host and decodes the bus traffic into a GRAM model.
+ */
+
+#pragma once
+
+#if !defined(__AVR__)
+
+
+namespace lcd {
+
+	/**
+	 * @brief Access mode for compiling and running the library on a desktop host.
+	 *
+	 * This access mode presents the same static interface as the 16-bit hardware access modes so that
+	 * any panel driver and the GraphicsLibrary can be instantiated on top of it. Instead of driving
+	 * pins it forwards each bus transaction to a GRAM model that decodes the panel's command set
+	 * into an in-memory framebuffer. Host programs can then draw through the normal API and assert
+	 * on the resulting pixels, or count the transactions to compare the bus cost of different
+	 * algorithms.
+	 *
+	 * The GRAM model is a class that knows the width of its bus and implements the following:
+	 *
+	 *   void reset();
+	 *   void command(uint8_t lo8,uint8_t hi8);
+	 *   void data(uint8_t lo8,uint8_t hi8);
+	 *   void dataAgain();
+	 *   void multiData(uint32_t howMuch,const uint8_t *pattern,uint8_t patternSize);
+	 *   void dataBlock(const uint8_t *data,uint16_t numBytes);
+	 *   void streamedData(uint8_t data);
+	 *
+	 * 8-bit panels ignore the hi8 parameters just as the 8-bit access modes do. The dataAgain()
+	 * call repeats whatever was last placed on the bus, which is exactly what the latched hardware
+	 * does, so a driver that calls writeDataAgain() after writing a different value will produce a
+	 * visibly wrong framebuffer.
+	 *
+	 * To build for the host put the 'host' directory at the front of your include path so that the
+	 * substitute Arduino.h and avr/pgmspace.h are found.
+	 *
+	 * @tparam TGramModel The panel GRAM model, e.g. ILI9325GramModel.
+	 * @ingroup AccessModes
+	 */
+
+	template<class TGramModel>
+	class HostAccessMode {
+
+		protected:
+			static TGramModel _gram;
+
+		public:
+			/**
+			 * The number of streamed bytes in each transfer, which is the width of the model's bus
+			 */
+
+			enum {
+				STREAM_TRANSFER_BYTES = TGramModel::BUS_BYTES
+			};
+
+			static void initialise();
+			static void hardReset();
+
+			static void writeCommand(uint8_t lo8,uint8_t hi8=0);
+			static void writeCommandData(uint8_t cmd,uint8_t lo8,uint8_t hi8=0);
+			static void writeData(uint8_t lo8,uint8_t hi8=0);
+			static void writeDataAgain(uint8_t lo8,uint8_t hi8=0);
+			static void writeMultiData(uint32_t howMuch,uint8_t lo8);
+			static void writeMultiData(uint32_t howMuch,uint8_t lo8,uint8_t hi8);
+			static void writeMultiData(uint32_t howMuch,uint8_t first,uint8_t second,uint8_t third);
+			static void writeStreamedData(uint8_t data);
+			static void writeDataBlock(const uint8_t *data,uint16_t numBytes);
+			static void writeFlashDataBlock(uint32_t data,uint32_t numBytes);
+
+			static TGramModel& getGramModel();
+	};
+
+
+	/**
+	 * Initialise the static member
+	 */
+
+	template<class TGramModel>
+	TGramModel HostAccessMode<TGramModel>::_gram;
+
+
+	/**
+	 * Nothing to initialise on the host
+	 */
+
+	template<class TGramModel>
+	inline void HostAccessMode<TGramModel>::initialise() {
+	}
+
+
+	/**
+	 * A hard reset returns the model to its power-on state
+	 */
+
+	template<class TGramModel>
+	inline void HostAccessMode<TGramModel>::hardReset() {
+		_gram.reset();
+	}
+
+
+	/**
+	 * Write a command to the model
+	 * @param lo8 The low 8 bits of the command to write
+	 * @param hi8 The high 8 bits of the command to write. Many commands are 8-bits so this parameters defaults to zero.
+	 */
+
+	template<class TGramModel>
+	inline void HostAccessMode<TGramModel>::writeCommand(uint8_t lo8,uint8_t hi8) {
+		_gram.command(lo8,hi8);
+	}
+
+
+	/**
+	 * Shortcut to write an 8-bit command and a data parameter.
+	 * @param cmd The 8-bit command to write.
+	 * @param lo8 The low 8 bits of the data to write.
+	 * @param hi8 The high 8 bits of the data to write. Many parameters are 8-bits so this parameters defaults to zero.
+	 */
+
+	template<class TGramModel>
+	inline void HostAccessMode<TGramModel>::writeCommandData(uint8_t cmd,uint8_t lo8,uint8_t hi8) {
+		writeCommand(cmd,0);
+		writeData(lo8,hi8);
+	}
+
+
+	/**
+	 * Write a data value to the model
+	 * @param lo8 The low 8 bits of the value to write.
+	 * @param hi8 The high 8 bits of the value to write. Many parameter values are 8-bits so this parameters defaults to zero.
+	 */
+
+	template<class TGramModel>
+	inline void HostAccessMode<TGramModel>::writeData(uint8_t lo8,uint8_t hi8) {
+		_gram.data(lo8,hi8);
+	}
+
+
+	/**
+	 * Repeat the last value that was placed on the bus. The parameters are ignored, as they are
+	 * by the latched hardware.
+	 */
+
+	template<class TGramModel>
+	inline void HostAccessMode<TGramModel>::writeDataAgain(uint8_t /* lo8 */,uint8_t /* hi8 */) {
+		_gram.dataAgain();
+	}
+
+
+	/**
+	 * Write a batch of the same 8-bit data value
+	 * @param howMuch The number of values to write
+	 * @param lo8 The value to write
+	 */
+
+	template<class TGramModel>
+	inline void HostAccessMode<TGramModel>::writeMultiData(uint32_t howMuch,uint8_t lo8) {
+		_gram.multiData(howMuch,&lo8,1);
+	}
+
+
+	/**
+	 * Write a batch of the same 16-bit data value. On an 8-bit bus this is a 2-byte pattern.
+	 * @param howMuch The number of values to write
+	 * @param lo8 The low 8 bits of the value to write
+	 * @param hi8 The high 8 bits of the value to write
+	 */
+
+	template<class TGramModel>
+	inline void HostAccessMode<TGramModel>::writeMultiData(uint32_t howMuch,uint8_t lo8,uint8_t hi8) {
+
+		uint8_t pattern[2]={ lo8,hi8 };
+		_gram.multiData(howMuch,pattern,2);
+	}
+
+
+	/**
+	 * Write a batch of the same 3-byte pattern to an 8-bit bus, e.g. an 18 or 24-bit pixel
+	 * @param howMuch The number of times to write the pattern
+	 * @param first The first byte of the pattern
+	 * @param second The second byte of the pattern
+	 * @param third The third byte of the pattern
+	 */
+
+	template<class TGramModel>
+	inline void HostAccessMode<TGramModel>::writeMultiData(uint32_t howMuch,uint8_t first,uint8_t second,uint8_t third) {
+
+		uint8_t pattern[3]={ first,second,third };
+		_gram.multiData(howMuch,pattern,3);
+	}
+
+
+	/**
+	 * Write a byte from a stream whose unit size is not known to the caller (e.g. the LZG decoder).
+	 * The model buffers the bytes into complete bus transfers.
+	 * @param data The 8-bits
+	 */
+
+	template<class TGramModel>
+	inline void HostAccessMode<TGramModel>::writeStreamedData(uint8_t data) {
+		_gram.streamedData(data);
+	}
+
+
+	/**
+	 * Write a block of bytes from memory. The model splits the block into transfers of its own bus width.
+	 * @param data The bytes to write
+	 * @param numBytes The number of bytes to write
+	 */
+
+	template<class TGramModel>
+	inline void HostAccessMode<TGramModel>::writeDataBlock(const uint8_t *data,uint16_t numBytes) {
+		_gram.dataBlock(data,numBytes);
+	}
+
+
+	/**
+	 * Write a block of bytes from 'flash'. There is no separate program address space on the host so
+	 * the address is a pointer, as it is for pgm_read_byte_far().
+	 * @param data The address of the bytes to write
+	 * @param numBytes The number of bytes to write
+	 */
+
+	template<class TGramModel>
+	inline void HostAccessMode<TGramModel>::writeFlashDataBlock(uint32_t data,uint32_t numBytes) {
+
+		const uint8_t *ptr;
+		uint16_t count;
+
+		ptr=reinterpret_cast<const uint8_t *>(static_cast<uintptr_t>(data));
+
+		while(numBytes) {
+
+			count=numBytes>0x8000 ? 0x8000 : numBytes;
+
+			_gram.dataBlock(ptr,count);
+
+			ptr+=count;
+			numBytes-=count;
+		}
+	}
+
+
+	/**
+	 * Get a reference to the GRAM model so that the host program can inspect the framebuffer.
+	 * @return The model.
+	 */
+
+	template<class TGramModel>
+	inline TGramModel& HostAccessMode<TGramModel>::getGramModel() {
+		return _gram;
+	}
+}
+
+#endif
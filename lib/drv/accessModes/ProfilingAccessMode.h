@@ -0,0 +1,644 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file ProfilingAccessMode.h
+ * @ingroup AccessModes
+ * @brief An access mode wrapper that counts bus transactions and estimates their cost in CPU cycles.
+ */
+
+#pragma once
+
+
+namespace lcd {
+
+	/**
+	 * @brief Counts of bus transactions and their estimated cost.
+	 *
+	 * Register programming (commands and their parameters, e.g. the window set up done by moveTo())
+	 * is counted separately from pixel data so that the two can be compared. The cycle estimates
+	 * cover the access mode's own instructions only and do not include the caller's loop overhead.
+	 *
+	 * @ingroup AccessModes
+	 */
+
+	struct BusProfile {
+
+		uint32_t Commands;						///< command (index register) writes
+		uint32_t ParameterWrites;			///< data writes that went to a register
+		uint32_t PixelWrites;					///< data writes that went to GRAM. Streamed data is counted per byte.
+		uint32_t DataAgainWrites;			///< writeDataAgain() strobes
+		uint32_t MultiDataCalls;			///< calls to writeMultiData()
+		uint32_t MultiDataPixels;			///< values written by writeMultiData()
+		uint32_t WindowCycles;				///< estimated cycles spent on commands and parameters
+		uint32_t PixelCycles;					///< estimated cycles spent writing pixel data
+
+
+		/**
+		 * Constructor, all zero
+		 */
+
+		BusProfile() {
+			clear();
+		}
+
+
+		/**
+		 * Reset all counts to zero
+		 */
+
+		void clear() {
+			Commands=ParameterWrites=PixelWrites=DataAgainWrites=MultiDataCalls=MultiDataPixels=WindowCycles=PixelCycles=0;
+		}
+
+
+		/**
+		 * Get the total estimated cycles
+		 * @return window + pixel cycles
+		 */
+
+		uint32_t getTotalCycles() const {
+			return WindowCycles+PixelCycles;
+		}
+
+
+		/**
+		 * Get the estimated time taken, assuming the CPU clock in F_CPU.
+		 * @return The number of microseconds
+		 */
+
+		uint32_t getMicroseconds() const {
+#if defined(F_CPU)
+			return getTotalCycles()/(F_CPU/1000000UL);
+#else
+			return getTotalCycles()/16;
+#endif
+		}
+
+
+		/**
+		 * Accumulate another profile into this one
+		 * @param rhs The profile to add
+		 * @return A reference to this
+		 */
+
+		BusProfile& operator+=(const BusProfile& rhs) {
+
+			Commands+=rhs.Commands;
+			ParameterWrites+=rhs.ParameterWrites;
+			PixelWrites+=rhs.PixelWrites;
+			DataAgainWrites+=rhs.DataAgainWrites;
+			MultiDataCalls+=rhs.MultiDataCalls;
+			MultiDataPixels+=rhs.MultiDataPixels;
+			WindowCycles+=rhs.WindowCycles;
+			PixelCycles+=rhs.PixelCycles;
+
+			return *this;
+		}
+
+
+		/**
+		 * Get the difference between this profile and an earlier snapshot
+		 * @param rhs The earlier snapshot
+		 * @return The counts accumulated since the snapshot
+		 */
+
+		BusProfile operator-(const BusProfile& rhs) const {
+
+			BusProfile diff;
+
+			diff.Commands=Commands-rhs.Commands;
+			diff.ParameterWrites=ParameterWrites-rhs.ParameterWrites;
+			diff.PixelWrites=PixelWrites-rhs.PixelWrites;
+			diff.DataAgainWrites=DataAgainWrites-rhs.DataAgainWrites;
+			diff.MultiDataCalls=MultiDataCalls-rhs.MultiDataCalls;
+			diff.MultiDataPixels=MultiDataPixels-rhs.MultiDataPixels;
+			diff.WindowCycles=WindowCycles-rhs.WindowCycles;
+			diff.PixelCycles=PixelCycles-rhs.PixelCycles;
+
+			return diff;
+		}
+	};
+
+
+	/**
+	 * @brief Estimated cycle costs for the 8-bit XmemAccessMode.
+	 *
+	 * A single 'sts' to external memory with no wait states costs 3 cycles. There is no optimised
+	 * repeat so that is charged as a single write. The multi-writes store the 2 or 3 byte pattern
+	 * in unrolled batches of about 40 strobes.
+	 * @ingroup AccessModes
+	 */
+
+	struct XmemCostTable {
+		enum {
+			BUS_BYTES=1,									///< 8-bit bus
+			COMMAND=3,										///< sts
+			DATA=3,												///< sts
+			DATA_AGAIN=3,									///< falls back to writeData()
+			MULTI_DATA_SETUP=4,						///< load the counter
+			MULTI_DATA_PER_VALUE=3,				///< sts
+			MULTI_DATA_BATCH_SIZE=40,			///< strobes per unrolled batch
+			MULTI_DATA_PER_BATCH=10,			///< 32-bit compare, subtract and branch
+			STREAMED_DATA=3,							///< sts
+			BLOCK_DATA_PER_VALUE=5,				///< ld Z+, sts
+			FLASH_DATA_PER_VALUE=6				///< elpm Z+, sts
+		};
+	};
+
+
+	/**
+	 * @brief Estimated cycle costs for the Xmem16AccessMode.
+	 *
+	 * Each transaction is ldi, mov and an 'st' to external memory = 5 cycles. The multi-write is a
+	 * C loop around writeData() with a 32-bit counter.
+	 * @ingroup AccessModes
+	 */
+
+	struct Xmem16CostTable {
+		enum {
+			BUS_BYTES=2,									///< 16-bit bus
+			COMMAND=5,										///< ldi, mov, st X
+			DATA=5,												///< ldi, mov, st X
+			DATA_AGAIN=5,									///< falls back to writeData()
+			MULTI_DATA_SETUP=4,						///< load the counter
+			MULTI_DATA_PER_VALUE=11,			///< writeData() + 32-bit decrement and test
+			MULTI_DATA_BATCH_SIZE=1,			///< no batching
+			MULTI_DATA_PER_BATCH=0,				///< no batching
+			STREAMED_DATA=8,							///< half a writeData() plus the buffering logic
+			BLOCK_DATA_PER_VALUE=7,				///< ld Z+, ld Z+, st X
+			FLASH_DATA_PER_VALUE=9				///< elpm Z+, elpm Z+, st X
+		};
+	};
+
+
+	/**
+	 * @brief Estimated cycle costs for the Gpio16LatchAccessMode assembly language paths.
+	 *
+	 * Commands and data are 7 sbi/cbi/out instructions = 12 cycles. A repeat is a single /WR
+	 * strobe. The multi-write toggles /WR with a pair of 'out' instructions in batches of 40 with
+	 * a 9 cycle turnaround between batches.
+	 * @ingroup AccessModes
+	 */
+
+	struct Gpio16LatchCostTable {
+		enum {
+			BUS_BYTES=2,									///< 16-bit bus
+			COMMAND=12,										///< sbi, out, cbi, cbi, out, cbi, sbi
+			DATA=12,											///< sbi, out, sbi, cbi, out, cbi, sbi
+			DATA_AGAIN=4,									///< cbi, sbi
+			MULTI_DATA_SETUP=34,					///< latch the value, save SREG, computed jump into the tail
+			MULTI_DATA_PER_VALUE=2,				///< out, out
+			MULTI_DATA_BATCH_SIZE=40,			///< values per unrolled batch
+			MULTI_DATA_PER_BATCH=9,				///< 24-bit subtract, compare and branch
+			STREAMED_DATA=9,							///< half a writeData() plus the index flip
+			BLOCK_DATA_PER_VALUE=16,			///< two loads plus writeData()
+			FLASH_DATA_PER_VALUE=18				///< two 'elpm Z+' plus writeData()
+		};
+	};
+
+
+	/**
+	 * @brief Access mode wrapper that profiles the bus traffic generated by the wrapped access mode.
+	 *
+	 * Use it in place of the real access mode in the GraphicsLibrary typedef. Every transaction is
+	 * forwarded to the real access mode and counted in a static BusProfile. Data writes that follow
+	 * the panel's GRAM write command are counted as pixels, all others are counted as register
+	 * parameters. For example:
+	 *
+	 *   typedef ProfilingAccessMode<DefaultMegaGpio16LatchAccessMode,Gpio16LatchCostTable,ili9325::ILI932X_RW_GRAM> ProfiledMode;
+	 *   typedef GraphicsLibrary<ILI9325<LANDSCAPE,COLOURS_16BIT,ProfiledMode>,ProfiledMode> LcdAccess;
+	 *
+	 * Wrap a HostAccessMode to profile on a desktop host. Use a BusProfileScope to attribute the
+	 * traffic to individual graphics library calls.
+	 *
+	 * The cost tables are estimates. Each figure is counted from the AVR instruction timings for the
+	 * instructions shown next to it. None have been measured on hardware, so use the cycle totals
+	 * to compare drawing strategies, not as absolute timings.
+	 *
+	 * @tparam TAccessMode The access mode to wrap.
+	 * @tparam TCostTable The cycle costs to use, e.g. Gpio16LatchCostTable.
+	 * @tparam TGramWriteCommand The panel command that begins a GRAM write, e.g. 0x22 or 0x2c.
+	 * @ingroup AccessModes
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	class ProfilingAccessMode {
+
+		protected:
+			static BusProfile _profile;
+			static bool _writingGram;
+
+			static void countCommand(uint8_t command);
+			static void countData();
+			static void countMultiData(uint32_t howMuch,uint8_t patternSize);
+			static void countDataBlock(uint32_t numBytes,uint8_t cyclesPerValue);
+
+		public:
+			/**
+			 * Streamed bytes are packed into transfers by the wrapped access mode
+			 */
+
+			enum {
+				STREAM_TRANSFER_BYTES = TAccessMode::STREAM_TRANSFER_BYTES
+			};
+
+			static void initialise();
+			static void hardReset();
+
+			static void writeCommand(uint8_t command);
+			static void writeCommand(uint8_t lo8,uint8_t hi8);
+			static void writeCommandData(uint8_t cmd,uint8_t lo8,uint8_t hi8=0);
+			static void writeData(uint8_t data);
+			static void writeData(uint8_t lo8,uint8_t hi8);
+			static void writeDataAgain(uint8_t data);
+			static void writeDataAgain(uint8_t lo8,uint8_t hi8);
+			static void writeMultiData(uint32_t howMuch,uint8_t data);
+			static void writeMultiData(uint32_t howMuch,uint8_t lo8,uint8_t hi8);
+			static void writeMultiData(uint32_t howMuch,uint8_t first,uint8_t second,uint8_t third);
+			static void writeStreamedData(uint8_t data);
+			static void writeDataBlock(const uint8_t *data,uint16_t numBytes);
+			static void writeFlashDataBlock(uint32_t data,uint32_t numBytes);
+
+			static const BusProfile& getProfile();
+			static void resetProfile();
+	};
+
+
+	/**
+	 * @brief Attribute the bus traffic generated within a C++ scope to a BusProfile.
+	 *
+	 * Declare one of these around the call that you want to measure and the difference between the
+	 * access mode's counters at construction and destruction is added to the target profile. e.g.
+	 *
+	 *   BusProfile fillProfile;
+	 *   {
+	 *     BusProfileScope<ProfiledMode> scope(fillProfile);
+	 *     gl.fillRectangle(rc);
+	 *   }
+	 *
+	 * @tparam TProfilingAccessMode A ProfilingAccessMode type.
+	 * @ingroup AccessModes
+	 */
+
+	template<class TProfilingAccessMode>
+	class BusProfileScope {
+
+		protected:
+			BusProfile& _target;
+			BusProfile _start;
+
+		public:
+
+			/**
+			 * Constructor, take a snapshot of the counters
+			 * @param target Where to accumulate the traffic
+			 */
+
+			BusProfileScope(BusProfile& target)
+				: _target(target),
+				  _start(TProfilingAccessMode::getProfile()) {
+			}
+
+
+			/**
+			 * Destructor, accumulate the difference
+			 */
+
+			~BusProfileScope() {
+				_target+=TProfilingAccessMode::getProfile()-_start;
+			}
+	};
+
+
+	/**
+	 * Initialise the static members
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	BusProfile ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::_profile;
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	bool ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::_writingGram=false;
+
+
+	/**
+	 * Get the counters accumulated since the last reset
+	 * @return A reference to the counters
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline const BusProfile& ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::getProfile() {
+		return _profile;
+	}
+
+
+	/**
+	 * Reset the counters to zero
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::resetProfile() {
+		_profile.clear();
+	}
+
+
+	/**
+	 * Count a command and note whether subsequent data goes to GRAM
+	 * @param command The command
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::countCommand(uint8_t command) {
+
+		_profile.Commands++;
+		_profile.WindowCycles+=TCostTable::COMMAND;
+		_writingGram=command==TGramWriteCommand;
+	}
+
+
+	/**
+	 * Count a single data transaction
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::countData() {
+
+		if(_writingGram) {
+			_profile.PixelWrites++;
+			_profile.PixelCycles+=TCostTable::DATA;
+		}
+		else {
+			_profile.ParameterWrites++;
+			_profile.WindowCycles+=TCostTable::DATA;
+		}
+	}
+
+
+	/**
+	 * Count a multi-write. The cost is charged per bus transfer. A pattern that fills the bus is one
+	 * transfer, any other pattern is a transfer per byte. e.g. a 3 byte pattern on a 16-bit bus is the
+	 * ILI9325's 3-transfer 18-bit mode.
+	 * @param howMuch The number of times the pattern is written
+	 * @param patternSize The number of bytes in the pattern
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::countMultiData(uint32_t howMuch,uint8_t patternSize) {
+
+		uint32_t transfers;
+
+		transfers=howMuch*(patternSize==TCostTable::BUS_BYTES ? 1 : patternSize);
+
+		_profile.MultiDataCalls++;
+		_profile.MultiDataPixels+=howMuch;
+		_profile.PixelCycles+=TCostTable::MULTI_DATA_SETUP
+		                     +transfers*TCostTable::MULTI_DATA_PER_VALUE
+		                     +(transfers/TCostTable::MULTI_DATA_BATCH_SIZE)*TCostTable::MULTI_DATA_PER_BATCH;
+	}
+
+
+	/**
+	 * Count a block write. Each bus transfer in the block is counted as a single data write.
+	 * @param numBytes The number of bytes in the block
+	 * @param cyclesPerValue The cost of each transfer
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::countDataBlock(uint32_t numBytes,uint8_t cyclesPerValue) {
+
+		uint32_t transfers,cycles;
+
+		transfers=numBytes/TCostTable::BUS_BYTES;
+		cycles=transfers*cyclesPerValue;
+
+		if(_writingGram) {
+			_profile.PixelWrites+=transfers;
+			_profile.PixelCycles+=cycles;
+		}
+		else {
+			_profile.ParameterWrites+=transfers;
+			_profile.WindowCycles+=cycles;
+		}
+	}
+
+
+	/**
+	 * Initialise the wrapped access mode
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::initialise() {
+		TAccessMode::initialise();
+	}
+
+
+	/**
+	 * Hard reset through the wrapped access mode
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::hardReset() {
+		TAccessMode::hardReset();
+	}
+
+
+	/**
+	 * Write an 8-bit command
+	 * @param command The command to write
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::writeCommand(uint8_t command) {
+		countCommand(command);
+		TAccessMode::writeCommand(command);
+	}
+
+
+	/**
+	 * Write a 16-bit command
+	 * @param lo8 The low 8 bits of the command to write
+	 * @param hi8 The high 8 bits of the command to write
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::writeCommand(uint8_t lo8,uint8_t hi8) {
+		countCommand(lo8);
+		TAccessMode::writeCommand(lo8,hi8);
+	}
+
+
+	/**
+	 * Write a command and a data parameter
+	 * @param cmd The 8-bit command to write.
+	 * @param lo8 The low 8 bits of the data to write.
+	 * @param hi8 The high 8 bits of the data to write.
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::writeCommandData(uint8_t cmd,uint8_t lo8,uint8_t hi8) {
+		countCommand(cmd);
+		countData();
+		TAccessMode::writeCommandData(cmd,lo8,hi8);
+	}
+
+
+	/**
+	 * Write an 8-bit data value
+	 * @param data The value to write
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::writeData(uint8_t data) {
+		countData();
+		TAccessMode::writeData(data);
+	}
+
+
+	/**
+	 * Write a 16-bit data value
+	 * @param lo8 The low 8 bits of the value to write.
+	 * @param hi8 The high 8 bits of the value to write.
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::writeData(uint8_t lo8,uint8_t hi8) {
+		countData();
+		TAccessMode::writeData(lo8,hi8);
+	}
+
+
+	/**
+	 * Repeat the last 8-bit data value
+	 * @param data The value to write
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::writeDataAgain(uint8_t data) {
+
+		_profile.DataAgainWrites++;
+		_profile.PixelCycles+=TCostTable::DATA_AGAIN;
+
+		TAccessMode::writeDataAgain(data);
+	}
+
+
+	/**
+	 * Repeat the last 16-bit data value
+	 * @param lo8 The low 8 bits of the value to write.
+	 * @param hi8 The high 8 bits of the value to write.
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::writeDataAgain(uint8_t lo8,uint8_t hi8) {
+
+		_profile.DataAgainWrites++;
+		_profile.PixelCycles+=TCostTable::DATA_AGAIN;
+
+		TAccessMode::writeDataAgain(lo8,hi8);
+	}
+
+
+	/**
+	 * Write a batch of the same 8-bit value
+	 * @param howMuch The number of values to write
+	 * @param data The value to write
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::writeMultiData(uint32_t howMuch,uint8_t data) {
+
+		countMultiData(howMuch,1);
+		TAccessMode::writeMultiData(howMuch,data);
+	}
+
+
+	/**
+	 * Write a batch of the same 16-bit value, or a 2-byte pattern on an 8-bit bus
+	 * @param howMuch The number of values to write
+	 * @param lo8 The low 8 bits of the value to write
+	 * @param hi8 The high 8 bits of the value to write
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::writeMultiData(uint32_t howMuch,uint8_t lo8,uint8_t hi8) {
+
+		countMultiData(howMuch,2);
+		TAccessMode::writeMultiData(howMuch,lo8,hi8);
+	}
+
+
+	/**
+	 * Write a batch of the same 3-byte pattern to an 8-bit bus
+	 * @param howMuch The number of times to write the pattern
+	 * @param first The first byte of the pattern
+	 * @param second The second byte of the pattern
+	 * @param third The third byte of the pattern
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::writeMultiData(uint32_t howMuch,uint8_t first,uint8_t second,uint8_t third) {
+
+		countMultiData(howMuch,3);
+		TAccessMode::writeMultiData(howMuch,first,second,third);
+	}
+
+
+	/**
+	 * Write a byte from a stream. Streamed data is always pixel data.
+	 * @param data The 8-bits
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::writeStreamedData(uint8_t data) {
+
+		_profile.PixelWrites++;
+		_profile.PixelCycles+=TCostTable::STREAMED_DATA;
+
+		TAccessMode::writeStreamedData(data);
+	}
+
+
+	/**
+	 * Write a block of bytes from memory
+	 * @param data The bytes to write
+	 * @param numBytes The number of bytes to write
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::writeDataBlock(const uint8_t *data,uint16_t numBytes) {
+		countDataBlock(numBytes,TCostTable::BLOCK_DATA_PER_VALUE);
+		TAccessMode::writeDataBlock(data,numBytes);
+	}
+
+
+	/**
+	 * Write a block of bytes from flash
+	 * @param data The flash address of the bytes to write
+	 * @param numBytes The number of bytes to write
+	 */
+
+	template<class TAccessMode,class TCostTable,uint8_t TGramWriteCommand>
+	inline void ProfilingAccessMode<TAccessMode,TCostTable,TGramWriteCommand>::writeFlashDataBlock(uint32_t data,uint32_t numBytes) {
+		countDataBlock(numBytes,TCostTable::FLASH_DATA_PER_VALUE);
+		TAccessMode::writeFlashDataBlock(data,numBytes);
+	}
+}
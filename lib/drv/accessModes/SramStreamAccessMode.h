@@ -0,0 +1,95 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file SramStreamAccessMode.h
+ * @ingroup AccessModes
+ * @brief An access mode stand-in that captures streamed bytes into an SRAM buffer.
+ */
+
+#pragma once
+
+
+namespace lcd {
+
+	/**
+	 * @brief Capture the streamed output of a decoder into memory.
+	 *
+	 * LzgFlashDecoder writes its output a byte at a time with writeStreamedData(). Decoding through this
+	 * class instead of a real access mode leaves the decoded bytes in a buffer, e.g. so that a glyph can be
+	 * cached and written to the panel later with a block transfer. Bytes beyond the end of the buffer
+	 * are dropped.
+	 *
+	 * Only writeStreamedData() is provided. The state is static, like the access modes themselves.
+	 *
+	 * @tparam TOwner The class that uses the buffer. It only serves to give each user its own static state.
+	 * @ingroup AccessModes
+	 */
+
+	template<class TOwner>
+	class SramStreamAccessMode {
+
+		protected:
+			static uint8_t *_ptr;
+			static uint8_t *_end;
+
+		public:
+			static void setBuffer(uint8_t *buffer,uint16_t size);
+			static void writeStreamedData(uint8_t data);
+	};
+
+
+	/*
+	 * Static member definitions
+	 */
+
+	template<class TOwner>
+	uint8_t *SramStreamAccessMode<TOwner>::_ptr;
+
+	template<class TOwner>
+	uint8_t *SramStreamAccessMode<TOwner>::_end;
+
+
+	/**
+	 * Set the buffer that receives the bytes and reset the position to its start.
+	 * @param buffer The buffer.
+	 * @param size The size of the buffer in bytes.
+	 */
+
+	template<class TOwner>
+	inline void SramStreamAccessMode<TOwner>::setBuffer(uint8_t *buffer,uint16_t size) {
+		_ptr=buffer;
+		_end=buffer+size;
+	}
+
+
+	/**
+	 * Store the byte if there is room for it.
+	 * @param data The byte to store.
+	 */
+
+	template<class TOwner>
+	inline void SramStreamAccessMode<TOwner>::writeStreamedData(uint8_t data) {
+
+		if(_ptr!=_end)
+			*_ptr++=data;
+	}
+}
@@ -88,6 +88,14 @@ namespace lcd {
 			static uint8_t _streamByte;
 
 		public:
+			/**
+			 * writeStreamedData() pairs bytes into 16-bit (lo8,hi8) transfers
+			 */
+
+			enum {
+				STREAM_TRANSFER_BYTES = 2
+			};
+
 			static void initialise();
 			static void hardReset();
 
@@ -96,7 +104,10 @@ namespace lcd {
 			static void writeData(uint8_t lo8,uint8_t hi8=0);
 			static void writeDataAgain(uint8_t lo8,uint8_t hi8=0);
 			static void writeMultiData(uint32_t howMuch,uint8_t lo8,uint8_t hi8=0);
+			static void writeMultiData(uint32_t howMuch,uint8_t first,uint8_t second,uint8_t third);
 			static void writeStreamedData(uint8_t data);
+			static void writeDataBlock(const uint8_t *data,uint16_t numBytes);
+			static void writeFlashDataBlock(uint32_t data,uint32_t numBytes);
 	};
 
 
@@ -201,6 +212,160 @@ namespace lcd {
 	}
 
 
+	/**
+	 * Write a batch of the same 3-transfer pattern, e.g. an 18-bit pixel in the ILI9325's 3-transfer mode.
+	 * Each byte of the pattern is a transfer of its own with the upper 8 bits zero.
+	 * @param howMuch The number of times to write the pattern
+	 * @param first The first byte of the pattern
+	 * @param second The second byte of the pattern
+	 * @param third The third byte of the pattern
+	 */
+
+	inline void Xmem16AccessMode::writeMultiData(uint32_t howMuch,uint8_t first,uint8_t second,uint8_t third) {
+
+		while(howMuch--) {
+			writeData(first);
+			writeData(second);
+			writeData(third);
+		}
+	}
+
+
+	/**
+	 * Write a block of 16-bit values from SRAM to the XMEM interface. The block is a sequence of (lo8,hi8)
+	 * byte pairs, the same layout that writeData() takes its parameters in. Pairs are written out in
+	 * unrolled batches of 8 with the source in Z so that each value costs two 'ld Z+' and one 'st X'
+	 * (7 clock cycles) with no per-value call or loop overhead.
+	 * @param data The byte pairs to write
+	 * @param numBytes The number of bytes to write. Must be even.
+	 */
+
+	inline void Xmem16AccessMode::writeDataBlock(const uint8_t *data,uint16_t numBytes) {
+
+		uint16_t numValues;
+		uint8_t remainder,hi8;
+
+		numValues=numBytes/2;
+
+		while(numValues>=8) {
+
+			__asm volatile("  ldi r27,0x81  \n\t"
+                   "  ld  r26,Z+    \n\t"
+                   "  ld  %1,Z+     \n\t"
+                   "  st  X,%1      \n\t"
+                   "  ld  r26,Z+    \n\t"
+                   "  ld  %1,Z+     \n\t"
+                   "  st  X,%1      \n\t"
+                   "  ld  r26,Z+    \n\t"
+                   "  ld  %1,Z+     \n\t"
+                   "  st  X,%1      \n\t"
+                   "  ld  r26,Z+    \n\t"
+                   "  ld  %1,Z+     \n\t"
+                   "  st  X,%1      \n\t"
+                   "  ld  r26,Z+    \n\t"
+                   "  ld  %1,Z+     \n\t"
+                   "  st  X,%1      \n\t"
+                   "  ld  r26,Z+    \n\t"
+                   "  ld  %1,Z+     \n\t"
+                   "  st  X,%1      \n\t"
+                   "  ld  r26,Z+    \n\t"
+                   "  ld  %1,Z+     \n\t"
+                   "  st  X,%1      \n\t"
+                   "  ld  r26,Z+    \n\t"
+                   "  ld  %1,Z+     \n\t"
+                   "  st  X,%1      \n\t"
+                   : "+z" (data), "=&r" (hi8)
+                   :: "r26", "r27", "memory");
+
+			numValues-=8;
+		}
+
+		// finish off the last few
+
+		remainder=numValues;
+
+		while(remainder--) {
+			writeData(data[0],data[1]);
+			data+=2;
+		}
+	}
+
+
+	/**
+	 * Write a block of 16-bit values from flash to the XMEM interface. The block is a sequence of (lo8,hi8)
+	 * byte pairs that may be anywhere in flash and may cross 64Kb segment boundaries. RAMPZ is set up once
+	 * per segment and the pairs are written out in unrolled batches of 8 so that each value costs two
+	 * 'elpm Z+' and one 'st X' (9 clock cycles counted from the instruction timings, not measured).
+	 * @param data The 24-bit flash address of the byte pairs
+	 * @param numBytes The number of bytes to write. An odd trailing byte is ignored.
+	 */
+
+	inline void Xmem16AccessMode::writeFlashDataBlock(uint32_t data,uint32_t numBytes) {
+
+		uint16_t address,count,numValues;
+		uint8_t remainder,lo8,hi8;
+
+		numBytes&=~1UL;
+
+		while(numBytes) {
+
+			// a pair that straddles the end of the segment is completed by the carry from Z into RAMPZ
+
+			count=FarFlashReader::beginSegment(data,numBytes);
+			count+=count & 1;
+			address=data;
+
+			data+=count;
+			numBytes-=count;
+
+			numValues=count/2;
+
+			while(numValues>=8) {
+
+				__asm volatile("  ldi r27,0x81   \n\t"
+                   "  elpm r26,Z+   \n\t"
+                   "  elpm %1,Z+    \n\t"
+                   "  st   X,%1     \n\t"
+                   "  elpm r26,Z+   \n\t"
+                   "  elpm %1,Z+    \n\t"
+                   "  st   X,%1     \n\t"
+                   "  elpm r26,Z+   \n\t"
+                   "  elpm %1,Z+    \n\t"
+                   "  st   X,%1     \n\t"
+                   "  elpm r26,Z+   \n\t"
+                   "  elpm %1,Z+    \n\t"
+                   "  st   X,%1     \n\t"
+                   "  elpm r26,Z+   \n\t"
+                   "  elpm %1,Z+    \n\t"
+                   "  st   X,%1     \n\t"
+                   "  elpm r26,Z+   \n\t"
+                   "  elpm %1,Z+    \n\t"
+                   "  st   X,%1     \n\t"
+                   "  elpm r26,Z+   \n\t"
+                   "  elpm %1,Z+    \n\t"
+                   "  st   X,%1     \n\t"
+                   "  elpm r26,Z+   \n\t"
+                   "  elpm %1,Z+    \n\t"
+                   "  st   X,%1     \n\t"
+                   : "+z" (address), "=&r" (hi8)
+                   :: "r26", "r27");
+
+				numValues-=8;
+			}
+
+			// finish off the last few
+
+			remainder=numValues;
+
+			while(remainder--) {
+				lo8=FarFlashReader::read(address);
+				hi8=FarFlashReader::read(address);
+				writeData(lo8,hi8);
+			}
+		}
+	}
+
+
 	/**
 	 * Enable the XMEM interface so we can talk to the panel through direct memory addressing.
 	 * Pins PC3..PC7 are freed up for GPIO. The XMEM interface is configured with zero wait
@@ -82,12 +82,26 @@ namespace lcd {
 			};
 
 		public:
+			/**
+			 * writeStreamedData() sends each byte as a transfer of its own
+			 */
+
+			enum {
+				STREAM_TRANSFER_BYTES = 1
+			};
+
 			static void initialise();
 			static void hardReset();
 
 			static void writeCommand(uint8_t command) __attribute((always_inline));
 			static void writeData(uint8_t data) __attribute((always_inline));
 			static void writeStreamedData(uint8_t data) __attribute((always_inline));
+
+			static void writeDataAgain(uint8_t data) __attribute((always_inline));
+			static void writeMultiData(uint32_t howMuch,uint8_t first,uint8_t second);
+			static void writeMultiData(uint32_t howMuch,uint8_t first,uint8_t second,uint8_t third);
+			static void writeDataBlock(const uint8_t *data,uint16_t numBytes);
+			static void writeFlashDataBlock(uint32_t data,uint32_t numBytes);
 	};
 
 
@@ -122,6 +136,265 @@ namespace lcd {
 	}
 
 
+	/**
+	 * Write the same data as the previous call to writeData(). XMEM drives the data lines on every
+	 * write so there's nothing to save and this falls back to writeData().
+	 * @param data The data value to write
+	 */
+
+	inline void XmemAccessMode::writeDataAgain(uint8_t data) {
+		writeData(data);
+	}
+
+
+	/**
+	 * Write a batch of the same 2-byte pattern to the XMEM interface, e.g. a 16-bit pixel. The pattern is
+	 * written out in unrolled batches of 20 (40 strobes) so that the loop overhead is paid once per batch
+	 * instead of once per pixel. Each strobe is a single 'sts' to external memory.
+	 * @param howMuch The number of times to write the pattern
+	 * @param first The first byte of the pattern
+	 * @param second The second byte of the pattern
+	 */
+
+	inline void XmemAccessMode::writeMultiData(uint32_t howMuch,uint8_t first,uint8_t second) {
+
+		volatile uint8_t *data;
+		uint8_t remainder;
+
+		data=reinterpret_cast<volatile uint8_t *>(0x8100);
+
+		while(howMuch>=20) {
+
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+			*data=first;
+			*data=second;
+
+			howMuch-=20;
+		}
+
+		// finish off the last few
+
+		remainder=howMuch;
+
+		while(remainder--) {
+			*data=first;
+			*data=second;
+		}
+	}
+
+
+	/**
+	 * Write a batch of the same 3-byte pattern to the XMEM interface, e.g. an 18 or 24-bit pixel. The pattern
+	 * is written out in unrolled batches of 13 (39 strobes).
+	 * @param howMuch The number of times to write the pattern
+	 * @param first The first byte of the pattern
+	 * @param second The second byte of the pattern
+	 * @param third The third byte of the pattern
+	 */
+
+	inline void XmemAccessMode::writeMultiData(uint32_t howMuch,uint8_t first,uint8_t second,uint8_t third) {
+
+		volatile uint8_t *data;
+		uint8_t remainder;
+
+		data=reinterpret_cast<volatile uint8_t *>(0x8100);
+
+		while(howMuch>=13) {
+
+			*data=first;
+			*data=second;
+			*data=third;
+			*data=first;
+			*data=second;
+			*data=third;
+			*data=first;
+			*data=second;
+			*data=third;
+			*data=first;
+			*data=second;
+			*data=third;
+			*data=first;
+			*data=second;
+			*data=third;
+			*data=first;
+			*data=second;
+			*data=third;
+			*data=first;
+			*data=second;
+			*data=third;
+			*data=first;
+			*data=second;
+			*data=third;
+			*data=first;
+			*data=second;
+			*data=third;
+			*data=first;
+			*data=second;
+			*data=third;
+			*data=first;
+			*data=second;
+			*data=third;
+			*data=first;
+			*data=second;
+			*data=third;
+			*data=first;
+			*data=second;
+			*data=third;
+
+			howMuch-=13;
+		}
+
+		// finish off the last few
+
+		remainder=howMuch;
+
+		while(remainder--) {
+			*data=first;
+			*data=second;
+			*data=third;
+		}
+	}
+
+
+	/**
+	 * Write a block of bytes from SRAM to the XMEM interface, one strobe per byte. The block is written out
+	 * in unrolled batches of 16 so that the loop overhead is paid once per batch. Each byte costs an
+	 * 'ld Z+' and an 'sts' to external memory.
+	 * @param data The bytes to write
+	 * @param numBytes The number of bytes to write
+	 */
+
+	inline void XmemAccessMode::writeDataBlock(const uint8_t *data,uint16_t numBytes) {
+
+		volatile uint8_t *lcd;
+		uint8_t remainder;
+
+		lcd=reinterpret_cast<volatile uint8_t *>(0x8100);
+
+		while(numBytes>=16) {
+
+			*lcd=*data++;
+			*lcd=*data++;
+			*lcd=*data++;
+			*lcd=*data++;
+			*lcd=*data++;
+			*lcd=*data++;
+			*lcd=*data++;
+			*lcd=*data++;
+			*lcd=*data++;
+			*lcd=*data++;
+			*lcd=*data++;
+			*lcd=*data++;
+			*lcd=*data++;
+			*lcd=*data++;
+			*lcd=*data++;
+			*lcd=*data++;
+
+			numBytes-=16;
+		}
+
+		// finish off the last few
+
+		remainder=numBytes;
+
+		while(remainder--)
+			*lcd=*data++;
+	}
+
+
+	/**
+	 * Write a block of bytes from flash to the XMEM interface, one strobe per byte. The block may be
+	 * anywhere in flash and may cross 64Kb segment boundaries. Each segment is written out in unrolled
+	 * batches of 16, with each byte costing an 'elpm Z+' and an 'sts' to external memory.
+	 * @param data The 24-bit flash address of the bytes
+	 * @param numBytes The number of bytes to write
+	 */
+
+	inline void XmemAccessMode::writeFlashDataBlock(uint32_t data,uint32_t numBytes) {
+
+		volatile uint8_t *lcd;
+		uint16_t address,count;
+		uint8_t remainder;
+
+		lcd=reinterpret_cast<volatile uint8_t *>(0x8100);
+
+		while(numBytes) {
+
+			count=FarFlashReader::beginSegment(data,numBytes);
+			address=data;
+
+			data+=count;
+			numBytes-=count;
+
+			while(count>=16) {
+
+				*lcd=FarFlashReader::read(address);
+				*lcd=FarFlashReader::read(address);
+				*lcd=FarFlashReader::read(address);
+				*lcd=FarFlashReader::read(address);
+				*lcd=FarFlashReader::read(address);
+				*lcd=FarFlashReader::read(address);
+				*lcd=FarFlashReader::read(address);
+				*lcd=FarFlashReader::read(address);
+				*lcd=FarFlashReader::read(address);
+				*lcd=FarFlashReader::read(address);
+				*lcd=FarFlashReader::read(address);
+				*lcd=FarFlashReader::read(address);
+				*lcd=FarFlashReader::read(address);
+				*lcd=FarFlashReader::read(address);
+				*lcd=FarFlashReader::read(address);
+				*lcd=FarFlashReader::read(address);
+
+				count-=16;
+			}
+
+			// finish off the last few
+
+			remainder=count;
+
+			while(remainder--)
+				*lcd=FarFlashReader::read(address);
+		}
+	}
+
+
 	/**
 	 * Enable the XMEM interface so we can talk to the panel through
 	 * direct memory addressing. data off the Arduino Mega.
@@ -32,7 +32,8 @@
 
 #pragma once
 
-#include "commands/Allcommands.h"
+#include "commands/AllCommands.h"
+#include "drv/RegisterShadow.h"
 #include "HX8347AColour.h"
 #include "HX8347AOrientation.h"
 
@@ -46,11 +47,12 @@ namespace lcd {
 	 * @tparam TOrientation The desired panel orientation, LANDSCAPE or PORTRAIT
 	 * @tparam TColourDepth The colour depth for your use, just 64K is supported for this panel.
 	 * @tparam TAccessMode The access mode that you want to talk to this panel with, e.g. Gpio16LatchAccessMode.
+	 * @tparam TWindowShadowing WINDOW_SHADOW_ON to skip writing window registers that already hold the required value.
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing=WINDOW_SHADOW_OFF>
 	class HX8347A : public HX8347AColour<TColourDepth,TAccessMode>,
-									public HX8347AOrientation<TOrientation,TAccessMode> {
+									public HX8347AOrientation<TOrientation,TAccessMode,TWindowShadowing> {
 
 		public:
 
@@ -82,8 +84,8 @@ namespace lcd {
 	 * Constructor. Calls the initialise() member.
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline HX8347A<TOrientation,TColourDepth,TAccessMode>::HX8347A() {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline HX8347A<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::HX8347A() {
 		initialise();
 	}
 
@@ -92,8 +94,12 @@ namespace lcd {
 	 * Initialise the LCD. Do the reset sequence. Long and painful for this panel.
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void HX8347A<TOrientation,TColourDepth,TAccessMode>::initialise() const {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void HX8347A<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::initialise() const {
+
+		// the reset will put the window registers back to their defaults
+
+		this->invalidateShadow();
 
 		// initialise the access mode
 
@@ -218,8 +224,8 @@ namespace lcd {
 	 * full power saving.
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void HX8347A<TOrientation,TColourDepth,TAccessMode>::sleep() const {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void HX8347A<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::sleep() const {
 
 			// GON=1, DTE=1, D=10
 		TAccessMode::writeCommandData(hx8347a::DISPLAY_CONTROL_1,0x38);
@@ -250,8 +256,10 @@ namespace lcd {
 	 * Wake the panel up. Don't forget to switch the backlight back on.
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void HX8347A<TOrientation,TColourDepth,TAccessMode>::wake() const {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void HX8347A<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::wake() const {
+
+		this->invalidateShadow();
 
 		// OSCADJ=10 0000, OSD_EN=1 //60Hz
 		TAccessMode::writeCommandData(hx8347a::OSC_CONTROL_1,0x49);
@@ -284,8 +292,8 @@ namespace lcd {
 	 * Issue the command that allows graphics ram writing to commence
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void HX8347A<TOrientation,TColourDepth,TAccessMode>::beginWriting() const {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void HX8347A<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::beginWriting() const {
 		TAccessMode::writeCommand(hx8347a::MEMORY_WRITE);
 	}
 
@@ -296,8 +304,8 @@ namespace lcd {
 	 * @param height The height of the region
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void HX8347A<TOrientation,TColourDepth,TAccessMode>::setScrollArea(uint16_t y,uint16_t height) const {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void HX8347A<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::setScrollArea(uint16_t y,uint16_t height) const {
 
 		uint16_t bfa,tfa;
 
@@ -319,27 +327,9 @@ namespace lcd {
 	 * @param numBytes The number of bytes to transfer
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void HX8347A<TOrientation,TColourDepth,TAccessMode>::rawFlashTransfer(uint32_t data,uint32_t numBytes) const {
-
-		uint32_t numPixels;
-
-		numPixels=numBytes/2;
-
-		// handle data in the lower and upper segments with possible overlap
-		// a single 16-bit pixel should not overlap the segments
-
-		while(data<65536 && numPixels>0) {
-			TAccessMode::writeData(pgm_read_byte_near(data),pgm_read_byte_near(data+1));
-			data+=2;
-			numPixels--;
-		}
-
-		while(numPixels>0) {
-			TAccessMode::writeData(pgm_read_byte_far(data),pgm_read_byte_far(data+1));
-			data+=2;
-			numPixels--;
-		}
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void HX8347A<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::rawFlashTransfer(uint32_t data,uint32_t numBytes) const {
+		TAccessMode::writeFlashDataBlock(data,numBytes);
 	}
 
 
@@ -349,16 +339,17 @@ namespace lcd {
 	 * @param numBytes number of bytes to write.
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void HX8347A<TOrientation,TColourDepth,TAccessMode>::rawSramTransfer(uint8_t *data,uint32_t numBytes) const {
-
-		uint32_t numPixels;
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void HX8347A<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::rawSramTransfer(uint8_t *data,uint32_t numBytes) const {
 
-		numPixels=numBytes/2;
+		// the access modes take a 16-bit byte count
 
-		while(numPixels--) {
-			TAccessMode::writeData(data[0],data[1]);
-			data+=2;
+		while(numBytes>0xfffe) {
+			TAccessMode::writeDataBlock(data,0xfffe);
+			data+=0xfffe;
+			numBytes-=0xfffe;
 		}
+
+		TAccessMode::writeDataBlock(data,numBytes);
 	}
 }
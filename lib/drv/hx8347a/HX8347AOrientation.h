@@ -40,9 +40,53 @@ namespace lcd {
 	 * @ingroup HX8347A
 	 */
 
-	template<Orientation TOrientation,class TAccessMode>
+	template<Orientation TOrientation,class TAccessMode,WindowShadowing TWindowShadowing>
 	class HX8347AOrientation {
 	};
+
+
+	/**
+	 * @brief Window register writer shared by the orientation specialisations.
+	 *
+	 * Only the four end address registers are shadowed. The start address registers are always
+	 * written because they also position the address counter.
+	 * @ingroup HX8347A
+	 */
+
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	class HX8347AWindowRegisters : public RegisterShadow<TWindowShadowing,4> {
+
+		protected:
+
+			/**
+			 * Write the column end address if it has changed
+			 * @param xend The new end column
+			 */
+
+			void writeColumnEnd(int16_t xend) const {
+
+				if(this->updateShadow(0,xend >> 8))
+					TAccessMode::writeCommandData(hx8347a::COLUMN_ADDRESS_END_HIGH,xend >> 8);
+
+				if(this->updateShadow(1,xend & 0xff))
+					TAccessMode::writeCommandData(hx8347a::COLUMN_ADDRESS_END_LOW,xend & 0xff);
+			}
+
+
+			/**
+			 * Write the row end address if it has changed
+			 * @param yend The new end row
+			 */
+
+			void writeRowEnd(int16_t yend) const {
+
+				if(this->updateShadow(2,yend >> 8))
+					TAccessMode::writeCommandData(hx8347a::ROW_ADDRESS_END_HIGH,yend >> 8);
+
+				if(this->updateShadow(3,yend & 0xff))
+					TAccessMode::writeCommandData(hx8347a::ROW_ADDRESS_END_LOW,yend & 0xff);
+			}
+	};
 }
 
 
@@ -34,11 +34,12 @@ namespace lcd {
 	/**
 	 * @brief Specialisation of HX8347AOrientation for the panel in PORTRAIT mode.
 	 * @tparam TAccessMode the access mode implementation, eg Gpio16LatchAccessMode
+	 * @tparam TWindowShadowing Whether to shadow the window registers
 	 * @ingroup HX8347A
 	 */
 
-	template<class TAccessMode>
-	class HX8347AOrientation<PORTRAIT,TAccessMode> {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	class HX8347AOrientation<PORTRAIT,TAccessMode,TWindowShadowing> : public HX8347AWindowRegisters<TAccessMode,TWindowShadowing> {
 
 		protected:
 			uint16_t getOrientationMemoryAccessCtrl() const;
@@ -60,8 +61,8 @@ namespace lcd {
 	 * @return The entry mode register setting for portrait
 	 */
 
-	template<class TAccessMode>
-	inline uint16_t HX8347AOrientation<PORTRAIT,TAccessMode>::getOrientationMemoryAccessCtrl() const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline uint16_t HX8347AOrientation<PORTRAIT,TAccessMode,TWindowShadowing>::getOrientationMemoryAccessCtrl() const {
 		return 1 << 6;		// MX
 	}
 
@@ -71,8 +72,8 @@ namespace lcd {
 	 * @return 240px
 	 */
 
-	template<class TAccessMode>
-	inline int16_t HX8347AOrientation<PORTRAIT,TAccessMode>::getWidth() const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline int16_t HX8347AOrientation<PORTRAIT,TAccessMode,TWindowShadowing>::getWidth() const {
 		return 240;
 	}
 
@@ -82,8 +83,8 @@ namespace lcd {
 	 * @return 320px
 	 */
 
-	template<class TAccessMode>
-	inline int16_t HX8347AOrientation<PORTRAIT,TAccessMode>::getHeight() const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline int16_t HX8347AOrientation<PORTRAIT,TAccessMode,TWindowShadowing>::getHeight() const {
 		return 320;
 	}
 
@@ -93,8 +94,8 @@ namespace lcd {
 	 * @param rc The display output rectangle
 	 */
 
-	template<class TAccessMode>
-	inline void HX8347AOrientation<PORTRAIT,TAccessMode>::moveTo(const Rectangle& rc) const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void HX8347AOrientation<PORTRAIT,TAccessMode,TWindowShadowing>::moveTo(const Rectangle& rc) const {
 		moveTo(rc.X,rc.Y,rc.X+rc.Width-1,rc.Y+rc.Height-1);
 	}
 
@@ -107,18 +108,16 @@ namespace lcd {
 	 * @param yend bottom-most y co-ordinate
 	 */
 
-	template<class TAccessMode>
-	inline void HX8347AOrientation<PORTRAIT,TAccessMode>::moveTo(int16_t xstart,int16_t ystart,int16_t xend,int16_t yend) const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void HX8347AOrientation<PORTRAIT,TAccessMode,TWindowShadowing>::moveTo(int16_t xstart,int16_t ystart,int16_t xend,int16_t yend) const {
 
 		TAccessMode::writeCommandData(hx8347a::COLUMN_ADDRESS_START_HIGH,xstart >> 8);
 		TAccessMode::writeCommandData(hx8347a::COLUMN_ADDRESS_START_LOW,xstart & 0xff);
-		TAccessMode::writeCommandData(hx8347a::COLUMN_ADDRESS_END_HIGH,xend >> 8);
-		TAccessMode::writeCommandData(hx8347a::COLUMN_ADDRESS_END_LOW,xend & 0xff);
+		this->writeColumnEnd(xend);
 
 		TAccessMode::writeCommandData(hx8347a::ROW_ADDRESS_START_HIGH,ystart >> 8);
 		TAccessMode::writeCommandData(hx8347a::ROW_ADDRESS_START_LOW,ystart & 0xff);
-		TAccessMode::writeCommandData(hx8347a::ROW_ADDRESS_END_HIGH,yend >> 8);
-		TAccessMode::writeCommandData(hx8347a::ROW_ADDRESS_END_LOW,yend & 0xff);
+		this->writeRowEnd(yend);
 	}
 
 
@@ -128,13 +127,12 @@ namespace lcd {
 	 * @param xend The new X end position
 	 */
 
-	template<class TAccessMode>
-	inline void HX8347AOrientation<PORTRAIT,TAccessMode>::moveX(int16_t xstart,int16_t xend) const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void HX8347AOrientation<PORTRAIT,TAccessMode,TWindowShadowing>::moveX(int16_t xstart,int16_t xend) const {
 
 		TAccessMode::writeCommandData(hx8347a::COLUMN_ADDRESS_START_HIGH,xstart >> 8);
 		TAccessMode::writeCommandData(hx8347a::COLUMN_ADDRESS_START_LOW,xstart & 0xff);
-		TAccessMode::writeCommandData(hx8347a::COLUMN_ADDRESS_END_HIGH,xend >> 8);
-		TAccessMode::writeCommandData(hx8347a::COLUMN_ADDRESS_END_LOW,xend & 0xff);
+		this->writeColumnEnd(xend);
 	}
 
 
@@ -143,13 +141,12 @@ namespace lcd {
 	 * @param ystart The new Y start position
 	 */
 
-	template<class TAccessMode>
-	inline void HX8347AOrientation<PORTRAIT,TAccessMode>::moveY(int16_t ystart,int16_t yend) const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void HX8347AOrientation<PORTRAIT,TAccessMode,TWindowShadowing>::moveY(int16_t ystart,int16_t yend) const {
 
 		TAccessMode::writeCommandData(hx8347a::ROW_ADDRESS_START_HIGH,ystart >> 8);
 		TAccessMode::writeCommandData(hx8347a::ROW_ADDRESS_START_LOW,ystart & 0xff);
-		TAccessMode::writeCommandData(hx8347a::ROW_ADDRESS_END_HIGH,yend >> 8);
-		TAccessMode::writeCommandData(hx8347a::ROW_ADDRESS_END_LOW,yend & 0xff);
+		this->writeRowEnd(yend);
 	}
 
 
@@ -158,8 +155,8 @@ namespace lcd {
 	 * @param scrollPosition The new scroll position
 	 */
 
-	template<class TAccessMode>
-	inline void HX8347AOrientation<PORTRAIT,TAccessMode>::setScrollPosition(int16_t scrollPosition) const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void HX8347AOrientation<PORTRAIT,TAccessMode,TWindowShadowing>::setScrollPosition(int16_t scrollPosition) const {
 
 		scrollPosition=scrollPosition ? 320-scrollPosition : 0;
 
@@ -38,7 +38,8 @@
 #pragma once
 
 #include "Arduino.h"
-#include "commands/Allcommands.h"
+#include "commands/AllCommands.h"
+#include "drv/RegisterShadow.h"
 #include "ILI9325Colour.h"
 #include "ILI9325Orientation.h"
 
@@ -51,11 +52,12 @@ namespace lcd {
 	 * @tparam TOrientation The desired panel orientation, LANDSCAPE or PORTRAIT
 	 * @tparam TColourDepth The colour depth for your use, just 64K is supported for this panel.
 	 * @tparam TAccessMode The access mode that you want to talk to this panel with, e.g. Gpio16LatchAccessMode.
+	 * @tparam TWindowShadowing WINDOW_SHADOW_ON to skip writing window registers that already hold the required value.
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing=WINDOW_SHADOW_OFF>
 	class ILI9325 : public ILI9325Colour<TColourDepth,TAccessMode>,
-									public ILI9325Orientation<TOrientation,TAccessMode> {
+									public ILI9325Orientation<TOrientation,TAccessMode,TWindowShadowing> {
 
 		public:
 			enum {
@@ -77,8 +79,8 @@ namespace lcd {
 	 * Constructor
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline ILI9325<TOrientation,TColourDepth,TAccessMode>::ILI9325() {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline ILI9325<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::ILI9325() {
 		initialise();
 	}
 
@@ -87,8 +89,12 @@ namespace lcd {
 	 * Initialise the LCD. Do the reset sequence.
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void ILI9325<TOrientation,TColourDepth,TAccessMode>::initialise() const {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9325<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::initialise() const {
+
+		// the reset will put the window registers back to their defaults
+
+		this->invalidateShadow();
 
 		// initialise the access mode
 
@@ -178,8 +184,8 @@ namespace lcd {
 	 * Send the panel to sleep
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void ILI9325<TOrientation,TColourDepth,TAccessMode>::sleep() const {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9325<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::sleep() const {
 		TAccessMode::writeCommandData(ili9325::ILI932X_DISP_CTRL1,0x00,0x00);
 		TAccessMode::writeCommandData(ili9325::ILI932X_POW_CTRL1,0x01,0x00);
 	}
@@ -189,8 +195,11 @@ namespace lcd {
 	 * Wake the panel up
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void ILI9325<TOrientation,TColourDepth,TAccessMode>::wake() const {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9325<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::wake() const {
+
+		this->invalidateShadow();
+
 		TAccessMode::writeCommandData(ili9325::ILI932X_POW_CTRL1,0x90,0x16);
 		TAccessMode::writeCommandData(ili9325::ILI932X_DISP_CTRL1,0x33,0x01);
 	}
@@ -200,8 +209,8 @@ namespace lcd {
 	 * Issue the command that allows graphics ram writing to commence
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void ILI9325<TOrientation,TColourDepth,TAccessMode>::beginWriting() const {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9325<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::beginWriting() const {
 		TAccessMode::writeCommand(ili9325::ILI932X_RW_GRAM);
 	}
 
@@ -212,8 +221,8 @@ namespace lcd {
 	 * @param height The height of the region
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void ILI9325<TOrientation,TColourDepth,TAccessMode>::setScrollArea(uint16_t y,uint16_t height) const {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9325<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::setScrollArea(uint16_t y,uint16_t height) const {
 		// not supported
 	}
 
@@ -224,27 +233,9 @@ namespace lcd {
 	 * @param numBytes The number of bytes to transfer
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void ILI9325<TOrientation,TColourDepth,TAccessMode>::rawFlashTransfer(uint32_t data,uint32_t numBytes) const {
-
-		uint32_t numPixels;
-
-		numPixels=numBytes/2;
-
-		// handle data in the lower and upper segments with possible overlap
-		// a single 16-bit pixel should not overlap the segments
-
-		while(data<65536 && numPixels>0) {
-			TAccessMode::writeData(pgm_read_byte_near(data),pgm_read_byte_near(data+1));
-			data+=2;
-			numPixels--;
-		}
-
-		while(numPixels>0) {
-			TAccessMode::writeData(pgm_read_byte_far(data),pgm_read_byte_far(data+1));
-			data+=2;
-			numPixels--;
-		}
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9325<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::rawFlashTransfer(uint32_t data,uint32_t numBytes) const {
+		TAccessMode::writeFlashDataBlock(data,numBytes);
 	}
 
 
@@ -254,16 +245,17 @@ namespace lcd {
 	 * @param numBytes number of bytes to write.
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void ILI9325<TOrientation,TColourDepth,TAccessMode>::rawSramTransfer(uint8_t *data,uint32_t numBytes) const {
-
-		uint32_t numPixels;
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9325<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::rawSramTransfer(uint8_t *data,uint32_t numBytes) const {
 
-		numPixels=numBytes/2;
+		// the access modes take a 16-bit byte count
 
-		while(numPixels--) {
-			TAccessMode::writeData(data[0],data[1]);
-			data+=2;
+		while(numBytes>0xfffe) {
+			TAccessMode::writeDataBlock(data,0xfffe);
+			data+=0xfffe;
+			numBytes-=0xfffe;
 		}
+
+		TAccessMode::writeDataBlock(data,numBytes);
 	}
 }
@@ -49,13 +49,14 @@ namespace lcd {
 			typedef uint32_t TColour;
 
 			struct UnpackedColour {
-				uint8_t first,second;
+				uint8_t lo8,hi8;
 			};
 
 		public:
 			void unpackColour(TColour src,UnpackedColour& dest) const;
 			void unpackColour(uint8_t red,uint8_t green,uint8_t blue,UnpackedColour& dest) const;
 			void writePixel(const UnpackedColour& cr) const;
+			void writePixels(const UnpackedColour *pixels,uint16_t numPixels) const;
 			void writePixelAgain(const UnpackedColour& cr) const;
 			void fillPixels(uint32_t numPixels,const UnpackedColour& cr) const;
 			void allocatePixelBuffer(uint32_t numPixels,uint8_t*& buffer,uint32_t& bytesPerPixel) const;
@@ -96,8 +97,8 @@ namespace lcd {
 		g&=0xfc;
 		b&=0xf8;
 
-		dest.first=r | (g >> 5);
-		dest.second=(g << 3) | (b >> 3);
+		dest.hi8=r | (g >> 5);
+		dest.lo8=(g << 3) | (b >> 3);
 	}
 
 
@@ -115,8 +116,8 @@ namespace lcd {
 		green&=0xfc;
 		blue&=0xf8;
 
-		dest.first=red | (green >> 5);
-		dest.second=(green << 3) | (blue >> 3);
+		dest.hi8=red | (green >> 5);
+		dest.lo8=(green << 3) | (blue >> 3);
 	}
 
 
@@ -128,7 +129,31 @@ namespace lcd {
 
 	template<class TAccessMode>
 	inline void ILI9325Colour<COLOURS_16BIT,TAccessMode>::writePixel(const UnpackedColour& cr) const {
-		TAccessMode::writeData(cr.second,cr.first);
+		TAccessMode::writeData(cr.lo8,cr.hi8);
+	}
+
+
+	/**
+	 * Write a block of pixels from SRAM to the current output position. The unpacked colours are laid
+	 * out in memory in the order that they go out on the bus so the block is handed to the access mode
+	 * in as few calls as its 16-bit byte count allows. Assumes that the caller has already issued the
+	 * beginWriting() command.
+	 * @param pixels The pixels to write
+	 * @param numPixels The number of pixels.
+	 */
+
+	template<class TAccessMode>
+	inline void ILI9325Colour<COLOURS_16BIT,TAccessMode>::writePixels(const UnpackedColour *pixels,uint16_t numPixels) const {
+
+		// the access modes take a 16-bit byte count
+
+		while(numPixels>0x7fff) {
+			TAccessMode::writeDataBlock(reinterpret_cast<const uint8_t *>(pixels),0x7fff*2);
+			pixels+=0x7fff;
+			numPixels-=0x7fff;
+		}
+
+		TAccessMode::writeDataBlock(reinterpret_cast<const uint8_t *>(pixels),numPixels*2);
 	}
 
 
@@ -141,7 +166,7 @@ namespace lcd {
 
 	template<class TAccessMode>
 	inline void ILI9325Colour<COLOURS_16BIT,TAccessMode>::writePixelAgain(const UnpackedColour& cr) const {
-		TAccessMode::writeDataAgain(cr.second,cr.first);
+		TAccessMode::writeDataAgain(cr.lo8,cr.hi8);
 	}
 
 
@@ -157,8 +182,8 @@ namespace lcd {
 
 		uint8_t lo8,hi8;
 
-		lo8=cr.second;
-		hi8=cr.first;
+		lo8=cr.lo8;
+		hi8=cr.hi8;
 
 		TAccessMode::writeCommand(ili9325::ILI932X_RW_GRAM);
 		TAccessMode::writeMultiData(numPixels,lo8,hi8);
@@ -57,6 +57,7 @@ namespace lcd {
 			void unpackColour(TColour src,UnpackedColour& dest) const;
 			void unpackColour(uint8_t red,uint8_t green,uint8_t blue,UnpackedColour& dest) const;
 			void writePixel(const UnpackedColour& cr) const;
+			void writePixels(const UnpackedColour *pixels,uint16_t numPixels) const;
 			void writePixelAgain(const UnpackedColour& cr) const;
 			void fillPixels(uint32_t numPixels,const UnpackedColour& cr) const;
 			void allocatePixelBuffer(uint32_t numPixels,uint8_t*& buffer,uint32_t& bytesPerPixel) const;
@@ -125,6 +126,22 @@ namespace lcd {
 	}
 
 
+	/**
+	 * Write a block of pixels from SRAM to the current output position. Each byte of an 18-bit pixel
+	 * is a bus transfer of its own so the block path in the access mode, which pairs up bytes into
+	 * 16-bit transfers, cannot be used. Assumes that the caller has already issued the beginWriting() command.
+	 * @param pixels The pixels to write
+	 * @param numPixels The number of pixels
+	 */
+
+	template<class TAccessMode>
+	inline void ILI9325Colour<COLOURS_18BIT,TAccessMode>::writePixels(const UnpackedColour *pixels,uint16_t numPixels) const {
+
+		while(numPixels--)
+			writePixel(*pixels++);
+	}
+
+
 	/**
 	 * Write the same colour pixel that we last wrote. This gives the access mode a chance to
 	 * optimise sequential pixel writes. The colour is provided for drivers that cannot optimise
@@ -150,16 +167,7 @@ namespace lcd {
 	template<class TAccessMode>
 	inline void ILI9325Colour<COLOURS_18BIT,TAccessMode>::fillPixels(uint32_t numPixels,const UnpackedColour& cr) const {
 		TAccessMode::writeCommand(ili9325::ILI932X_RW_GRAM);
-
-		uint8_t first=cr.first;
-		uint8_t second=cr.second;
-		uint8_t third=cr.third;
-
-		while(numPixels--) {
-			TAccessMode::writeData(first);
-			TAccessMode::writeData(second);
-			TAccessMode::writeData(third);
-		}
+		TAccessMode::writeMultiData(numPixels,cr.first,cr.second,cr.third);
 	}
 
 
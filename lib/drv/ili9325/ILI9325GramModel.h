@@ -0,0 +1,424 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file ILI9325GramModel.h
+ * @brief A model of the ILI9325 register interface and GRAM for use with the HostAccessMode.
+ * @ingroup ILI9325
+ */
+
+#pragma once
+
+#if !defined(__AVR__)
+
+#include "commands/AllCommands.h"
+
+
+namespace lcd {
+
+	/**
+	 * @brief Desktop host model of the ILI9325 GRAM.
+	 *
+	 * Decodes the register writes that the driver issues over a 16-bit bus. The window registers
+	 * (0x50..0x53), the GRAM address counter (0x20, 0x21) and the entry mode (0x03) are modelled
+	 * so that writes to the GRAM register (0x22) land where the real controller would put them,
+	 * including the address counter wrapping at the window edges in the direction selected by the
+	 * AM and I/D entry mode bits. Note that, as on the real device, issuing 0x22 does not reset the
+	 * address counter.
+	 *
+	 * GRAM cells hold the raw pixel value: a 5-6-5 word when the bus is transferring 16-bit pixels or
+	 * the three transfers packed into the low 24 bits, first transfer uppermost, when the TRI bit
+	 * selects 3-transfer 18-bit mode.
+	 *
+	 * @ingroup ILI9325
+	 */
+
+	class ILI9325GramModel {
+
+		public:
+			enum {
+				GRAM_WIDTH=240,			///< horizontal (H) GRAM addresses
+				GRAM_HEIGHT=320,		///< vertical (V) GRAM addresses
+				BUS_BYTES=2			///< 16-bit bus
+			};
+
+		protected:
+			uint16_t _registers[256];
+			uint8_t _index;
+			uint16_t _h,_v;
+			uint8_t _lastLo8,_lastHi8;
+			uint8_t _streamByte;
+			uint8_t _streamIndex;
+			uint8_t _tripleBytes[3];
+			uint8_t _tripleIndex;
+			uint32_t _gram[GRAM_WIDTH*GRAM_HEIGHT];
+
+		protected:
+			void writeRegister(uint16_t value);
+			void writeGram(uint8_t lo8,uint8_t hi8);
+			void storePixel(uint32_t value);
+			void advanceHorizontal();
+			void advanceVertical();
+			bool isTripleTransfer() const;
+
+		public:
+			ILI9325GramModel();
+
+			void reset();
+			void command(uint8_t lo8,uint8_t hi8);
+			void data(uint8_t lo8,uint8_t hi8);
+			void dataAgain();
+			void multiData(uint32_t howMuch,const uint8_t *pattern,uint8_t patternSize);
+			void dataBlock(const uint8_t *data,uint16_t numBytes);
+			void streamedData(uint8_t data);
+
+			uint16_t getRegister(uint8_t index) const;
+			uint16_t getAddressH() const;
+			uint16_t getAddressV() const;
+			uint32_t getGramPixel(uint16_t h,uint16_t v) const;
+			uint32_t getPixel(int16_t x,int16_t y) const;
+	};
+
+
+	/**
+	 * Constructor, power-on state
+	 */
+
+	inline ILI9325GramModel::ILI9325GramModel() {
+		reset();
+	}
+
+
+	/**
+	 * Reset the registers to their power-on defaults and clear GRAM to zero
+	 */
+
+	inline void ILI9325GramModel::reset() {
+
+		memset(_registers,0,sizeof(_registers));
+		memset(_gram,0,sizeof(_gram));
+
+		_registers[ili9325::ILI932X_ENTRY_MOD]=0x0030;
+		_registers[ili9325::ILI932X_HOR_END_AD]=GRAM_WIDTH-1;
+		_registers[ili9325::ILI932X_VER_END_AD]=GRAM_HEIGHT-1;
+
+		_index=0;
+		_h=_v=0;
+		_lastLo8=_lastHi8=0;
+		_streamIndex=0;
+		_tripleIndex=0;
+	}
+
+
+	/**
+	 * Write to the index register
+	 * @param lo8 The register index
+	 * @param hi8 Ignored, all ILI9325 registers are below 0x100
+	 */
+
+	inline void ILI9325GramModel::command(uint8_t lo8,uint8_t /* hi8 */) {
+
+		_index=lo8;
+		_tripleIndex=0;
+	}
+
+
+	/**
+	 * Write to the register selected by the index
+	 * @param lo8 The low 8 bits of the transfer
+	 * @param hi8 The high 8 bits of the transfer
+	 */
+
+	inline void ILI9325GramModel::data(uint8_t lo8,uint8_t hi8) {
+
+		_lastLo8=lo8;
+		_lastHi8=hi8;
+
+		if(_index==ili9325::ILI932X_RW_GRAM)
+			writeGram(lo8,hi8);
+		else
+			writeRegister(static_cast<uint16_t>(hi8) << 8 | lo8);
+	}
+
+
+	/**
+	 * Repeat the last transfer
+	 */
+
+	inline void ILI9325GramModel::dataAgain() {
+		data(_lastLo8,_lastHi8);
+	}
+
+
+	/**
+	 * Repeat a pattern of transfers many times.
+	 * @param howMuch The number of times to repeat the pattern.
+	 * @param pattern The transfers. A 2 byte pattern is a single 16-bit transfer. Otherwise each
+	 * byte is a transfer with zero in the upper 8 bits, e.g. an 18-bit pixel in 3-transfer mode.
+	 * @param patternSize 1, 2 or 3.
+	 */
+
+	inline void ILI9325GramModel::multiData(uint32_t howMuch,const uint8_t *pattern,uint8_t patternSize) {
+
+		uint8_t i;
+
+		while(howMuch--) {
+			if(patternSize==2)
+				data(pattern[0],pattern[1]);
+			else
+				for(i=0;i<patternSize;i++)
+					data(pattern[i],0);
+		}
+	}
+
+
+	/**
+	 * Write a block of transfers.
+	 * @param data The (lo8,hi8) pairs.
+	 * @param numBytes The number of bytes in the block.
+	 */
+
+	inline void ILI9325GramModel::dataBlock(const uint8_t *data,uint16_t numBytes) {
+
+		for(numBytes/=2;numBytes;numBytes--) {
+			this->data(data[0],data[1]);
+			data+=2;
+		}
+	}
+
+
+	/**
+	 * Streamed data is buffered into complete 16-bit (lo8,hi8) transfers, as the 16-bit access modes
+	 * do, whatever the pixel format. In 3-transfer 18-bit mode the controller then takes lo8 of each transfer.
+	 * @param data The next byte in the stream.
+	 */
+
+	inline void ILI9325GramModel::streamedData(uint8_t data) {
+
+		if(_streamIndex==0) {
+			_streamByte=data;
+			_streamIndex=1;
+		}
+		else {
+			this->data(_streamByte,data);
+			_streamIndex=0;
+		}
+	}
+
+
+	/**
+	 * Get the content of a register
+	 * @param index The register index
+	 * @return The last value written
+	 */
+
+	inline uint16_t ILI9325GramModel::getRegister(uint8_t index) const {
+		return _registers[index];
+	}
+
+
+	/**
+	 * Get the current horizontal address counter
+	 * @return The H address
+	 */
+
+	inline uint16_t ILI9325GramModel::getAddressH() const {
+		return _h;
+	}
+
+
+	/**
+	 * Get the current vertical address counter
+	 * @return The V address
+	 */
+
+	inline uint16_t ILI9325GramModel::getAddressV() const {
+		return _v;
+	}
+
+
+	/**
+	 * Get a pixel using raw GRAM addressing
+	 * @param h The horizontal address (0..239)
+	 * @param v The vertical address (0..319)
+	 * @return The pixel value
+	 */
+
+	inline uint32_t ILI9325GramModel::getGramPixel(uint16_t h,uint16_t v) const {
+		return _gram[static_cast<uint32_t>(v)*GRAM_WIDTH+h];
+	}
+
+
+	/**
+	 * Get a pixel using the panel co-ordinates of the orientation selected by the driver. The
+	 * driver selects landscape by setting the AM bit in the entry mode register and then maps
+	 * panel (x,y) to GRAM (y,319-x).
+	 * @param x The panel x co-ordinate
+	 * @param y The panel y co-ordinate
+	 * @return The pixel value
+	 */
+
+	inline uint32_t ILI9325GramModel::getPixel(int16_t x,int16_t y) const {
+
+		if(_registers[ili9325::ILI932X_ENTRY_MOD] & 0x0008)
+			return getGramPixel(y,GRAM_HEIGHT-1-x);
+		else
+			return getGramPixel(x,y);
+	}
+
+
+	/**
+	 * Write a register other than GRAM. The address counter registers set the counter.
+	 * @param value The 16-bit value
+	 */
+
+	inline void ILI9325GramModel::writeRegister(uint16_t value) {
+
+		_registers[_index]=value;
+
+		if(_index==ili9325::ILI932X_GRAM_HOR_AD)
+			_h=value % GRAM_WIDTH;
+		else if(_index==ili9325::ILI932X_GRAM_VER_AD)
+			_v=value % GRAM_HEIGHT;
+	}
+
+
+	/**
+	 * Write a transfer to GRAM. In 3-transfer mode the pixel is stored when the third byte arrives.
+	 * @param lo8 The low 8 bits of the transfer
+	 * @param hi8 The high 8 bits of the transfer
+	 */
+
+	inline void ILI9325GramModel::writeGram(uint8_t lo8,uint8_t hi8) {
+
+		if(isTripleTransfer()) {
+
+			_tripleBytes[_tripleIndex++]=lo8;
+
+			if(_tripleIndex==3) {
+				storePixel(static_cast<uint32_t>(_tripleBytes[0]) << 16 | static_cast<uint32_t>(_tripleBytes[1]) << 8 | _tripleBytes[2]);
+				_tripleIndex=0;
+			}
+		}
+		else
+			storePixel(static_cast<uint16_t>(hi8) << 8 | lo8);
+	}
+
+
+	/**
+	 * Store a pixel at the address counter and advance the counter within the window
+	 * @param value The pixel value
+	 */
+
+	inline void ILI9325GramModel::storePixel(uint32_t value) {
+
+		_gram[static_cast<uint32_t>(_v)*GRAM_WIDTH+_h]=value;
+
+		if(_registers[ili9325::ILI932X_ENTRY_MOD] & 0x0008)
+			advanceVertical();
+		else
+			advanceHorizontal();
+	}
+
+
+	/**
+	 * AM=0: advance H, wrapping into the next V line at the window edge
+	 */
+
+	inline void ILI9325GramModel::advanceHorizontal() {
+
+		uint16_t entryMode,hs,he,vs,ve;
+
+		entryMode=_registers[ili9325::ILI932X_ENTRY_MOD];
+		hs=_registers[ili9325::ILI932X_HOR_START_AD];
+		he=_registers[ili9325::ILI932X_HOR_END_AD];
+		vs=_registers[ili9325::ILI932X_VER_START_AD];
+		ve=_registers[ili9325::ILI932X_VER_END_AD];
+
+		if(entryMode & 0x0010) {
+			if(_h<he) {
+				_h++;
+				return;
+			}
+			_h=hs;
+		}
+		else {
+			if(_h>hs) {
+				_h--;
+				return;
+			}
+			_h=he;
+		}
+
+		if(entryMode & 0x0020)
+			_v=_v<ve ? _v+1 : vs;
+		else
+			_v=_v>vs ? _v-1 : ve;
+	}
+
+
+	/**
+	 * AM=1: advance V, wrapping into the next H line at the window edge
+	 */
+
+	inline void ILI9325GramModel::advanceVertical() {
+
+		uint16_t entryMode,hs,he,vs,ve;
+
+		entryMode=_registers[ili9325::ILI932X_ENTRY_MOD];
+		hs=_registers[ili9325::ILI932X_HOR_START_AD];
+		he=_registers[ili9325::ILI932X_HOR_END_AD];
+		vs=_registers[ili9325::ILI932X_VER_START_AD];
+		ve=_registers[ili9325::ILI932X_VER_END_AD];
+
+		if(entryMode & 0x0020) {
+			if(_v<ve) {
+				_v++;
+				return;
+			}
+			_v=vs;
+		}
+		else {
+			if(_v>vs) {
+				_v--;
+				return;
+			}
+			_v=ve;
+		}
+
+		if(entryMode & 0x0010)
+			_h=_h<he ? _h+1 : hs;
+		else
+			_h=_h>hs ? _h-1 : he;
+	}
+
+
+	/**
+	 * Check for the TRI bit in the entry mode register
+	 * @return true if pixels are transferred as 3 bytes
+	 */
+
+	inline bool ILI9325GramModel::isTripleTransfer() const {
+		return (_registers[ili9325::ILI932X_ENTRY_MOD] & 0x8000)!=0;
+	}
+}
+
+#endif
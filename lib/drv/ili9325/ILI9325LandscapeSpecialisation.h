@@ -37,11 +37,12 @@ namespace lcd {
 	/**
 	 * Specialisation of ILI9325Orientation for the panel in LANDSCAPE mode.
 	 * @tparam TAccessMode the access mode implementation, e.g. Gpio16LatchAccessMode
+	 * @tparam TWindowShadowing Whether to shadow the window registers
 	 * @ingroup ILI9325
 	 */
 
-	template<class TAccessMode>
-	class ILI9325Orientation<LANDSCAPE,TAccessMode> {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	class ILI9325Orientation<LANDSCAPE,TAccessMode,TWindowShadowing> : public ILI9325WindowRegisters<TAccessMode,TWindowShadowing> {
 
 		protected:
 			uint16_t getMemoryAccessControl() const;
@@ -62,8 +63,8 @@ namespace lcd {
 	 * @return The entry mode register setting for portrait
 	 */
 
-	template<class TAccessMode>
-	inline uint16_t ILI9325Orientation<LANDSCAPE,TAccessMode>::getMemoryAccessControl() const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline uint16_t ILI9325Orientation<LANDSCAPE,TAccessMode,TWindowShadowing>::getMemoryAccessControl() const {
 		return 0x0018;
 	}
 
@@ -73,8 +74,8 @@ namespace lcd {
 	 * @return 320px
 	 */
 
-	template<class TAccessMode>
-	inline int16_t ILI9325Orientation<LANDSCAPE,TAccessMode>::getWidth() const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline int16_t ILI9325Orientation<LANDSCAPE,TAccessMode,TWindowShadowing>::getWidth() const {
 		return 320;
 	}
 
@@ -84,8 +85,8 @@ namespace lcd {
 	 * @return 240px
 	 */
 
-	template<class TAccessMode>
-	inline int16_t ILI9325Orientation<LANDSCAPE,TAccessMode>::getHeight() const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline int16_t ILI9325Orientation<LANDSCAPE,TAccessMode,TWindowShadowing>::getHeight() const {
 		return 240;
 	}
 
@@ -95,8 +96,8 @@ namespace lcd {
 	 * @param rc The display output rectangle
 	 */
 
-	template<class TAccessMode>
-	inline void ILI9325Orientation<LANDSCAPE,TAccessMode>::moveTo(const Rectangle& rc) const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9325Orientation<LANDSCAPE,TAccessMode,TWindowShadowing>::moveTo(const Rectangle& rc) const {
 		moveTo(rc.X,rc.Y,rc.X+rc.Width-1,rc.Y+rc.Height-1);
 	}
 
@@ -109,19 +110,19 @@ namespace lcd {
 	 * @param yend ending Y position
 	 */
 
-	template<class TAccessMode>
-	inline void ILI9325Orientation<LANDSCAPE,TAccessMode>::moveTo(int16_t xstart,int16_t ystart,int16_t xend,int16_t yend) const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9325Orientation<LANDSCAPE,TAccessMode,TWindowShadowing>::moveTo(int16_t xstart,int16_t ystart,int16_t xend,int16_t yend) const {
 
 		int16_t start,end;
 
-		TAccessMode::writeCommandData(ili9325::ILI932X_HOR_START_AD,ystart,ystart >> 8);
-		TAccessMode::writeCommandData(ili9325::ILI932X_HOR_END_AD,yend,yend >> 8);
+		this->writeWindowRegister(ili9325::ILI932X_HOR_START_AD,ystart);
+		this->writeWindowRegister(ili9325::ILI932X_HOR_END_AD,yend);
 
 		start=319-xend;
-		TAccessMode::writeCommandData(ili9325::ILI932X_VER_START_AD,start,start >> 8);
+		this->writeWindowRegister(ili9325::ILI932X_VER_START_AD,start);
 
 		end=319-xstart;
-		TAccessMode::writeCommandData(ili9325::ILI932X_VER_END_AD,end,end >> 8);
+		this->writeWindowRegister(ili9325::ILI932X_VER_END_AD,end);
 		TAccessMode::writeCommandData(ili9325::ILI932X_GRAM_VER_AD,end,end >> 8);
 
 		TAccessMode::writeCommandData(ili9325::ILI932X_GRAM_HOR_AD,ystart,ystart >> 8);
@@ -134,17 +135,17 @@ namespace lcd {
 	 * @param xend The new X end position
 	 */
 
-	template<class TAccessMode>
-	inline void ILI9325Orientation<LANDSCAPE,TAccessMode>::moveX(int16_t xstart,int16_t xend) const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9325Orientation<LANDSCAPE,TAccessMode,TWindowShadowing>::moveX(int16_t xstart,int16_t xend) const {
 
 		int16_t start,end;
 
 		start=319-xend;
 		end=319-xstart;
 
-		TAccessMode::writeCommandData(ili9325::ILI932X_VER_START_AD,start,start >> 8);
+		this->writeWindowRegister(ili9325::ILI932X_VER_START_AD,start);
 
-		TAccessMode::writeCommandData(ili9325::ILI932X_VER_END_AD,end,end >> 8);
+		this->writeWindowRegister(ili9325::ILI932X_VER_END_AD,end);
 		TAccessMode::writeCommandData(ili9325::ILI932X_GRAM_VER_AD,end,end >> 8);
 	}
 
@@ -154,12 +155,12 @@ namespace lcd {
 	 * @param ystart The new Y start position
 	 */
 
-	template<class TAccessMode>
-	inline void ILI9325Orientation<LANDSCAPE,TAccessMode>::moveY(int16_t ystart,int16_t yend) const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9325Orientation<LANDSCAPE,TAccessMode,TWindowShadowing>::moveY(int16_t ystart,int16_t yend) const {
 
-		TAccessMode::writeCommandData(ili9325::ILI932X_HOR_START_AD,ystart,ystart >> 8);
+		this->writeWindowRegister(ili9325::ILI932X_HOR_START_AD,ystart);
 		TAccessMode::writeCommandData(ili9325::ILI932X_GRAM_HOR_AD,ystart,ystart >> 8);
-		TAccessMode::writeCommandData(ili9325::ILI932X_HOR_END_AD,yend,yend >> 8);
+		this->writeWindowRegister(ili9325::ILI932X_HOR_END_AD,yend);
 	}
 
 
@@ -168,8 +169,8 @@ namespace lcd {
 	 * @param scrollPosition The new scroll position
 	 */
 
-	template<class TAccessMode>
-	inline void ILI9325Orientation<LANDSCAPE,TAccessMode>::setScrollPosition(int16_t scrollPosition) {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9325Orientation<LANDSCAPE,TAccessMode,TWindowShadowing>::setScrollPosition(int16_t scrollPosition) {
 
 		if(scrollPosition < 0)
 			scrollPosition+=320;
@@ -41,9 +41,36 @@ namespace lcd {
 	 * @ingroup ILI9325
 	 */
 
-	template<Orientation TOrientation,class TAccessMode>
+	template<Orientation TOrientation,class TAccessMode,WindowShadowing TWindowShadowing>
 	class ILI9325Orientation {
 	};
+
+
+	/**
+	 * @brief Window register writer shared by the orientation specialisations.
+	 *
+	 * The four window registers (0x50..0x53) can be shadowed. The GRAM address counter registers
+	 * are always written because the counter moves as pixels are written.
+	 * @ingroup ILI9325
+	 */
+
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	class ILI9325WindowRegisters : public RegisterShadow<TWindowShadowing,4> {
+
+		protected:
+
+			/**
+			 * Write one of the window start/end registers if it doesn't already hold the value
+			 * @param reg The register, ILI932X_HOR_START_AD..ILI932X_VER_END_AD
+			 * @param value The new value
+			 */
+
+			void writeWindowRegister(uint8_t reg,uint16_t value) const {
+
+				if(this->updateShadow(reg-ili9325::ILI932X_HOR_START_AD,value))
+					TAccessMode::writeCommandData(reg,value,value >> 8);
+			}
+	};
 }
 
 /*
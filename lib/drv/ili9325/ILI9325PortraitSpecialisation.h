@@ -37,11 +37,12 @@ namespace lcd {
 /**
  * @brief Specialisation of ILI9325Orientation for the panel in PORTRAIT mode.
  * @tparam TAccessMode the access mode implementation, eg Gpio16LatchAccessMode
+ * @tparam TWindowShadowing Whether to shadow the window registers
  * @ingroup ILI9325
  */
 
-	template<class TAccessMode>
-	class ILI9325Orientation<PORTRAIT,TAccessMode> {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	class ILI9325Orientation<PORTRAIT,TAccessMode,TWindowShadowing> : public ILI9325WindowRegisters<TAccessMode,TWindowShadowing> {
 
 		protected:
 			uint16_t getMemoryAccessControl() const;
@@ -62,8 +63,8 @@ namespace lcd {
 	 * @return The entry mode register setting for portrait
 	 */
 
-	template<class TAccessMode>
-	inline uint16_t ILI9325Orientation<PORTRAIT,TAccessMode>::getMemoryAccessControl() const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline uint16_t ILI9325Orientation<PORTRAIT,TAccessMode,TWindowShadowing>::getMemoryAccessControl() const {
 		return 0x0030;
 	}
 
@@ -73,8 +74,8 @@ namespace lcd {
 	 * @return 240px
 	 */
 
-	template<class TAccessMode>
-	inline int16_t ILI9325Orientation<PORTRAIT,TAccessMode>::getWidth() const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline int16_t ILI9325Orientation<PORTRAIT,TAccessMode,TWindowShadowing>::getWidth() const {
 		return 240;
 	}
 
@@ -84,8 +85,8 @@ namespace lcd {
 	 * @return 320px
 	 */
 
-	template<class TAccessMode>
-	inline int16_t ILI9325Orientation<PORTRAIT,TAccessMode>::getHeight() const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline int16_t ILI9325Orientation<PORTRAIT,TAccessMode,TWindowShadowing>::getHeight() const {
 		return 320;
 	}
 
@@ -95,8 +96,8 @@ namespace lcd {
 	 * @param rc The display output rectangle
 	 */
 
-	template<class TAccessMode>
-	inline void ILI9325Orientation<PORTRAIT,TAccessMode>::moveTo(const Rectangle& rc) const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9325Orientation<PORTRAIT,TAccessMode,TWindowShadowing>::moveTo(const Rectangle& rc) const {
 		moveTo(rc.X,rc.Y,rc.X+rc.Width-1,rc.Y+rc.Height-1);
 	}
 
@@ -109,14 +110,14 @@ namespace lcd {
 	 * @param yend ending Y position
 	 */
 
-	template<class TAccessMode>
-	inline void ILI9325Orientation<PORTRAIT,TAccessMode>::moveTo(int16_t xstart,int16_t ystart,int16_t xend,int16_t yend) const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9325Orientation<PORTRAIT,TAccessMode,TWindowShadowing>::moveTo(int16_t xstart,int16_t ystart,int16_t xend,int16_t yend) const {
 
-		TAccessMode::writeCommandData(ili9325::ILI932X_HOR_START_AD,xstart,xstart >> 8);
-		TAccessMode::writeCommandData(ili9325::ILI932X_HOR_END_AD,xend,xend >> 8);
+		this->writeWindowRegister(ili9325::ILI932X_HOR_START_AD,xstart);
+		this->writeWindowRegister(ili9325::ILI932X_HOR_END_AD,xend);
 
-		TAccessMode::writeCommandData(ili9325::ILI932X_VER_START_AD,ystart,ystart >> 8);
-		TAccessMode::writeCommandData(ili9325::ILI932X_VER_END_AD,yend,yend >> 8);
+		this->writeWindowRegister(ili9325::ILI932X_VER_START_AD,ystart);
+		this->writeWindowRegister(ili9325::ILI932X_VER_END_AD,yend);
 
 		TAccessMode::writeCommandData(ili9325::ILI932X_GRAM_HOR_AD,xstart,xstart >> 8);
 		TAccessMode::writeCommandData(ili9325::ILI932X_GRAM_VER_AD,ystart,ystart >> 8);
@@ -129,11 +130,11 @@ namespace lcd {
 	 * @param xend The new X end position
 	 */
 
-	template<class TAccessMode>
-	inline void ILI9325Orientation<PORTRAIT,TAccessMode>::moveX(int16_t xstart,int16_t xend) const {
-		TAccessMode::writeCommandData(ili9325::ILI932X_HOR_START_AD,xstart,xstart >> 8);
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9325Orientation<PORTRAIT,TAccessMode,TWindowShadowing>::moveX(int16_t xstart,int16_t xend) const {
+		this->writeWindowRegister(ili9325::ILI932X_HOR_START_AD,xstart);
 		TAccessMode::writeCommandData(ili9325::ILI932X_GRAM_HOR_AD,xstart,xstart >> 8);
-		TAccessMode::writeCommandData(ili9325::ILI932X_HOR_END_AD,xend,xend >> 8);
+		this->writeWindowRegister(ili9325::ILI932X_HOR_END_AD,xend);
 	}
 
 
@@ -142,11 +143,11 @@ namespace lcd {
 	 * @param ystart The new Y start position
 	 */
 
-	template<class TAccessMode>
-	inline void ILI9325Orientation<PORTRAIT,TAccessMode>::moveY(int16_t ystart,int16_t yend) const {
-		TAccessMode::writeCommandData(ili9325::ILI932X_VER_START_AD,ystart,ystart >> 8);
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9325Orientation<PORTRAIT,TAccessMode,TWindowShadowing>::moveY(int16_t ystart,int16_t yend) const {
+		this->writeWindowRegister(ili9325::ILI932X_VER_START_AD,ystart);
 		TAccessMode::writeCommandData(ili9325::ILI932X_GRAM_VER_AD,ystart,ystart >> 8);
-		TAccessMode::writeCommandData(ili9325::ILI932X_VER_END_AD,yend,yend >> 8);
+		this->writeWindowRegister(ili9325::ILI932X_VER_END_AD,yend);
 	}
 
 
@@ -155,8 +156,8 @@ namespace lcd {
 	 * @param scrollPosition The new scroll position
 	 */
 
-	template<class TAccessMode>
-	inline void ILI9325Orientation<PORTRAIT,TAccessMode>::setScrollPosition(int16_t scrollPosition) {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9325Orientation<PORTRAIT,TAccessMode,TWindowShadowing>::setScrollPosition(int16_t scrollPosition) {
 
 		if(scrollPosition<0)
 			scrollPosition+=320;
@@ -32,7 +32,7 @@
 
 #pragma once
 
-#include "commands/Allcommands.h"
+#include "commands/AllCommands.h"
 #include "ILI9327Colour.h"
 #include "ILI9327Orientation.h"
 
@@ -261,25 +261,7 @@ namespace lcd {
 
 	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,class TPanelTraits>
 	inline void ILI9327<TOrientation,TColourDepth,TAccessMode,TPanelTraits>::rawFlashTransfer(uint32_t data,uint32_t numBytes) const {
-
-		uint32_t numPixels;
-
-		numPixels=numBytes/2;
-
-		// handle data in the lower and upper segments with possible overlap
-		// a single 16-bit pixel should not overlap the segments
-
-		while(data<65536 && numPixels>0) {
-			TAccessMode::writeData(pgm_read_byte_near(data),pgm_read_byte_near(data+1));
-			data+=2;
-			numPixels--;
-		}
-
-		while(numPixels>0) {
-			TAccessMode::writeData(pgm_read_byte_far(data),pgm_read_byte_far(data+1));
-			data+=2;
-			numPixels--;
-		}
+		TAccessMode::writeFlashDataBlock(data,numBytes);
 	}
 
 
@@ -292,13 +274,14 @@ namespace lcd {
 	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,class TPanelTraits>
 	inline void ILI9327<TOrientation,TColourDepth,TAccessMode,TPanelTraits>::rawSramTransfer(uint8_t *data,uint32_t numBytes) const {
 
-		uint32_t numPixels;
+		// the access modes take a 16-bit byte count
 
-		numPixels=numBytes/2;
-
-		while(numPixels--) {
-			TAccessMode::writeData(data[0],data[1]);
-			data+=2;
+		while(numBytes>0xfffe) {
+			TAccessMode::writeDataBlock(data,0xfffe);
+			data+=0xfffe;
+			numBytes-=0xfffe;
 		}
+
+		TAccessMode::writeDataBlock(data,numBytes);
 	}
 }
@@ -53,6 +53,7 @@ namespace lcd {
 			void unpackColour(uint8_t red,uint8_t green,uint8_t blue,UnpackedColour& dest) const;
 
 			void writePixel(const UnpackedColour& cr) const;
+			void writePixels(const UnpackedColour *pixels,uint16_t numPixels) const;
 			void writePixelAgain(const UnpackedColour& cr) const;
 			void fillPixels(uint32_t numPixels,const UnpackedColour& cr) const;
 
@@ -134,6 +135,30 @@ namespace lcd {
 	}
 
 
+	/**
+	 * Write a block of pixels from SRAM to the current output position. The unpacked colours are laid
+	 * out in memory in the order that they go out on the bus so the block is handed to the access mode
+	 * in as few calls as its 16-bit byte count allows. Assumes that the caller has already issued the
+	 * beginWriting() command.
+	 * @param pixels The pixels to write
+	 * @param numPixels The number of pixels.
+	 */
+
+	template<class TAccessMode>
+	inline void ILI9327Colour<COLOURS_16BIT,TAccessMode>::writePixels(const UnpackedColour *pixels,uint16_t numPixels) const {
+
+		// the access modes take a 16-bit byte count
+
+		while(numPixels>0x7fff) {
+			TAccessMode::writeDataBlock(reinterpret_cast<const uint8_t *>(pixels),0x7fff*2);
+			pixels+=0x7fff;
+			numPixels-=0x7fff;
+		}
+
+		TAccessMode::writeDataBlock(reinterpret_cast<const uint8_t *>(pixels),numPixels*2);
+	}
+
+
 	/**
 	 * Write the same colour pixel that we last wrote. This gives the access mode a chance to
 	 * optimise sequential pixel writes. The colour is provided for drivers that cannot optimise
@@ -32,7 +32,8 @@
 
 #pragma once
 
-#include "commands/Allcommands.h"
+#include "commands/AllCommands.h"
+#include "drv/RegisterShadow.h"
 #include "ILI9481Colour.h"
 #include "ILI9481Orientation.h"
 #include "ILI9481Gamma.h"
@@ -47,11 +48,12 @@ namespace lcd {
 	 * @tparam TOrientation The desired panel orientation, LANDSCAPE or PORTRAIT
 	 * @tparam TColourDepth The colour depth for your use, just 64K is supported for this panel.
 	 * @tparam TAccessMode The access mode that you want to talk to this panel with, e.g. Gpio16LatchAccessMode.
+	 * @tparam TWindowShadowing WINDOW_SHADOW_ON to skip writing window registers that already hold the required value.
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing=WINDOW_SHADOW_OFF>
 	class ILI9481 : public ILI9481Colour<TColourDepth,TAccessMode>,
-									public ILI9481Orientation<TOrientation,TAccessMode> {
+									public ILI9481Orientation<TOrientation,TAccessMode,TWindowShadowing> {
 
 		public:
 			enum {
@@ -79,8 +81,8 @@ namespace lcd {
 	 * Constructor
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline ILI9481<TOrientation,TColourDepth,TAccessMode>::ILI9481() {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline ILI9481<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::ILI9481() {
 		initialise();
 	}
 
@@ -89,8 +91,12 @@ namespace lcd {
 	 * Initialise the LCD. Do the reset sequence.
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void ILI9481<TOrientation,TColourDepth,TAccessMode>::initialise() const {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9481<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::initialise() const {
+
+		// the reset will put the window registers back to their defaults
+
+		this->invalidateShadow();
 
 		// initialise the access mode
 
@@ -189,8 +195,8 @@ namespace lcd {
 	 * Send the panel to sleep
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void ILI9481<TOrientation,TColourDepth,TAccessMode>::sleep() const {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9481<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::sleep() const {
 
 		// go to sleep and wait at least 5ms
 
@@ -203,8 +209,10 @@ namespace lcd {
 	 * Wake the panel up
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void ILI9481<TOrientation,TColourDepth,TAccessMode>::wake() const {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9481<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::wake() const {
+
+		this->invalidateShadow();
 
 		// wake up and wait at least 120ms
 
@@ -217,8 +225,8 @@ namespace lcd {
 	 * Issue the command that allows graphics ram writing to commence
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void ILI9481<TOrientation,TColourDepth,TAccessMode>::beginWriting() const {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9481<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::beginWriting() const {
 		TAccessMode::writeCommand(ili9481::WRITE_MEMORY_START);
 	}
 
@@ -229,8 +237,8 @@ namespace lcd {
 	 * @param height The height of the region
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void ILI9481<TOrientation,TColourDepth,TAccessMode>::setScrollArea(uint16_t y,uint16_t height) const {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9481<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::setScrollArea(uint16_t y,uint16_t height) const {
 
 		uint16_t bfa,tfa;
 
@@ -253,27 +261,9 @@ namespace lcd {
 	 * @param numBytes number of bytes to write.
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void ILI9481<TOrientation,TColourDepth,TAccessMode>::rawFlashTransfer(uint32_t data,uint32_t numBytes) const {
-
-		uint32_t numPixels;
-
-		numPixels=numBytes/2;
-
-		// handle data in the lower and upper segments with possible overlap
-		// a single 16-bit pixel should not overlap the segments
-
-		while(data<65536 && numPixels>0) {
-			TAccessMode::writeData(pgm_read_byte_near(data),pgm_read_byte_near(data+1));
-			data+=2;
-			numPixels--;
-		}
-
-		while(numPixels>0) {
-			TAccessMode::writeData(pgm_read_byte_far(data),pgm_read_byte_far(data+1));
-			data+=2;
-			numPixels--;
-		}
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9481<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::rawFlashTransfer(uint32_t data,uint32_t numBytes) const {
+		TAccessMode::writeFlashDataBlock(data,numBytes);
 	}
 
 
@@ -283,17 +273,18 @@ namespace lcd {
 	 * @param numBytes number of bytes to write.
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void ILI9481<TOrientation,TColourDepth,TAccessMode>::rawSramTransfer(uint8_t *data,uint32_t numBytes) const {
-
-		uint32_t numPixels;
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9481<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::rawSramTransfer(uint8_t *data,uint32_t numBytes) const {
 
-		numPixels=numBytes/2;
+		// the access modes take a 16-bit byte count
 
-		while(numPixels--) {
-			TAccessMode::writeData(data[0],data[1]);
-			data+=2;
+		while(numBytes>0xfffe) {
+			TAccessMode::writeDataBlock(data,0xfffe);
+			data+=0xfffe;
+			numBytes-=0xfffe;
 		}
+
+		TAccessMode::writeDataBlock(data,numBytes);
 	}
 
 
@@ -302,8 +293,8 @@ namespace lcd {
 	 * @param gamma The collection of gamma values
 	 */
 
-	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode>
-	inline void ILI9481<TOrientation,TColourDepth,TAccessMode>::applyGamma(const ILI9481Gamma& gamma) const {
+	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9481<TOrientation,TColourDepth,TAccessMode,TWindowShadowing>::applyGamma(const ILI9481Gamma& gamma) const {
 
 		TAccessMode::writeCommand(ili9481::GAMMA_SETTING);
 
@@ -34,11 +34,12 @@ namespace lcd {
 	/**
 	 * Specialisation of ILI9481Orientation for the panel in LANDSCAPE mode.
 	 * @tparam TAccessMode the access mode implementation, e.g. Xmem16AccessMode
+	 * @tparam TWindowShadowing Whether to shadow the window registers
 	 * @ingroup ILI9481
 	 */
 
-	template<class TAccessMode>
-	class ILI9481Orientation<LANDSCAPE,TAccessMode> {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	class ILI9481Orientation<LANDSCAPE,TAccessMode,TWindowShadowing> : public ILI9481WindowRegisters<TAccessMode,TWindowShadowing> {
 
 		protected:
 			uint16_t getAddressMode() const;
@@ -60,8 +61,8 @@ namespace lcd {
 	 * @return The entry mode register setting for portrait
 	 */
 
-	template<class TAccessMode>
-	inline uint16_t ILI9481Orientation<LANDSCAPE,TAccessMode>::getAddressMode() const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline uint16_t ILI9481Orientation<LANDSCAPE,TAccessMode,TWindowShadowing>::getAddressMode() const {
 		return ili9481::PAGECOL_SELECTION;
 	}
 
@@ -71,8 +72,8 @@ namespace lcd {
 	 * @return The panel width (i.e. 480)
 	 */
 
-	template<class TAccessMode>
-	inline int16_t ILI9481Orientation<LANDSCAPE,TAccessMode>::getWidth() const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline int16_t ILI9481Orientation<LANDSCAPE,TAccessMode,TWindowShadowing>::getWidth() const {
 		return 480;
 	}
 
@@ -82,8 +83,8 @@ namespace lcd {
 	 * @return The panel height (i.e. 320)
 	 */
 
-	template<class TAccessMode>
-	inline int16_t ILI9481Orientation<LANDSCAPE,TAccessMode>::getHeight() const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline int16_t ILI9481Orientation<LANDSCAPE,TAccessMode,TWindowShadowing>::getHeight() const {
 		return 320;
 	}
 
@@ -93,8 +94,8 @@ namespace lcd {
 	 * @param rc The display output rectangle
 	 */
 
-	template<class TAccessMode>
-	inline void ILI9481Orientation<LANDSCAPE,TAccessMode>::moveTo(const Rectangle& rc) const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9481Orientation<LANDSCAPE,TAccessMode,TWindowShadowing>::moveTo(const Rectangle& rc) const {
 		moveTo(rc.X,rc.Y,rc.X+rc.Width-1,rc.Y+rc.Height-1);
 	}
 
@@ -107,20 +108,12 @@ namespace lcd {
 	 * @param yend bottom-most y co-ordinate
 	 */
 
-	template<class TAccessMode>
-	inline void ILI9481Orientation<LANDSCAPE,TAccessMode>::moveTo(int16_t xstart,int16_t ystart,int16_t xend,int16_t yend) const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9481Orientation<LANDSCAPE,TAccessMode,TWindowShadowing>::moveTo(int16_t xstart,int16_t ystart,int16_t xend,int16_t yend) const {
 
-		TAccessMode::writeCommand(ili9481::SET_COLUMN_ADDRESS);
-		TAccessMode::writeData(xstart >> 8);
-		TAccessMode::writeData(xstart & 0xff);
-		TAccessMode::writeData(xend >> 8);
-		TAccessMode::writeData(xend & 0xff);
+		this->writeAddressRange(ili9481::SET_COLUMN_ADDRESS,0,xstart,xend);
 
-		TAccessMode::writeCommand(ili9481::SET_PAGE_ADDRESS);
-		TAccessMode::writeData(ystart >> 8);
-		TAccessMode::writeData(ystart & 0xff);
-		TAccessMode::writeData(yend >> 8);
-		TAccessMode::writeData(yend & 0xff);
+		this->writeAddressRange(ili9481::SET_PAGE_ADDRESS,2,ystart,yend);
 	}
 
 
@@ -130,14 +123,10 @@ namespace lcd {
 	 * @param xend The new X end position
 	 */
 
-	template<class TAccessMode>
-	inline void ILI9481Orientation<LANDSCAPE,TAccessMode>::moveX(int16_t xstart,int16_t xend) const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9481Orientation<LANDSCAPE,TAccessMode,TWindowShadowing>::moveX(int16_t xstart,int16_t xend) const {
 
-		TAccessMode::writeCommand(ili9481::SET_COLUMN_ADDRESS);
-		TAccessMode::writeData(xstart >> 8);
-		TAccessMode::writeData(xstart & 0xff);
-		TAccessMode::writeData(xend >> 8);
-		TAccessMode::writeData(xend & 0xff);
+		this->writeAddressRange(ili9481::SET_COLUMN_ADDRESS,0,xstart,xend);
 	}
 
 
@@ -146,14 +135,10 @@ namespace lcd {
 	 * @param ystart The new Y start position
 	 */
 
-	template<class TAccessMode>
-	inline void ILI9481Orientation<LANDSCAPE,TAccessMode>::moveY(int16_t ystart,int16_t yend) const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9481Orientation<LANDSCAPE,TAccessMode,TWindowShadowing>::moveY(int16_t ystart,int16_t yend) const {
 
-		TAccessMode::writeCommand(ili9481::SET_PAGE_ADDRESS);
-		TAccessMode::writeData(ystart >> 8);
-		TAccessMode::writeData(ystart & 0xff);
-		TAccessMode::writeData(yend >> 8);
-		TAccessMode::writeData(yend & 0xff);
+		this->writeAddressRange(ili9481::SET_PAGE_ADDRESS,2,ystart,yend);
 	}
 
 
@@ -162,8 +147,8 @@ namespace lcd {
 	 * @param scrollPosition The new scroll position
 	 */
 
-	template<class TAccessMode>
-	inline void ILI9481Orientation<LANDSCAPE,TAccessMode>::setScrollPosition(int16_t scrollPosition) const {
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	inline void ILI9481Orientation<LANDSCAPE,TAccessMode,TWindowShadowing>::setScrollPosition(int16_t scrollPosition) const {
 
 		if(scrollPosition<0)
       scrollPosition+=480;
@@ -38,9 +38,48 @@ namespace lcd {
 	 * @ingroup ILI9481
 	 */
 
-	template<Orientation TOrientation,class TAccessMode>
+	template<Orientation TOrientation,class TAccessMode,WindowShadowing TWindowShadowing>
 	class ILI9481Orientation {
 	};
+
+
+	/**
+	 * @brief Window register writer shared by the orientation specialisations.
+	 *
+	 * The column and page ranges are shadowed. Skipping an unchanged range is safe because the
+	 * write memory start command always returns the pointer to the start column and page.
+	 * @ingroup ILI9481
+	 */
+
+	template<class TAccessMode,WindowShadowing TWindowShadowing>
+	class ILI9481WindowRegisters : public RegisterShadow<TWindowShadowing,4> {
+
+		protected:
+
+			/**
+			 * Write a column or page address range if either end has changed
+			 * @param command SET_COLUMN_ADDRESS or SET_PAGE_ADDRESS
+			 * @param shadowIndex 0 for the column, 2 for the page
+			 * @param start The new start address
+			 * @param end The new end address
+			 */
+
+			void writeAddressRange(uint8_t command,uint8_t shadowIndex,int16_t start,int16_t end) const {
+
+				bool changed;
+
+				changed=this->updateShadow(shadowIndex,start);
+				changed|=this->updateShadow(shadowIndex+1,end);
+
+				if(changed) {
+					TAccessMode::writeCommand(command);
+					TAccessMode::writeData(start >> 8);
+					TAccessMode::writeData(start & 0xff);
+					TAccessMode::writeData(end >> 8);
+					TAccessMode::writeData(end & 0xff);
+				}
+			}
+	};
 }
 
 
@@ -52,6 +52,7 @@ namespace lcd {
 			void unpackColour(uint8_t red,uint8_t green,uint8_t blue,UnpackedColour& dest) const;
 
 			void writePixel(const UnpackedColour& cr) const;
+			void writePixels(const UnpackedColour *pixels,uint16_t numPixels) const;
 			void writePixelAgain(const UnpackedColour& cr) const;
 			void fillPixels(uint32_t numPixels,const UnpackedColour& cr) const;
 
@@ -119,18 +120,52 @@ namespace lcd {
 	}
 
 
+	/**
+	 * Write a block of pixels from SRAM to the current output position. The unpacked colours are laid
+	 * out in memory in the order that they go out on the bus so the block is handed to the access mode
+	 * in as few calls as its 16-bit byte count allows. Assumes that the caller has already issued the
+	 * beginWriting() command.
+	 * @param pixels The pixels to write
+	 * @param numPixels The number of pixels.
+	 */
+
+	template<class TAccessMode,class TPanelTraits>
+	inline void LDS285Colour<COLOURS_18BIT,TAccessMode,TPanelTraits>::writePixels(const UnpackedColour *pixels,uint16_t numPixels) const {
+
+		// the access modes take a 16-bit byte count
+
+		while(numPixels>0x5555) {
+			TAccessMode::writeDataBlock(reinterpret_cast<const uint8_t *>(pixels),0x5555*3);
+			pixels+=0x5555;
+			numPixels-=0x5555;
+		}
+
+		TAccessMode::writeDataBlock(reinterpret_cast<const uint8_t *>(pixels),numPixels*3);
+	}
+
+
 	/**
 	 * Write the same colour pixel that we last wrote. This gives the access mode a chance to
 	 * optimise sequential pixel writes. The colour is provided for drivers that cannot optimise
 	 * and must fall back to a full write.
+	 * Greys have all three bytes the same so the last byte written is still the right one and the access
+	 * mode may only need to strobe the bus.
 	 * @param cr The pixel to write
 	 */
 
 	template<class TAccessMode,class TPanelTraits>
 	inline void LDS285Colour<COLOURS_18BIT,TAccessMode,TPanelTraits>::writePixelAgain(const UnpackedColour& cr) const {
-		TAccessMode::writeData(cr.r);
-		TAccessMode::writeData(cr.g);
-		TAccessMode::writeData(cr.b);
+
+		if(cr.r==cr.g && cr.g==cr.b) {
+			TAccessMode::writeDataAgain(cr.r);
+			TAccessMode::writeDataAgain(cr.r);
+			TAccessMode::writeDataAgain(cr.r);
+		}
+		else {
+			TAccessMode::writeData(cr.r);
+			TAccessMode::writeData(cr.g);
+			TAccessMode::writeData(cr.b);
+		}
 	}
 
 
@@ -144,19 +179,8 @@ namespace lcd {
 	template<class TAccessMode,class TPanelTraits>
 	inline void LDS285Colour<COLOURS_18BIT,TAccessMode,TPanelTraits>::fillPixels(uint32_t numPixels,const UnpackedColour& cr) const {
 
-		uint8_t b,g,r;
-
 		TAccessMode::writeCommand(lds285::MEMORY_WRITE);
-
-		b=cr.b;
-		g=cr.g;
-		r=cr.r;
-
-		while(numPixels--) {
-			TAccessMode::writeData(r);
-			TAccessMode::writeData(g);
-			TAccessMode::writeData(b);
-		}
+		TAccessMode::writeMultiData(numPixels,cr.r,cr.g,cr.b);
 	}
 
 
@@ -33,7 +33,7 @@
 
 #pragma once
 
-#include "commands/Allcommands.h"
+#include "commands/AllCommands.h"
 #include "MC2PA8201Colour.h"
 #include "MC2PA8201Orientation.h"
 
@@ -198,18 +198,7 @@ namespace lcd {
 
 	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,class TPanelTraits>
 	inline void MC2PA8201<TOrientation,TColourDepth,TAccessMode,TPanelTraits>::rawFlashTransfer(uint32_t data,uint32_t numBytes) const {
-
-		// handle data in the lower and upper segments with possible overlap
-
-		while(data<65536 && numBytes>0) {
-			TAccessMode::writeData(pgm_read_byte_near(data++));
-			numBytes--;
-		}
-
-		while(numBytes>0) {
-			TAccessMode::writeData(pgm_read_byte_far(data++));
-			numBytes--;
-		}
+		TAccessMode::writeFlashDataBlock(data,numBytes);
 	}
 
 
@@ -222,7 +211,14 @@ namespace lcd {
 	template<Orientation TOrientation,ColourDepth TColourDepth,class TAccessMode,class TPanelTraits>
 	inline void MC2PA8201<TOrientation,TColourDepth,TAccessMode,TPanelTraits>::rawSramTransfer(uint8_t *data,uint32_t numBytes) const {
 
-		while(numBytes--)
-			TAccessMode::writeData(*data++);
+		// the access modes take a 16-bit byte count
+
+		while(numBytes>0xfffe) {
+			TAccessMode::writeDataBlock(data,0xfffe);
+			data+=0xfffe;
+			numBytes-=0xfffe;
+		}
+
+		TAccessMode::writeDataBlock(data,numBytes);
 	}
 }
@@ -53,6 +53,7 @@ namespace lcd {
 			void unpackColour(uint8_t red,uint8_t green,uint8_t blue,UnpackedColour& dest) const;
 
 			void writePixel(const UnpackedColour& cr) const;
+			void writePixels(const UnpackedColour *pixels,uint16_t numPixels) const;
 			void writePixelAgain(const UnpackedColour& cr) const;
 			void fillPixels(uint32_t numPixels,const UnpackedColour& cr) const;
 
@@ -133,17 +134,50 @@ namespace lcd {
 	}
 
 
+	/**
+	 * Write a block of pixels from SRAM to the current output position. The unpacked colours are laid
+	 * out in memory in the order that they go out on the bus so the block is handed to the access mode
+	 * in as few calls as its 16-bit byte count allows. Assumes that the caller has already issued the
+	 * beginWriting() command.
+	 * @param pixels The pixels to write
+	 * @param numPixels The number of pixels.
+	 */
+
+	template<class TAccessMode,class TPanelTraits>
+	inline void MC2PA8201Colour<COLOURS_16BIT,TAccessMode,TPanelTraits>::writePixels(const UnpackedColour *pixels,uint16_t numPixels) const {
+
+		// the access modes take a 16-bit byte count
+
+		while(numPixels>0x7fff) {
+			TAccessMode::writeDataBlock(reinterpret_cast<const uint8_t *>(pixels),0x7fff*2);
+			pixels+=0x7fff;
+			numPixels-=0x7fff;
+		}
+
+		TAccessMode::writeDataBlock(reinterpret_cast<const uint8_t *>(pixels),numPixels*2);
+	}
+
+
 	/**
 	 * Write the same colour pixel that we last wrote. This gives the access mode a chance to
 	 * optimise sequential pixel writes. The colour is provided for drivers that cannot optimise
 	 * and must fall back to a full write.
+	 * If both bytes are the same then the last byte written is still the right one and the access mode
+	 * may only need to strobe the bus.
 	 * @param cr The pixel to write
 	 */
 
 	template<class TAccessMode,class TPanelTraits>
 	inline void MC2PA8201Colour<COLOURS_16BIT,TAccessMode,TPanelTraits>::writePixelAgain(const UnpackedColour& cr) const {
-		TAccessMode::writeData(cr.first);
-		TAccessMode::writeData(cr.second);
+
+		if(cr.first==cr.second) {
+			TAccessMode::writeDataAgain(cr.first);
+			TAccessMode::writeDataAgain(cr.first);
+		}
+		else {
+			TAccessMode::writeData(cr.first);
+			TAccessMode::writeData(cr.second);
+		}
 	}
 
 
@@ -157,17 +191,8 @@ namespace lcd {
 	template<class TAccessMode,class TPanelTraits>
 	inline void MC2PA8201Colour<COLOURS_16BIT,TAccessMode,TPanelTraits>::fillPixels(uint32_t numPixels,const UnpackedColour& cr) const {
 
-		uint8_t first,second;
-
 		TAccessMode::writeCommand(mc2pa8201::MEMORY_WRITE);
-
-		first=cr.first;
-		second=cr.second;
-
-		while(numPixels--) {
-			TAccessMode::writeData(first);
-			TAccessMode::writeData(second);
-		}
+		TAccessMode::writeMultiData(numPixels,cr.first,cr.second);
 	}
 
 
@@ -0,0 +1,325 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file MC2PA8201GramModel.h
+ * @brief A model of the MC2PA8201 command interface and frame memory for use with the HostAccessMode.
+ * @ingroup MC2PA8201
+ */
+
+#pragma once
+
+#if !defined(__AVR__)
+
+#include "commands/AllCommands.h"
+
+
+namespace lcd {
+
+	/**
+	 * @brief Desktop host model of the MC2PA8201 frame memory.
+	 *
+	 * Decodes the 8-bit command/parameter stream that the driver issues. The column and page
+	 * address commands (0x2a, 0x2b) each take four parameter bytes that set the start and end of
+	 * the window. Memory write (0x2c) resets the write pointer to the start column and page and
+	 * each subsequent pixel advances the column, wrapping to the next page at the end column and
+	 * back to the start page at the end page. The interface pixel format (0x3a) selects whether
+	 * a pixel is 2 bytes (0x55) or 3 bytes (0x66, 0x77).
+	 *
+	 * The frame memory is addressed in the logical column/page space that the driver sets up. For
+	 * panel traits that map x to the column (e.g. Nokia6300_TypeA) that's the same as panel (x,y).
+	 * The command set is the MIPI DCS subset shared by the LDS285 and so this model serves for
+	 * that controller as well.
+	 *
+	 * Cells hold the raw pixel value: the 5-6-5 word for 16-bit colour or the three bytes packed
+	 * into the low 24 bits, first byte uppermost, for 18 and 24-bit colour.
+	 *
+	 * @ingroup MC2PA8201
+	 */
+
+	class MC2PA8201GramModel {
+
+		public:
+			enum {
+				MEMORY_WIDTH=320,			///< Columns. Either side of the frame memory may be the long side.
+				MEMORY_HEIGHT=320,			///< Pages
+				BUS_BYTES=1			///< 8-bit bus
+			};
+
+		protected:
+			uint8_t _command;
+			uint8_t _parameters[4];
+			uint8_t _parameterIndex;
+			uint16_t _startColumn,_endColumn;
+			uint16_t _startPage,_endPage;
+			uint16_t _column,_page;
+			uint8_t _pixelFormat;
+			uint8_t _memoryAccessControl;
+			uint8_t _pixelBytes[3];
+			uint8_t _pixelByteIndex;
+			uint8_t _lastData;
+			uint32_t _memory[MEMORY_WIDTH*MEMORY_HEIGHT];
+
+		protected:
+			void writeMemory(uint8_t data);
+
+		public:
+			MC2PA8201GramModel();
+
+			void reset();
+			void command(uint8_t lo8,uint8_t hi8);
+			void data(uint8_t lo8,uint8_t hi8);
+			void dataAgain();
+			void multiData(uint32_t howMuch,const uint8_t *pattern,uint8_t patternSize);
+			void dataBlock(const uint8_t *data,uint16_t numBytes);
+			void streamedData(uint8_t data);
+
+			uint8_t getPixelFormat() const;
+			uint8_t getMemoryAccessControl() const;
+			uint32_t getPixel(int16_t column,int16_t page) const;
+	};
+
+
+	/**
+	 * Constructor, power-on state
+	 */
+
+	inline MC2PA8201GramModel::MC2PA8201GramModel() {
+		reset();
+	}
+
+
+	/**
+	 * Reset to the power-on state with a cleared frame memory
+	 */
+
+	inline void MC2PA8201GramModel::reset() {
+
+		memset(_memory,0,sizeof(_memory));
+
+		_command=mc2pa8201::NOP;
+		_parameterIndex=0;
+		_startColumn=_startPage=0;
+		_endColumn=MEMORY_WIDTH-1;
+		_endPage=MEMORY_HEIGHT-1;
+		_column=_page=0;
+		_pixelFormat=0x66;
+		_memoryAccessControl=0;
+		_pixelByteIndex=0;
+		_lastData=0;
+	}
+
+
+	/**
+	 * Write a command byte
+	 * @param lo8 The command
+	 * @param hi8 Ignored, the bus is 8 bits wide
+	 */
+
+	inline void MC2PA8201GramModel::command(uint8_t lo8,uint8_t /* hi8 */) {
+
+		_command=lo8;
+		_parameterIndex=0;
+
+		if(_command==mc2pa8201::MEMORY_WRITE) {
+			_column=_startColumn;
+			_page=_startPage;
+			_pixelByteIndex=0;
+		}
+	}
+
+
+	/**
+	 * Write a parameter or pixel byte
+	 * @param lo8 The data byte
+	 * @param hi8 Ignored, the bus is 8 bits wide
+	 */
+
+	inline void MC2PA8201GramModel::data(uint8_t lo8,uint8_t /* hi8 */) {
+
+		_lastData=lo8;
+
+		switch(_command) {
+
+			case mc2pa8201::MEMORY_WRITE:
+				writeMemory(lo8);
+				break;
+
+			case mc2pa8201::COLUMN_ADDRESS_SET:
+			case mc2pa8201::PAGE_ADDRESS_SET:
+
+				if(_parameterIndex<4)
+					_parameters[_parameterIndex++]=lo8;
+
+				if(_parameterIndex==4) {
+
+					uint16_t start,end;
+
+					start=static_cast<uint16_t>(_parameters[0]) << 8 | _parameters[1];
+					end=static_cast<uint16_t>(_parameters[2]) << 8 | _parameters[3];
+
+					if(_command==mc2pa8201::COLUMN_ADDRESS_SET) {
+						_startColumn=start % MEMORY_WIDTH;
+						_endColumn=end % MEMORY_WIDTH;
+					}
+					else {
+						_startPage=start % MEMORY_HEIGHT;
+						_endPage=end % MEMORY_HEIGHT;
+					}
+				}
+				break;
+
+			case mc2pa8201::INTERFACE_PIXEL_FORMAT:
+				_pixelFormat=lo8;
+				break;
+
+			case mc2pa8201::MEMORY_ACCESS_CONTROL:
+				_memoryAccessControl=lo8;
+				break;
+
+			default:
+				break;
+		}
+	}
+
+
+	/**
+	 * Repeat the last byte placed on the bus
+	 */
+
+	inline void MC2PA8201GramModel::dataAgain() {
+		data(_lastData,0);
+	}
+
+
+	/**
+	 * Repeat a byte pattern many times
+	 * @param howMuch The number of repetitions.
+	 * @param pattern The bytes.
+	 * @param patternSize The number of bytes in the pattern.
+	 */
+
+	inline void MC2PA8201GramModel::multiData(uint32_t howMuch,const uint8_t *pattern,uint8_t patternSize) {
+
+		uint8_t i;
+
+		while(howMuch--)
+			for(i=0;i<patternSize;i++)
+				data(pattern[i],0);
+	}
+
+
+	/**
+	 * Write a block of bytes, one transfer each
+	 * @param data The bytes.
+	 * @param numBytes The number of bytes in the block.
+	 */
+
+	inline void MC2PA8201GramModel::dataBlock(const uint8_t *data,uint16_t numBytes) {
+
+		while(numBytes--)
+			this->data(*data++,0);
+	}
+
+
+	/**
+	 * Streamed bytes are simply 8-bit transfers on this bus
+	 * @param data The next byte in the stream.
+	 */
+
+	inline void MC2PA8201GramModel::streamedData(uint8_t data) {
+		this->data(data,0);
+	}
+
+
+	/**
+	 * Get the last interface pixel format
+	 * @return The 0x3a parameter
+	 */
+
+	inline uint8_t MC2PA8201GramModel::getPixelFormat() const {
+		return _pixelFormat;
+	}
+
+
+	/**
+	 * Get the last memory access control value
+	 * @return The 0x36 parameter
+	 */
+
+	inline uint8_t MC2PA8201GramModel::getMemoryAccessControl() const {
+		return _memoryAccessControl;
+	}
+
+
+	/**
+	 * Get a pixel from the frame memory
+	 * @param column The logical column
+	 * @param page The logical page
+	 * @return The raw pixel value
+	 */
+
+	inline uint32_t MC2PA8201GramModel::getPixel(int16_t column,int16_t page) const {
+		return _memory[static_cast<uint32_t>(page)*MEMORY_WIDTH+column];
+	}
+
+
+	/**
+	 * Accumulate a pixel byte and store the pixel when it's complete
+	 * @param data The pixel byte
+	 */
+
+	inline void MC2PA8201GramModel::writeMemory(uint8_t data) {
+
+		uint32_t value;
+
+		_pixelBytes[_pixelByteIndex++]=data;
+
+		if(_pixelFormat==0x55) {
+
+			if(_pixelByteIndex<2)
+				return;
+
+			value=static_cast<uint32_t>(_pixelBytes[0]) << 8 | _pixelBytes[1];
+		}
+		else {
+
+			if(_pixelByteIndex<3)
+				return;
+
+			value=static_cast<uint32_t>(_pixelBytes[0]) << 16 | static_cast<uint32_t>(_pixelBytes[1]) << 8 | _pixelBytes[2];
+		}
+
+		_pixelByteIndex=0;
+		_memory[static_cast<uint32_t>(_page)*MEMORY_WIDTH+_column]=value;
+
+		// advance the column, then the page, within the window
+
+		if(_column<_endColumn)
+			_column++;
+		else {
+			_column=_startColumn;
+			_page=_page<_endPage ? _page+1 : _startPage;
+		}
+	}
+}
+
+#endif
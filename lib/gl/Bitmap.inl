@@ -31,7 +31,8 @@ namespace lcd {
 
 	/**
 	 * Draw a bitmap on the display at the given position. The bitmap is stored in flash
-	 * as an uncompressed sequence of bytes
+	 * as an uncompressed sequence of bytes. If the bitmap is partly outside the clip rectangle
+	 * then only the visible part of each visible row is read from flash.
 	 * @param p The top-left screen co-ord of where to draw the bitmap
 	 * @param bm The structure that defines the bitmap
 	 */
@@ -39,7 +40,10 @@ namespace lcd {
 	template<class TDevice,class TAccessMode>
 	inline void GraphicsLibrary<TDevice,TAccessMode>::drawUncompressedBitmap(const Point& p,const Bitmap& bm) const {
 
-		Rectangle rc;
+		Rectangle rc,visible;
+		uint32_t data,rowBytes;
+		uint8_t bytesPerPixel;
+		int16_t y;
 
 		// set up the on-screen location
 
@@ -48,16 +52,105 @@ namespace lcd {
 		rc.Width=bm.Dimensions.Width;
 		rc.Height=bm.Dimensions.Height;
 
-		this->moveTo(rc);
+		visible=rc;
+
+		if(!clipRectangle(visible))
+			return;
+
+		this->moveTo(visible);
 		this->beginWriting();
 
-		this->rawFlashTransfer(bm.Pixels,bm.DataSize);
+		if(visible.Width==rc.Width && visible.Height==rc.Height)
+			this->rawFlashTransfer(bm.Pixels,bm.DataSize);
+		else {
+
+			// skip the clipped rows and columns in flash
+
+			bytesPerPixel=this->getBytesPerPixel();
+			rowBytes=(uint32_t)rc.Width*bytesPerPixel;
+
+			data=bm.Pixels+rowBytes*(visible.Y-rc.Y)+(uint32_t)(visible.X-rc.X)*bytesPerPixel;
+
+			for(y=0;y<visible.Height;y++) {
+				this->rawFlashTransfer(data,(uint32_t)visible.Width*bytesPerPixel);
+				data+=rowBytes;
+			}
+		}
+	}
+
+
+	/**
+	 * Draw an uncompressed bitmap read from a source. The data is pulled from the source in chunks
+	 * and written to the panel from SRAM. If the bitmap is partly outside the clip rectangle then
+	 * the bytes outside it are skipped.
+	 * @param p The top-left screen co-ord of where to draw the bitmap
+	 * @param size The dimensions of the bitmap
+	 * @param source The source of the pixel data
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::drawUncompressedBitmap(const Point& p,const Size& size,ByteSource& source) const {
+
+		Rectangle rc,visible;
+		uint32_t rowBytes,leftBytes,visibleBytes,remaining;
+		uint16_t count;
+		uint8_t bytesPerPixel;
+		uint8_t buffer[96];						// a whole number of 2 or 3 byte pixels
+		int16_t y;
+
+		// set up the on-screen location
+
+		rc.X=p.X;
+		rc.Y=p.Y;
+		rc.Width=size.Width;
+		rc.Height=size.Height;
+
+		bytesPerPixel=this->getBytesPerPixel();
+		rowBytes=(uint32_t)rc.Width*bytesPerPixel;
+
+		// the whole bitmap is always consumed so that a stream is left at the start of the next asset
+
+		visible=rc;
+
+		if(!clipRectangle(visible)) {
+			source.skip(rowBytes*rc.Height);
+			return;
+		}
+
+		this->moveTo(visible);
+		this->beginWriting();
+
+		leftBytes=(uint32_t)(visible.X-rc.X)*bytesPerPixel;
+		visibleBytes=(uint32_t)visible.Width*bytesPerPixel;
+
+		// skip the clipped rows above, then the clipped columns either side of each visible row
+
+		source.skip(rowBytes*(visible.Y-rc.Y));
+
+		for(y=0;y<visible.Height;y++) {
+
+			source.skip(leftBytes);
+
+			for(remaining=visibleBytes;remaining;remaining-=count) {
+
+				if((count=source.readFully(buffer,remaining<sizeof(buffer) ? remaining : sizeof(buffer)))==0)
+					return;
+
+				this->rawSramTransfer(buffer,count);
+			}
+
+			source.skip(rowBytes-leftBytes-visibleBytes);
+		}
+
+		source.skip(rowBytes*(rc.Y+rc.Height-visible.Y-visible.Height));
 	}
 
 
 	/**
 	 * Draw a bitmap on the display at the given position. The bitmap is stored in flash
-	 * as an LZG compressed sequence of bytes. This costs you 2Kb of stack space to call.
+	 * as an LZG compressed sequence of bytes. This costs you 2Kb of stack space to call
+	 * because it sets up a default LzgDecoderContext. Use the overload that takes a context
+	 * to avoid that when drawing many bitmaps.
 	 * @param p top-left screen co-ord of where to draw the bitmap
 	 * @param bm The structure that defines the bitmap
 	 */
@@ -65,25 +158,83 @@ namespace lcd {
 	template<class TDevice,class TAccessMode>
 	inline void GraphicsLibrary<TDevice,TAccessMode>::drawCompressedBitmap(const Point& p,const Bitmap& bm) const {
 
-		Rectangle rc;
-		LzgFlashDecoder<TAccessMode> lzg;
+		LzgDecoderContext<> context;
+		drawCompressedBitmap(p,bm,context);
+	}
+
+
+	/**
+	 * Draw a bitmap on the display at the given position. The bitmap is stored in flash
+	 * as an LZG compressed sequence of bytes and is decoded using the history window in
+	 * the given context. Nothing is drawn if the bitmap needs a larger window than the context has.
+	 * @param p top-left screen co-ord of where to draw the bitmap
+	 * @param bm The structure that defines the bitmap
+	 * @param context The LzgDecoderContext to decode with.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	template<class TContext>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::drawCompressedBitmap(const Point& p,const Bitmap& bm,TContext& context) const {
+
+		// a bitmap in flash can have its window size checked before anything is drawn
+
+		if(LzgFlashDecoder<TAccessMode>::getWindowSize(bm.Pixels,bm.DataSize)>sizeof(context.History))
+			return;
+
+		FlashByteSource source(bm.Pixels,bm.DataSize);
+		drawCompressedBitmap(p,bm.Dimensions,source,context);
+	}
+
+
+	/**
+	 * Draw an LZG compressed bitmap read from a source, decoding it with the history window in
+	 * the given context. If the bitmap is partly outside the clip rectangle then the whole bitmap
+	 * is decoded but only the visible bytes are written to the panel. Otherwise runs of flat colour
+	 * are written to the panel in bursts.
+	 * @param p top-left screen co-ord of where to draw the bitmap
+	 * @param size The dimensions of the bitmap
+	 * @param source The source of the compressed data
+	 * @param context The LzgDecoderContext to decode with.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	template<class TContext>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::drawCompressedBitmap(const Point& p,const Size& size,ByteSource& source,TContext& context) const {
+
+		Rectangle rc,visible;
 
 		// set up the on-screen location
 
 		rc.X=p.X;
 		rc.Y=p.Y;
-		rc.Width=bm.Dimensions.Width;
-		rc.Height=bm.Dimensions.Height;
+		rc.Width=size.Width;
+		rc.Height=size.Height;
+
+		visible=rc;
+
+		// an invisible bitmap is not decoded but it is consumed so that a stream is left at the start
+		// of the next asset
 
-		this->moveTo(rc);
+		if(!clipRectangle(visible)) {
+			source.skip(0xffffffff);
+			return;
+		}
+
+		this->moveTo(visible);
 		this->beginWriting();
 
-		lzg.decode(bm.Pixels,bm.DataSize);
+		if(visible.Width==rc.Width && visible.Height==rc.Height)
+			LzgFlashDecoder<TAccessMode,LzgStreamPixelSize<TAccessMode,sizeof(UnpackedColour)>::VALUE>::decode(context,source);
+		else {
+			ClippingStreamAccessMode<TAccessMode>::setClip(rc,visible,this->getBytesPerPixel());
+			LzgFlashDecoder<ClippingStreamAccessMode<TAccessMode> >::decode(context,source);
+		}
 	}
 
 
 	/**
-	 * Draw a JPEG on the display at the given position. It's assumed to be in flash.
+	 * Draw a JPEG on the display at the given position. It's assumed to be in flash. Each 8x8 block is
+	 * trimmed to the clip rectangle and blocks that are entirely outside are decoded but not written.
 	 * @param pt top-left screen co-ord of where to draw the bitmap
 	 * @param ds The data source that defines where the JPEG data comes from. For example, JpegFlashDataSource or JpegSerialDataSource.
 	 */
@@ -123,25 +274,42 @@ namespace lcd {
 
 					int bx_limit=min(8,imageInfo.m_width-(mcu_x*imageInfo.m_MCUWidth+x));
 
-					this->moveTo(Rectangle(pt.X+mcu_x*imageInfo.m_MCUWidth,pt.Y+mcu_y*imageInfo.m_MCUHeight,bx_limit,by_limit));
+					// trim the block to the clip rectangle
+
+					Rectangle block(pt.X+mcu_x*imageInfo.m_MCUWidth+x,pt.Y+mcu_y*imageInfo.m_MCUHeight+y,bx_limit,by_limit);
+					Rectangle visible(block);
+
+					if(bx_limit<=0 || by_limit<=0 || !clipRectangle(visible))
+						continue;
+
+					int bx_start=visible.X-block.X;
+					int by_start=visible.Y-block.Y;
+					int bx_end=bx_start+visible.Width;
+					int by_end=by_start+visible.Height;
+
+					pSrcR+=by_start*8+bx_start;
+					pSrcG+=by_start*8+bx_start;
+					pSrcB+=by_start*8+bx_start;
+
+					this->moveTo(visible);
 					this->beginWriting();
 
 					if(imageInfo.m_scanType==PJPG_GRAYSCALE) {
 
-						for(int by=0;by<by_limit;by++) {
+						for(int by=by_start;by<by_end;by++) {
 
-							for(int bx=0;bx < bx_limit;bx++) {
+							for(int bx=bx_start;bx<bx_end;bx++) {
 								this->unpackColour(*pSrcR,*pSrcR,*pSrcR,cr);
 								this->writePixel(cr);
 								pSrcR++;
 							}
 
-							pSrcR+=(8-bx_limit);
+							pSrcR+=(8-visible.Width);
 						}
 					} else {
-						for(int by=0;by<by_limit;by++) {
+						for(int by=by_start;by<by_end;by++) {
 
-							for(int bx=0;bx<bx_limit;bx++) {
+							for(int bx=bx_start;bx<bx_end;bx++) {
 
 								this->unpackColour(*pSrcR,*pSrcG,*pSrcB,cr);
 
@@ -152,9 +320,9 @@ namespace lcd {
 								this->writePixel(cr);
 							}
 
-							pSrcR+=(8-bx_limit);
-							pSrcG+=(8-bx_limit);
-							pSrcB+=(8-bx_limit);
+							pSrcR+=(8-visible.Width);
+							pSrcG+=(8-visible.Width);
+							pSrcB+=(8-visible.Width);
 						}
 					}
 				}
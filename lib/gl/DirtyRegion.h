@@ -0,0 +1,295 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file DirtyRegion.h
+ * @brief Tracks the areas of the display that need to be redrawn
+ * @ingroup GraphicsLibrary
+ */
+
+#pragma once
+
+
+namespace lcd {
+
+	/**
+	 * @brief A bounded list of dirty rectangles that are coalesced by cost.
+	 *
+	 * The application calls markDirty() whenever something changes and then flush() once per frame. Each time
+	 * a rectangle is added the pair of rectangles that is cheapest to combine is merged into its bounding box,
+	 * as long as the number of pixels that would be redrawn unnecessarily is no more than the cost of setting
+	 * up a separate window, expressed in pixels. If the list is full then the cheapest pair is merged regardless
+	 * of cost, so the region never loses an area that was marked dirty.
+	 *
+	 * The rectangles are not clipped to the display. The caller is expected to mark areas that are on the display.
+	 *
+	 * @tparam TCapacity The maximum number of separate rectangles. Must be at least 2.
+	 * @tparam TWindowCost The cost of setting a new window, expressed as the number of pixels that could have been
+	 *   written in the same time. 32 is about right for the 16-bit interfaces.
+	 * @ingroup GraphicsLibrary
+	 */
+
+	template<uint8_t TCapacity,uint16_t TWindowCost=32>
+	class DirtyRegion {
+
+		public:
+
+			/**
+			 * The redraw callback. This is called once for each dirty rectangle.
+			 * @param rc The dirty rectangle.
+			 * @param context The context pointer that was given to flush().
+			 */
+
+			typedef void (*RedrawCallback)(const Rectangle& rc,void *context);
+
+		protected:
+			Rectangle _rectangles[TCapacity];
+			uint8_t _count;
+
+		protected:
+			bool mergeCheapestPair(bool force);
+			void remove(uint8_t index);
+
+			static int32_t getMergeCost(const Rectangle& rc1,const Rectangle& rc2,Rectangle& merged);
+
+		public:
+			DirtyRegion();
+
+			void markDirty(const Rectangle& rc);
+			void flush(RedrawCallback callback,void *context=NULL);
+			void clear();
+
+			template<class TGraphicsLibrary>
+			void flush(TGraphicsLibrary& gl,RedrawCallback callback,void *context=NULL);
+
+			bool isEmpty() const;
+			uint8_t getCount() const;
+			const Rectangle& getRectangle(uint8_t index) const;
+	};
+
+
+	/**
+	 * Constructor
+	 */
+
+	template<uint8_t TCapacity,uint16_t TWindowCost>
+	inline DirtyRegion<TCapacity,TWindowCost>::DirtyRegion()
+		: _count(0) {
+	}
+
+
+	/**
+	 * Mark an area as needing a redraw.
+	 * @param rc The area. Empty rectangles are ignored.
+	 */
+
+	template<uint8_t TCapacity,uint16_t TWindowCost>
+	inline void DirtyRegion<TCapacity,TWindowCost>::markDirty(const Rectangle& rc) {
+
+		if(rc.Width<=0 || rc.Height<=0)
+			return;
+
+		// make space if necessary
+
+		if(_count==TCapacity)
+			mergeCheapestPair(true);
+
+		_rectangles[_count++]=rc;
+
+		// merge while it saves time
+
+		while(mergeCheapestPair(false));
+	}
+
+
+	/**
+	 * Call the redraw callback for each dirty rectangle and then clear the region.
+	 * @param callback The function to call.
+	 * @param context A pointer that is passed through to the callback.
+	 */
+
+	template<uint8_t TCapacity,uint16_t TWindowCost>
+	inline void DirtyRegion<TCapacity,TWindowCost>::flush(RedrawCallback callback,void *context) {
+
+		uint8_t i;
+
+		for(i=0;i<_count;i++)
+			callback(_rectangles[i],context);
+
+		clear();
+	}
+
+
+	/**
+	 * Call the redraw callback for each dirty rectangle with the graphics library clip rectangle set to
+	 * the dirty rectangle, so the callback can simply redraw everything that might overlap it. The original
+	 * clip rectangle is restored afterwards and the region is cleared.
+	 * @param gl The graphics library to clip.
+	 * @param callback The function to call.
+	 * @param context A pointer that is passed through to the callback.
+	 */
+
+	template<uint8_t TCapacity,uint16_t TWindowCost>
+	template<class TGraphicsLibrary>
+	inline void DirtyRegion<TCapacity,TWindowCost>::flush(TGraphicsLibrary& gl,RedrawCallback callback,void *context) {
+
+		Rectangle saved;
+		uint8_t i;
+
+		saved=gl.getClip();
+
+		for(i=0;i<_count;i++) {
+			gl.setClip(_rectangles[i]);
+			callback(_rectangles[i],context);
+		}
+
+		gl.setClip(saved);
+		clear();
+	}
+
+
+	/**
+	 * Discard all the dirty rectangles.
+	 */
+
+	template<uint8_t TCapacity,uint16_t TWindowCost>
+	inline void DirtyRegion<TCapacity,TWindowCost>::clear() {
+		_count=0;
+	}
+
+
+	/**
+	 * Check if there is anything to redraw
+	 * @return true if nothing is dirty.
+	 */
+
+	template<uint8_t TCapacity,uint16_t TWindowCost>
+	inline bool DirtyRegion<TCapacity,TWindowCost>::isEmpty() const {
+		return _count==0;
+	}
+
+
+	/**
+	 * Get the number of dirty rectangles
+	 * @return The number of rectangles.
+	 */
+
+	template<uint8_t TCapacity,uint16_t TWindowCost>
+	inline uint8_t DirtyRegion<TCapacity,TWindowCost>::getCount() const {
+		return _count;
+	}
+
+
+	/**
+	 * Get one of the dirty rectangles
+	 * @param index The index, 0..getCount()-1
+	 * @return The rectangle.
+	 */
+
+	template<uint8_t TCapacity,uint16_t TWindowCost>
+	inline const Rectangle& DirtyRegion<TCapacity,TWindowCost>::getRectangle(uint8_t index) const {
+		return _rectangles[index];
+	}
+
+
+	/**
+	 * Find the pair of rectangles that costs the least to merge and merge them.
+	 * @param force true to merge even if merging costs more than keeping them separate.
+	 * @return true if a pair was merged.
+	 */
+
+	template<uint8_t TCapacity,uint16_t TWindowCost>
+	inline bool DirtyRegion<TCapacity,TWindowCost>::mergeCheapestPair(bool force) {
+
+		uint8_t i,j,best1,best2;
+		int32_t cost,bestCost;
+		Rectangle merged,bestMerged;
+
+		if(_count<2)
+			return false;
+
+		bestCost=0x7fffffff;
+		best1=best2=0;
+
+		for(i=0;i<_count-1;i++) {
+			for(j=i+1;j<_count;j++) {
+
+				cost=getMergeCost(_rectangles[i],_rectangles[j],merged);
+
+				if(cost<bestCost) {
+					bestCost=cost;
+					bestMerged=merged;
+					best1=i;
+					best2=j;
+				}
+			}
+		}
+
+		if(!force && bestCost>(int32_t)TWindowCost)
+			return false;
+
+		_rectangles[best1]=bestMerged;
+		remove(best2);
+
+		return true;
+	}
+
+
+	/**
+	 * Remove a rectangle from the list
+	 * @param index The index of the rectangle to remove.
+	 */
+
+	template<uint8_t TCapacity,uint16_t TWindowCost>
+	inline void DirtyRegion<TCapacity,TWindowCost>::remove(uint8_t index) {
+
+		for(_count--;index<_count;index++)
+			_rectangles[index]=_rectangles[index+1];
+	}
+
+
+	/**
+	 * Calculate the cost of merging two rectangles into their bounding box. This is the number of pixels
+	 * in the bounding box that are in neither of the rectangles. Negative costs are possible when the
+	 * rectangles overlap, because then the overlap no longer has to be drawn twice.
+	 * @param rc1 The first rectangle.
+	 * @param rc2 The second rectangle.
+	 * @param merged Output the bounding box.
+	 * @return The cost in pixels.
+	 */
+
+	template<uint8_t TCapacity,uint16_t TWindowCost>
+	inline int32_t DirtyRegion<TCapacity,TWindowCost>::getMergeCost(const Rectangle& rc1,const Rectangle& rc2,Rectangle& merged) {
+
+		int16_t right,bottom;
+
+		merged.X=rc1.X<rc2.X ? rc1.X : rc2.X;
+		merged.Y=rc1.Y<rc2.Y ? rc1.Y : rc2.Y;
+
+		right=rc1.X+rc1.Width>rc2.X+rc2.Width ? rc1.X+rc1.Width : rc2.X+rc2.Width;
+		bottom=rc1.Y+rc1.Height>rc2.Y+rc2.Height ? rc1.Y+rc1.Height : rc2.Y+rc2.Height;
+
+		merged.Width=right-merged.X;
+		merged.Height=bottom-merged.Y;
+
+		return (int32_t)merged.getArea()-(int32_t)rc1.getArea()-(int32_t)rc2.getArea();
+	}
+}
@@ -0,0 +1,625 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file DrawList.h
+ * @brief A recorder that optimises and replays a list of drawing operations
+ * @ingroup GraphicsLibrary
+ */
+
+#pragma once
+
+
+namespace lcd {
+
+	/**
+	 * @brief Record drawing operations, optimise the order and replay them.
+	 *
+	 * Application code tends to draw in widget order, which is rarely the cheapest order for the panel. The
+	 * draw list records the operations into a fixed size array of compact entries, each of which carries
+	 * its own colour and bounding box. optimise() then does the following:
+	 *
+	 *  - Each entry is moved back to join the nearest earlier entry of the same colour, provided that it
+	 *    does not overlap any of the entries that it moves past. The output on the panel is unchanged.
+	 *  - Entries of the same colour can be drawn in any order, so each group of same coloured entries is
+	 *    sorted top to bottom, left to right.
+	 *  - Rectangle fills in the same group that abut or overlap and share an edge are merged into one fill.
+	 *
+	 * replay() then sends the list to the graphics library with one setForeground() per group of colours.
+	 * A list may be optimised once and replayed as many times as you like. The foreground colour of the graphics
+	 * library is left at the colour of the last entry.
+	 *
+	 * If the list fills up then it is flushed automatically before the new entry is recorded.
+	 *
+	 * @tparam TGraphicsLibrary The graphics library implementation.
+	 * @tparam TCapacity The maximum number of entries in the list.
+	 * @ingroup GraphicsLibrary
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	class DrawList {
+
+		public:
+			typedef typename TGraphicsLibrary::TColour TColour;
+
+		protected:
+
+			/*
+			 * Entry operation codes
+			 */
+
+			enum {
+				OP_FILL_RECTANGLE,					// X,Y,Width,Height
+				OP_LINE,										// X1,Y1,X2,Y2
+				OP_ELLIPSE,									// CenterX,CenterY,Width,Height
+				OP_FILLED_ELLIPSE,					// CenterX,CenterY,Width,Height
+				OP_CIRCLE										// CenterX,CenterY,Radius
+			};
+
+			/*
+			 * A recorded operation
+			 */
+
+			struct Entry {
+				uint8_t Opcode;
+				TColour Colour;
+				int16_t Params[4];
+			};
+
+			TGraphicsLibrary *_gl;
+			TColour _foreground;
+			TColour _background;
+			Entry _entries[TCapacity];
+			uint8_t _count;
+
+		protected:
+			Entry& addEntry(uint8_t opcode,TColour cr,int16_t p0,int16_t p1,int16_t p2,int16_t p3);
+			void groupColours();
+			void sortGroup(uint8_t first,uint8_t last);
+			void mergeGroup(uint8_t first,uint8_t& last);
+
+			static void getBounds(const Entry& entry,Rectangle& rc);
+			static bool overlaps(const Entry& e1,const Entry& e2);
+			static bool canMerge(const Entry& e1,const Entry& e2,Rectangle& result);
+
+		public:
+			DrawList(TGraphicsLibrary *gl);
+
+			// colour choices
+
+			void setForeground(TColour cr);
+			void setBackground(TColour cr);
+
+			// recorded operations
+
+			void plotPoint(const Point& p);
+			void fillRectangle(const Rectangle& rc);
+			void clearRectangle(const Rectangle& rc);
+			void drawRectangle(const Rectangle& rc);
+			void drawLine(const Point& p1,const Point& p2);
+			void drawEllipse(const Point& center,const Size& size);
+			void fillEllipse(const Point& center,const Size& size);
+			void drawCircle(const Point& center,int16_t radius);
+
+			// list management
+
+			void optimise();
+			void replay() const;
+			void flush();
+			void clear();
+			uint8_t getCount() const;
+	};
+
+
+	/**
+	 * Constructor
+	 * @param gl A pointer to the graphics library implementation.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline DrawList<TGraphicsLibrary,TCapacity>::DrawList(TGraphicsLibrary *gl)
+		: _gl(gl),
+		  _foreground(0xffffff),
+		  _background(0),
+		  _count(0) {
+	}
+
+
+	/**
+	 * Set the foreground colour for operations that are recorded from now on
+	 * @param cr The colour as rrggbb
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline void DrawList<TGraphicsLibrary,TCapacity>::setForeground(TColour cr) {
+		_foreground=cr;
+	}
+
+
+	/**
+	 * Set the background colour for clearRectangle() operations that are recorded from now on
+	 * @param cr The colour as rrggbb
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline void DrawList<TGraphicsLibrary,TCapacity>::setBackground(TColour cr) {
+		_background=cr;
+	}
+
+
+	/**
+	 * Record a single point in the foreground colour
+	 * @param p The point
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline void DrawList<TGraphicsLibrary,TCapacity>::plotPoint(const Point& p) {
+		addEntry(OP_FILL_RECTANGLE,_foreground,p.X,p.Y,1,1);
+	}
+
+
+	/**
+	 * Record a rectangle fill in the foreground colour
+	 * @param rc The rectangle
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline void DrawList<TGraphicsLibrary,TCapacity>::fillRectangle(const Rectangle& rc) {
+		addEntry(OP_FILL_RECTANGLE,_foreground,rc.X,rc.Y,rc.Width,rc.Height);
+	}
+
+
+	/**
+	 * Record a rectangle fill in the background colour
+	 * @param rc The rectangle
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline void DrawList<TGraphicsLibrary,TCapacity>::clearRectangle(const Rectangle& rc) {
+		addEntry(OP_FILL_RECTANGLE,_background,rc.X,rc.Y,rc.Width,rc.Height);
+	}
+
+
+	/**
+	 * Record a rectangle outline as its 4 edge fills, the same way that the graphics library draws it
+	 * @param rect The rectangle
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline void DrawList<TGraphicsLibrary,TCapacity>::drawRectangle(const Rectangle& rect) {
+
+		addEntry(OP_FILL_RECTANGLE,_foreground,rect.X,rect.Y,rect.Width,1);
+		addEntry(OP_FILL_RECTANGLE,_foreground,rect.X,rect.Y+rect.Height-1,rect.Width,1);
+		addEntry(OP_FILL_RECTANGLE,_foreground,rect.X,rect.Y,1,rect.Height);
+		addEntry(OP_FILL_RECTANGLE,_foreground,rect.X+rect.Width-1,rect.Y,1,rect.Height);
+	}
+
+
+	/**
+	 * Record a line. Horizontal and vertical lines are recorded as rectangle fills so that they can be merged.
+	 * @param p1 The first end of the line.
+	 * @param p2 The other end of the line.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline void DrawList<TGraphicsLibrary,TCapacity>::drawLine(const Point& p1,const Point& p2) {
+
+		if(p1.X==p2.X)
+			addEntry(OP_FILL_RECTANGLE,_foreground,p1.X,p1.Y<p2.Y ? p1.Y : p2.Y,1,(p1.Y<p2.Y ? p2.Y-p1.Y : p1.Y-p2.Y)+1);
+		else if(p1.Y==p2.Y)
+			addEntry(OP_FILL_RECTANGLE,_foreground,p1.X<p2.X ? p1.X : p2.X,p1.Y,(p1.X<p2.X ? p2.X-p1.X : p1.X-p2.X)+1,1);
+		else
+			addEntry(OP_LINE,_foreground,p1.X,p1.Y,p2.X,p2.Y);
+	}
+
+
+	/**
+	 * Record an ellipse outline
+	 * @param center The center point.
+	 * @param size The radius width and height.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline void DrawList<TGraphicsLibrary,TCapacity>::drawEllipse(const Point& center,const Size& size) {
+		addEntry(OP_ELLIPSE,_foreground,center.X,center.Y,size.Width,size.Height);
+	}
+
+
+	/**
+	 * Record a filled ellipse
+	 * @param center The center point.
+	 * @param size The radius width and height.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline void DrawList<TGraphicsLibrary,TCapacity>::fillEllipse(const Point& center,const Size& size) {
+		addEntry(OP_FILLED_ELLIPSE,_foreground,center.X,center.Y,size.Width,size.Height);
+	}
+
+
+	/**
+	 * Record a circle outline
+	 * @param center The center point.
+	 * @param radius The radius.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline void DrawList<TGraphicsLibrary,TCapacity>::drawCircle(const Point& center,int16_t radius) {
+		addEntry(OP_CIRCLE,_foreground,center.X,center.Y,radius,0);
+	}
+
+
+	/**
+	 * Add an entry to the list, flushing it first if it is full
+	 * @return A reference to the new entry
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline typename DrawList<TGraphicsLibrary,TCapacity>::Entry& DrawList<TGraphicsLibrary,TCapacity>::addEntry(
+			uint8_t opcode,TColour cr,int16_t p0,int16_t p1,int16_t p2,int16_t p3) {
+
+		if(_count==TCapacity)
+			flush();
+
+		Entry& entry=_entries[_count++];
+
+		entry.Opcode=opcode;
+		entry.Colour=cr;
+		entry.Params[0]=p0;
+		entry.Params[1]=p1;
+		entry.Params[2]=p2;
+		entry.Params[3]=p3;
+
+		return entry;
+	}
+
+
+	/**
+	 * Reorder and merge the entries to reduce the work done by replay(). The output is the same as
+	 * replaying the original list.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline void DrawList<TGraphicsLibrary,TCapacity>::optimise() {
+
+		uint8_t first,last;
+
+		groupColours();
+
+		// sort and merge within each group of the same colour
+
+		for(first=0;first<_count;first=last) {
+
+			for(last=first+1;last<_count && _entries[last].Colour==_entries[first].Colour;last++);
+
+			sortGroup(first,last);
+			mergeGroup(first,last);
+		}
+	}
+
+
+	/**
+	 * Move each entry back to follow the nearest earlier entry of the same colour if it can get there
+	 * without passing over an entry that it overlaps.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline void DrawList<TGraphicsLibrary,TCapacity>::groupColours() {
+
+		uint8_t i,j,target;
+
+		for(i=1;i<_count;i++) {
+
+			if(_entries[i].Colour==_entries[i-1].Colour)
+				continue;
+
+			// search back for a matching colour, giving up at the first overlap
+
+			for(j=i-1;;j--) {
+
+				if(_entries[j].Colour==_entries[i].Colour) {
+
+					// move entry i to j+1
+
+					Entry entry=_entries[i];
+
+					for(target=i;target>j+1;target--)
+						_entries[target]=_entries[target-1];
+
+					_entries[j+1]=entry;
+					break;
+				}
+
+				if(j==0 || overlaps(_entries[j],_entries[i]))
+					break;
+			}
+		}
+	}
+
+
+	/**
+	 * Insertion sort a group of entries that share the same colour by the top-left of their bounding box.
+	 * @param first The first entry in the group
+	 * @param last One past the last entry in the group
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline void DrawList<TGraphicsLibrary,TCapacity>::sortGroup(uint8_t first,uint8_t last) {
+
+		uint8_t i,j;
+		Rectangle rc,rcPrev;
+
+		for(i=first+1;i<last;i++) {
+
+			Entry entry=_entries[i];
+			getBounds(entry,rc);
+
+			for(j=i;j>first;j--) {
+
+				getBounds(_entries[j-1],rcPrev);
+
+				if(rcPrev.Y<rc.Y || (rcPrev.Y==rc.Y && rcPrev.X<=rc.X))
+					break;
+
+				_entries[j]=_entries[j-1];
+			}
+
+			_entries[j]=entry;
+		}
+	}
+
+
+	/**
+	 * Merge the rectangle fills in a group of entries that share the same colour. Entries that are merged
+	 * away are removed from the list.
+	 * @param first The first entry in the group
+	 * @param last One past the last entry in the group. Updated if the group shrinks.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline void DrawList<TGraphicsLibrary,TCapacity>::mergeGroup(uint8_t first,uint8_t& last) {
+
+		uint8_t i,j,k;
+		bool merged;
+		Rectangle rc;
+
+		do {
+
+			merged=false;
+
+			for(i=first;i<last;i++) {
+
+				for(j=i+1;j<last;j++) {
+
+					if(canMerge(_entries[i],_entries[j],rc)) {
+
+						_entries[i].Params[0]=rc.X;
+						_entries[i].Params[1]=rc.Y;
+						_entries[i].Params[2]=rc.Width;
+						_entries[i].Params[3]=rc.Height;
+
+						// remove entry j
+
+						for(k=j;k<_count-1;k++)
+							_entries[k]=_entries[k+1];
+
+						_count--;
+						last--;
+						j--;
+
+						merged=true;
+					}
+				}
+			}
+
+		} while(merged);
+	}
+
+
+	/**
+	 * Get the bounding box of an entry. Ellipse and circle boxes include a one pixel margin.
+	 * @param entry The entry
+	 * @param rc Where to store the bounding box
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline void DrawList<TGraphicsLibrary,TCapacity>::getBounds(const Entry& entry,Rectangle& rc) {
+
+		const int16_t *p=entry.Params;
+
+		switch(entry.Opcode) {
+
+			case OP_FILL_RECTANGLE:
+				rc.X=p[0];
+				rc.Y=p[1];
+				rc.Width=p[2];
+				rc.Height=p[3];
+				break;
+
+			case OP_LINE:
+				rc.X=p[0]<p[2] ? p[0] : p[2];
+				rc.Y=p[1]<p[3] ? p[1] : p[3];
+				rc.Width=(p[0]<p[2] ? p[2]-p[0] : p[0]-p[2])+1;
+				rc.Height=(p[1]<p[3] ? p[3]-p[1] : p[1]-p[3])+1;
+				break;
+
+			case OP_CIRCLE:
+				rc.X=p[0]-p[2]-1;
+				rc.Y=p[1]-p[2]-1;
+				rc.Width=rc.Height=2*p[2]+3;
+				break;
+
+			default:
+				rc.X=p[0]-p[2]-1;
+				rc.Y=p[1]-p[3]-1;
+				rc.Width=2*p[2]+3;
+				rc.Height=2*p[3]+3;
+				break;
+		}
+	}
+
+
+	/**
+	 * Check if the bounding boxes of two entries overlap
+	 * @return true if they overlap
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline bool DrawList<TGraphicsLibrary,TCapacity>::overlaps(const Entry& e1,const Entry& e2) {
+
+		Rectangle rc1,rc2;
+
+		getBounds(e1,rc1);
+		getBounds(e2,rc2);
+
+		return rc1.X<rc2.X+rc2.Width && rc2.X<rc1.X+rc1.Width &&
+		       rc1.Y<rc2.Y+rc2.Height && rc2.Y<rc1.Y+rc1.Height;
+	}
+
+
+	/**
+	 * Check if two rectangle fills can be replaced by a single fill. That is possible if they share the same
+	 * top and bottom and touch horizontally, share the same left and right and touch vertically, or if
+	 * one is inside the other.
+	 * @param e1 The first entry
+	 * @param e2 The second entry
+	 * @param result The merged rectangle
+	 * @return true if they can be merged
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline bool DrawList<TGraphicsLibrary,TCapacity>::canMerge(const Entry& e1,const Entry& e2,Rectangle& result) {
+
+		int16_t x1,y1,w1,h1,x2,y2,w2,h2;
+
+		if(e1.Opcode!=OP_FILL_RECTANGLE || e2.Opcode!=OP_FILL_RECTANGLE)
+			return false;
+
+		x1=e1.Params[0]; y1=e1.Params[1]; w1=e1.Params[2]; h1=e1.Params[3];
+		x2=e2.Params[0]; y2=e2.Params[1]; w2=e2.Params[2]; h2=e2.Params[3];
+
+		if(y1==y2 && h1==h2 && x1<=x2+w2 && x2<=x1+w1) {
+			result.X=x1<x2 ? x1 : x2;
+			result.Y=y1;
+			result.Width=(x1+w1>x2+w2 ? x1+w1 : x2+w2)-result.X;
+			result.Height=h1;
+			return true;
+		}
+
+		if(x1==x2 && w1==w2 && y1<=y2+h2 && y2<=y1+h1) {
+			result.X=x1;
+			result.Y=y1<y2 ? y1 : y2;
+			result.Width=w1;
+			result.Height=(y1+h1>y2+h2 ? y1+h1 : y2+h2)-result.Y;
+			return true;
+		}
+
+		if(x1<=x2 && y1<=y2 && x1+w1>=x2+w2 && y1+h1>=y2+h2) {
+			result=Rectangle(x1,y1,w1,h1);
+			return true;
+		}
+
+		if(x2<=x1 && y2<=y1 && x2+w2>=x1+w1 && y2+h2>=y1+h1) {
+			result=Rectangle(x2,y2,w2,h2);
+			return true;
+		}
+
+		return false;
+	}
+
+
+	/**
+	 * Send the list to the graphics library. The list is not cleared so it can be replayed again.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline void DrawList<TGraphicsLibrary,TCapacity>::replay() const {
+
+		const Entry *entry;
+		const int16_t *p;
+
+		for(entry=_entries;entry!=_entries+_count;entry++) {
+
+			// only change colour at the start of each group
+
+			if(entry==_entries || entry->Colour!=entry[-1].Colour)
+				_gl->setForeground(entry->Colour);
+
+			p=entry->Params;
+
+			switch(entry->Opcode) {
+
+				case OP_FILL_RECTANGLE:
+					_gl->fillRectangle(Rectangle(p[0],p[1],p[2],p[3]));
+					break;
+
+				case OP_LINE:
+					_gl->drawLine(Point(p[0],p[1]),Point(p[2],p[3]));
+					break;
+
+				case OP_ELLIPSE:
+					_gl->drawEllipse(Point(p[0],p[1]),Size(p[2],p[3]));
+					break;
+
+				case OP_FILLED_ELLIPSE:
+					_gl->fillEllipse(Point(p[0],p[1]),Size(p[2],p[3]));
+					break;
+
+				case OP_CIRCLE:
+					_gl->drawCircle(Point(p[0],p[1]),p[2]);
+					break;
+			}
+		}
+	}
+
+
+	/**
+	 * Optimise the list, replay it and then clear it
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline void DrawList<TGraphicsLibrary,TCapacity>::flush() {
+		optimise();
+		replay();
+		clear();
+	}
+
+
+	/**
+	 * Discard all the recorded entries
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline void DrawList<TGraphicsLibrary,TCapacity>::clear() {
+		_count=0;
+	}
+
+
+	/**
+	 * Get the number of entries in the list
+	 * @return The number of entries.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TCapacity>
+	inline uint8_t DrawList<TGraphicsLibrary,TCapacity>::getCount() const {
+		return _count;
+	}
+}
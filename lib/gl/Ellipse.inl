@@ -53,6 +53,11 @@ namespace lcd {
 		int32_t dxt=2 * b2 * x,dyt=-2 * a2 * y;
 		int32_t d2xt=2 * b2,d2yt=2 * a2;
 
+		// nothing to do if the bounding box is outside the clip rectangle
+
+		if(!_clip.intersects(Rectangle(center.X-size.Width-1,center.Y-size.Height-1,2*size.Width+3,2*size.Height+3)))
+			return;
+
 		if(size.Height==0) {
 			fillRectangle(NormalizedRectangle(center.X-size.Width,center.Y,2*size.Width+ 1,1));
 			return;
@@ -107,13 +112,22 @@ namespace lcd {
 	 * Draw an ellipse with the foreground colour using the fast bresenham algorithm. This method is an implementation of
 	 * the pseudo-code in the paper "A Fast Bresenham Type Algorithm For Drawing Ellipses" by John Kennedy.
 	 *
+	 * Rather than plotting each point individually the adjacent points are collected into runs. The first half of each
+	 * quadrant is steep so it produces vertical runs, the second half produces horizontal runs. Each run is mirrored
+	 * into the 4 quadrants and output as a 1 pixel wide or high rectangle fill, which trims it to the clip rectangle.
+	 *
 	 * @param center The center point.
 	 * @param size The radius width and height.
 	 */
 
 	template<class TDevice,class TAccessMode>
 	inline void GraphicsLibrary<TDevice,TAccessMode>::drawEllipse(const Point& center,const Size& size) const {
-		int32_t x,y,xchange,ychange,ellipseError,twoASquare,twoBSquare,stoppingX,stoppingY,width,height;
+		int32_t x,y,xchange,ychange,ellipseError,twoASquare,twoBSquare,stoppingX,stoppingY,width,height,runStart;
+
+		// nothing to do if the bounding box is outside the clip rectangle
+
+		if(!_clip.intersects(Rectangle(center.X-size.Width-1,center.Y-size.Height-1,2*size.Width+3,2*size.Height+3)))
+			return;
 
 		width=size.Width;
 		height=size.Height;
@@ -131,9 +145,12 @@ namespace lcd {
 		stoppingX=twoBSquare * width;
 		stoppingY=0;
 
+		// Y increments every step, collect vertical runs for each X
+
+		runStart=y;
+
 		while(stoppingX >= stoppingY) {
 
-			plot4EllipsePoints(center.X,center.Y,x,y);
 			y++;
 			stoppingY+=twoASquare;
 			ellipseError+=ychange;
@@ -141,6 +158,10 @@ namespace lcd {
 			ychange+=twoASquare;
 
 			if(2 * ellipseError + xchange > 0) {
+
+				plot4EllipseColumns(center.X,center.Y,x,runStart,y-1);
+				runStart=y;
+
 				x--;
 				stoppingX-=twoBSquare;
 				ellipseError+=xchange;
@@ -148,6 +169,9 @@ namespace lcd {
 			}
 		}
 
+		if(y>runStart)
+			plot4EllipseColumns(center.X,center.Y,x,runStart,y-1);
+
 		x=0;
 		y=height;
 
@@ -158,33 +182,123 @@ namespace lcd {
 		stoppingX=0;
 		stoppingY=twoASquare * height;
 
+		// X increments every step, collect horizontal runs for each Y
+
+		runStart=x;
+
 		while(stoppingX <= stoppingY) {
-			plot4EllipsePoints(center.X,center.Y,x,y);
 			x++;
 			stoppingX+=twoBSquare;
 			ellipseError+=xchange;
 			xchange+=twoBSquare;
 
 			if((2 * ellipseError + ychange) > 0) {
+
+				plot4EllipseRows(center.X,center.Y,runStart,x-1,y);
+				runStart=x;
+
 				y--;
 				stoppingY-=twoASquare;
 				ellipseError+=ychange;
 				ychange+=twoASquare;
 			}
 		}
+
+		if(x>runStart)
+			plot4EllipseRows(center.X,center.Y,runStart,x-1,y);
+	}
+
+
+	/**
+	 * Draw a circle with the foreground colour using the midpoint algorithm.
+	 *
+	 * Only the octant from the top of the circle to 45 degrees is calculated. X increments on every step so the
+	 * points are collected into horizontal runs and each run is mirrored into the other 7 octants, where it becomes
+	 * a horizontal or a vertical run depending on the octant.
+	 *
+	 * @param center The center point.
+	 * @param radius The radius of the circle.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::drawCircle(const Point& center,int16_t radius) const {
+
+		int16_t x,y,d,runStart;
+
+		// nothing to do if the bounding box is outside the clip rectangle
+
+		if(!_clip.intersects(Rectangle(center.X-radius,center.Y-radius,2*radius+1,2*radius+1)))
+			return;
+
+		if(radius<=0) {
+			plotPoint(center);
+			return;
+		}
+
+		x=runStart=0;
+		y=radius;
+		d=1-radius;
+
+		while(x<=y) {
+
+			if(d<0)
+				d+=2*x+3;
+			else {
+
+				// Y is about to change, output the run for this Y in all 8 octants
+
+				plot4EllipseRows(center.X,center.Y,runStart,x,y);
+				plot4EllipseColumns(center.X,center.Y,y,runStart,x);
+
+				d+=2*(x-y)+5;
+				y--;
+				runStart=x+1;
+			}
+
+			x++;
+		}
+
+		if(x>runStart) {
+			plot4EllipseRows(center.X,center.Y,runStart,x-1,y);
+			plot4EllipseColumns(center.X,center.Y,y,runStart,x-1);
+		}
 	}
 
 
 	/*
-	 * Utility function for the bresenham algorithm.
+	 * Utility function for the outline algorithms. Draw a vertical run mirrored into the 4 quadrants.
 	 */
 
 	template<class TDevice,class TAccessMode>
-	inline void GraphicsLibrary<TDevice,TAccessMode>::plot4EllipsePoints(int16_t cx,int16_t cy,int16_t x,int16_t y) const {
+	inline void GraphicsLibrary<TDevice,TAccessMode>::plot4EllipseColumns(int16_t cx,int16_t cy,int16_t x,int16_t y1,int16_t y2) const {
+
+		int16_t length=y2-y1+1;
+
+		fillRectangle(Rectangle(cx + x,cy + y1,1,length)); // run in quadrant 1
+		fillRectangle(Rectangle(cx + x,cy - y2,1,length)); // run in quadrant 4
+
+		if(x) {
+			fillRectangle(Rectangle(cx - x,cy + y1,1,length)); // run in quadrant 2
+			fillRectangle(Rectangle(cx - x,cy - y2,1,length)); // run in quadrant 3
+		}
+	}
 
-		plotPoint(Point(cx + x,cy + y)); // point in quadrant 1
-		plotPoint(Point(cx - x,cy + y)); // point in quadrant 2
-		plotPoint(Point(cx - x,cy - y)); // point in quadrant 3
-		plotPoint(Point(cx + x,cy - y)); // point in quadrant 4
+
+	/*
+	 * Utility function for the outline algorithms. Draw a horizontal run mirrored into the 4 quadrants.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::plot4EllipseRows(int16_t cx,int16_t cy,int16_t x1,int16_t x2,int16_t y) const {
+
+		int16_t length=x2-x1+1;
+
+		fillRectangle(Rectangle(cx + x1,cy + y,length,1)); // run in quadrant 1
+		fillRectangle(Rectangle(cx - x2,cy + y,length,1)); // run in quadrant 2
+
+		if(y) {
+			fillRectangle(Rectangle(cx - x2,cy - y,length,1)); // run in quadrant 3
+			fillRectangle(Rectangle(cx + x1,cy - y,length,1)); // run in quadrant 4
+		}
 	}
 }
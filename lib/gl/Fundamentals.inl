@@ -29,6 +29,16 @@
 
 namespace lcd {
 
+	/**
+	 * Constructor. The clip rectangle starts out as the whole panel.
+	 */
+
+	template<class TDevice,class TDeviceAccessMode>
+	inline GraphicsLibrary<TDevice,TDeviceAccessMode>::GraphicsLibrary() {
+		resetClip();
+	}
+
+
 	/**
 	 * Set the foreground colour
 	 * @param cr The foreground colour.
@@ -74,22 +84,96 @@ namespace lcd {
 
 
 	/**
-	 * Clear screen to the background colour
+	 * Set the clip rectangle. All drawing operations are restricted to this area. The rectangle is trimmed
+	 * to the panel so that nothing can ever be written outside the panel.
+	 * @param rc The new clip rectangle.
 	 */
 
 	template<class TDevice,class TDeviceAccessMode>
-	inline void GraphicsLibrary<TDevice,TDeviceAccessMode>::clearScreen() const {
+	inline void GraphicsLibrary<TDevice,TDeviceAccessMode>::setClip(const Rectangle& rc) {
+
+		Rectangle clipped(rc);
+
+		// an empty clip rectangle means that nothing gets drawn
+
+		resetClip();
+
+		if(clipRectangle(clipped))
+			_clip=clipped;
+		else
+			_clip.Width=_clip.Height=0;
+	}
+
+
+	/**
+	 * Reset the clip rectangle to the whole panel
+	 */
+
+	template<class TDevice,class TDeviceAccessMode>
+	inline void GraphicsLibrary<TDevice,TDeviceAccessMode>::resetClip() {
+		_clip=Rectangle(0,0,this->getWidth(),this->getHeight());
+	}
+
+
+	/**
+	 * Get the current clip rectangle
+	 * @return The clip rectangle.
+	 */
+
+	template<class TDevice,class TDeviceAccessMode>
+	inline const Rectangle& GraphicsLibrary<TDevice,TDeviceAccessMode>::getClip() const {
+		return _clip;
+	}
+
+
+	/**
+	 * Trim a rectangle to the clip rectangle.
+	 * @param rc The rectangle to trim, updated in place.
+	 * @return false if nothing is left.
+	 */
+
+	template<class TDevice,class TDeviceAccessMode>
+	inline bool GraphicsLibrary<TDevice,TDeviceAccessMode>::clipRectangle(Rectangle& rc) const {
+
+		int16_t right,bottom;
+
+		right=Min<int16_t>(rc.X+rc.Width,_clip.X+_clip.Width);
+		bottom=Min<int16_t>(rc.Y+rc.Height,_clip.Y+_clip.Height);
+
+		rc.X=Max(rc.X,_clip.X);
+		rc.Y=Max(rc.Y,_clip.Y);
+
+		if(right<=rc.X || bottom<=rc.Y)
+			return false;
+
+		rc.Width=right-rc.X;
+		rc.Height=bottom-rc.Y;
+
+		return true;
+	}
+
 
-		this->moveTo(
-				Rectangle(
-						0,
-						0,
-						this->getWidth(),
-						this->getHeight()
-				)
-		);
+	/**
+	 * Check if a point is inside the clip rectangle
+	 * @param x The x co-ord
+	 * @param y The y co-ord
+	 * @return true if the point can be drawn.
+	 */
+
+	template<class TDevice,class TDeviceAccessMode>
+	inline bool GraphicsLibrary<TDevice,TDeviceAccessMode>::isVisible(int16_t x,int16_t y) const {
+		return x>=_clip.X && x<_clip.X+_clip.Width && y>=_clip.Y && y<_clip.Y+_clip.Height;
+	}
 
-		this->fillPixels((int32_t)TDevice::LONG_SIDE * (int32_t)TDevice::SHORT_SIDE,_background);
+
+	/**
+	 * Clear the area of the screen inside the clip rectangle to the background colour. With the default
+	 * clip rectangle this is the whole screen.
+	 */
+
+	template<class TDevice,class TDeviceAccessMode>
+	inline void GraphicsLibrary<TDevice,TDeviceAccessMode>::clearScreen() const {
+		fillClippedRectangle(_clip,_background);
 	}
 
 
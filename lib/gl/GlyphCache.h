@@ -0,0 +1,567 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file GlyphCache.h
+ * @brief A least recently used cache of expanded glyphs
+ * @ingroup GraphicsLibrary
+ */
+
+#pragma once
+
+
+namespace lcd {
+
+	/**
+	 * @brief Keep recently drawn glyphs in SRAM, ready to be written with a block transfer.
+	 *
+	 * Writing a character from an LzgFont decodes it from flash every time, and writing one from a bitmap
+	 * Font expands it a bit at a time. Text that is redrawn often, such as a clock or a meter reading,
+	 * keeps doing the same work. This cache holds up to TEntries glyphs in the device's native pixel format.
+	 * A glyph that is found in the cache is written with one window update and one block transfer.
+	 *
+	 * Each entry has a fixed size of TEntryBytes. Glyphs that need more than that, and glyphs that are not
+	 * entirely inside the clip rectangle, are passed straight through to the graphics library. When the
+	 * cache is full the least recently used glyph is replaced.
+	 *
+	 * LZG glyphs are stored with their colours. Bitmap glyphs are expanded in the foreground and background
+	 * colours of the cache, so set the colours with the cache's setForeground() and setBackground() methods.
+	 * These set the graphics library's colours too, and changing them drops the cached bitmap glyphs.
+	 *
+	 * @tparam TGraphicsLibrary The graphics library implementation.
+	 * @tparam TEntries The number of glyphs in the cache, up to 255.
+	 * @tparam TEntryBytes The space for each glyph, e.g. width x height x 2 for a 64K colour panel.
+	 * @ingroup GraphicsLibrary
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	class GlyphCache {
+
+		public:
+			typedef typename TGraphicsLibrary::TColour TColour;
+			typedef typename TGraphicsLibrary::UnpackedColour UnpackedColour;
+			typedef SramStreamAccessMode<GlyphCache> TCaptureAccessMode;
+
+		protected:
+
+			/*
+			 * A cached glyph. An empty entry has no font.
+			 */
+
+			struct Entry {
+				const FontBase *Font;
+				uint8_t Code;
+			};
+
+			/*
+			 * The pixels of a cached glyph. Bitmap glyphs are expanded into unpacked colours and LZG
+			 * glyphs are decoded as bytes in the panel's format.
+			 */
+
+			union EntryPixels {
+				UnpackedColour Colours[TEntryBytes/sizeof(UnpackedColour)];
+				uint8_t Bytes[TEntryBytes];
+			};
+
+			TGraphicsLibrary *_gl;
+			TColour _foreground;
+			TColour _background;
+			UnpackedColour _unpackedForeground;
+			UnpackedColour _unpackedBackground;
+			Entry _entries[TEntries];
+			uint8_t _order[TEntries];							// entry indexes, most recently used first
+			EntryPixels _pixels[TEntries];
+			uint16_t _hits;
+			uint16_t _misses;
+
+		protected:
+			bool findEntry(const FontBase& font,uint8_t code,uint8_t& index);
+			uint8_t claimEntry(const FontBase& font,uint8_t code);
+			void moveToFront(uint8_t position);
+			void dropBitmapEntries();
+			void expandGlyph(const FontChar& fc,uint16_t numPixels,UnpackedColour *pixels) const;
+			bool isInsideClip(const Rectangle& rc) const;
+
+		public:
+			GlyphCache(TGraphicsLibrary *gl);
+
+			// colour choices
+
+			void setForeground(TColour cr);
+			void setBackground(TColour cr);
+
+			// text output - pixel fonts
+
+			Size writeString(const Point& p,const Font& font,const char *str);
+			void writeCharacter(const Point& p,const Font& font,const FontChar& fc);
+
+			// text output - LZG fonts
+
+			Size writeString(const Point& p,const LzgFont& font,const char *str);
+			void writeCharacter(const Point& p,const LzgFont& font,const FontChar& fc);
+
+			template<class TContext> Size writeString(const Point& p,const LzgFont& font,const char *str,TContext& context);
+			template<class TContext> void writeCharacter(const Point& p,const LzgFont& font,const FontChar& fc,TContext& context);
+
+			// cache management
+
+			void clear();
+			uint16_t getHits() const;
+			uint16_t getMisses() const;
+	};
+
+
+	/**
+	 * Constructor. The colours default to white on black and are set in the graphics library.
+	 * @param gl A pointer to the graphics library implementation.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	inline GlyphCache<TGraphicsLibrary,TEntries,TEntryBytes>::GlyphCache(TGraphicsLibrary *gl)
+		: _gl(gl),
+		  _foreground(0xffffff),
+		  _background(0) {
+
+		_gl->setForeground(_foreground);
+		_gl->setBackground(_background);
+
+		_gl->unpackColour(_foreground,_unpackedForeground);
+		_gl->unpackColour(_background,_unpackedBackground);
+
+		clear();
+	}
+
+
+	/**
+	 * Set the foreground colour here and in the graphics library. Cached bitmap glyphs are dropped if
+	 * the colour changes.
+	 * @param cr The colour as rrggbb
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	inline void GlyphCache<TGraphicsLibrary,TEntries,TEntryBytes>::setForeground(TColour cr) {
+
+		_gl->setForeground(cr);
+
+		if(cr!=_foreground) {
+			_foreground=cr;
+			_gl->unpackColour(cr,_unpackedForeground);
+			dropBitmapEntries();
+		}
+	}
+
+
+	/**
+	 * Set the background colour here and in the graphics library. Cached bitmap glyphs are dropped if
+	 * the colour changes.
+	 * @param cr The colour as rrggbb
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	inline void GlyphCache<TGraphicsLibrary,TEntries,TEntryBytes>::setBackground(TColour cr) {
+
+		_gl->setBackground(cr);
+
+		if(cr!=_background) {
+			_background=cr;
+			_gl->unpackColour(cr,_unpackedBackground);
+			dropBitmapEntries();
+		}
+	}
+
+
+	/**
+	 * Write a null terminated string from a bitmap font. The output is the same as the graphics
+	 * library's writeString(), including the background fill of the spacing between characters.
+	 * @param p The upper-left point to write out at.
+	 * @param font The font to write with.
+	 * @param str The character string to write out.
+	 * @return the bounding size of the string in pixels.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	inline Size GlyphCache<TGraphicsLibrary,TEntries,TEntryBytes>::writeString(const Point& p,const Font& font,const char *str) {
+
+		Point pos(p);
+		FontChar fc;
+		uint8_t spacing;
+		Size s;
+
+		s.Height=font.getHeight();
+		s.Width=0;
+
+		spacing=font.getCharacterSpacing();
+
+		while(*str) {
+
+			font.getCharacter(*str++,fc);
+			writeCharacter(pos,font,fc);
+
+			pos.X+=fc.PixelWidth;
+
+			if(spacing) {
+				_gl->clearRectangle(Rectangle(pos.X,pos.Y,spacing,font.getHeight()));
+				pos.X+=spacing;
+			}
+
+			s.Width+=fc.PixelWidth+spacing;
+		}
+
+		return s;
+	}
+
+
+	/**
+	 * Write a single character from a bitmap font, from the cache if it's there.
+	 * @param p The upper-left point to write out at.
+	 * @param font The font that the character comes from.
+	 * @param fc The FontChar structure defining the character.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	inline void GlyphCache<TGraphicsLibrary,TEntries,TEntryBytes>::writeCharacter(const Point& p,const Font& font,const FontChar& fc) {
+
+		Rectangle rc(p.X,p.Y,fc.PixelWidth,font.getHeight());
+		uint16_t numPixels;
+		uint8_t index;
+
+		numPixels=fc.PixelWidth*font.getHeight();
+
+		if(numPixels*sizeof(UnpackedColour)>TEntryBytes || !isInsideClip(rc)) {
+			_gl->writeCharacter(p,font,fc);
+			return;
+		}
+
+		if(!findEntry(font,fc.Code,index)) {
+			index=claimEntry(font,fc.Code);
+			expandGlyph(fc,numPixels,_pixels[index].Colours);
+		}
+
+		_gl->moveTo(rc);
+		_gl->beginWriting();
+		_gl->writePixels(_pixels[index].Colours,numPixels);
+	}
+
+
+	/**
+	 * Write a null terminated string from an LZG font. A default LzgDecoderContext is set up on
+	 * the stack for the glyphs that have to be decoded.
+	 * @param p The upper-left point to write out at.
+	 * @param font The font to write with.
+	 * @param str The character string to write out.
+	 * @return the bounding size of the string in pixels.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	inline Size GlyphCache<TGraphicsLibrary,TEntries,TEntryBytes>::writeString(const Point& p,const LzgFont& font,const char *str) {
+
+		LzgDecoderContext<> context;
+		return writeString(p,font,str,context);
+	}
+
+
+	/**
+	 * Write a null terminated string from an LZG font, decoding the glyphs that are not in the cache
+	 * with the history window in the given context.
+	 * @param p The upper-left point to write out at.
+	 * @param font The font to write with.
+	 * @param str The character string to write out.
+	 * @param context The LzgDecoderContext to decode with.
+	 * @return the bounding size of the string in pixels.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	template<class TContext>
+	inline Size GlyphCache<TGraphicsLibrary,TEntries,TEntryBytes>::writeString(const Point& p,const LzgFont& font,const char *str,TContext& context) {
+
+		Point pos(p);
+		FontChar fc;
+		int16_t width;
+		Size s;
+
+		s.Height=font.getHeight();
+		s.Width=0;
+
+		while(*str) {
+
+			font.getCharacter(*str++,fc);
+
+			if(fc.Code!=' ')										// space is special and never has any data but does have a size
+				writeCharacter(pos,font,fc,context);
+
+			width=fc.PixelWidth+font.getCharacterSpacing();
+			pos.X+=width;
+			s.Width+=width;
+		}
+
+		return s;
+	}
+
+
+	/**
+	 * Write a single character from an LZG font, from the cache if it's there. A default
+	 * LzgDecoderContext is set up on the stack.
+	 * @param p The upper-left point to write out at.
+	 * @param font The font that the character comes from.
+	 * @param fc The FontChar structure defining the character.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	inline void GlyphCache<TGraphicsLibrary,TEntries,TEntryBytes>::writeCharacter(const Point& p,const LzgFont& font,const FontChar& fc) {
+
+		LzgDecoderContext<> context;
+		writeCharacter(p,font,fc,context);
+	}
+
+
+	/**
+	 * Write a single character from an LZG font, from the cache if it's there. A glyph that is not
+	 * in the cache is decoded into it with the history window in the given context.
+	 * @param p The upper-left point to write out at.
+	 * @param font The font that the character comes from.
+	 * @param fc The FontChar structure defining the character.
+	 * @param context The LzgDecoderContext to decode with.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	template<class TContext>
+	inline void GlyphCache<TGraphicsLibrary,TEntries,TEntryBytes>::writeCharacter(const Point& p,const LzgFont& font,const FontChar& fc,TContext& context) {
+
+		Rectangle rc(p.X,p.Y,fc.PixelWidth,font.getHeight());
+		const uint8_t *ptr;
+		uint32_t numBytes,in,insize;
+		uint8_t index;
+
+		numBytes=(uint32_t)fc.PixelWidth*font.getHeight()*_gl->getBytesPerPixel();
+
+		if(numBytes>TEntryBytes || !isInsideClip(rc)) {
+			_gl->writeCharacter(p,font,fc,context);
+			return;
+		}
+
+		if(!findEntry(font,fc.Code,index)) {
+
+			// the glyph data is preceded by its 16-bit size
+
+			ptr=fc.Data;
+			insize=pgm_read_byte(ptr);
+			insize|=static_cast<uint16_t>(pgm_read_byte(ptr+1)) << 8;
+			in=reinterpret_cast<uintptr_t>(ptr+2);
+
+			// a glyph that the context cannot decode is not drawn by the graphics library either
+
+			if(LzgFlashDecoder<TCaptureAccessMode>::getWindowSize(in,insize)>sizeof(context.History))
+				return;
+
+			index=claimEntry(font,fc.Code);
+
+			TCaptureAccessMode::setBuffer(_pixels[index].Bytes,numBytes);
+			LzgFlashDecoder<TCaptureAccessMode>::decode(context,in,insize);
+		}
+
+		_gl->moveTo(rc);
+		_gl->beginWriting();
+		_gl->rawSramTransfer(_pixels[index].Bytes,numBytes);
+	}
+
+
+	/**
+	 * Empty the cache and reset the hit and miss counters.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	inline void GlyphCache<TGraphicsLibrary,TEntries,TEntryBytes>::clear() {
+
+		uint8_t i;
+
+		for(i=0;i<TEntries;i++) {
+			_entries[i].Font=0;
+			_order[i]=i;
+		}
+
+		_hits=_misses=0;
+	}
+
+
+	/**
+	 * Get the number of glyphs that were written from the cache.
+	 * @return The hit count.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	inline uint16_t GlyphCache<TGraphicsLibrary,TEntries,TEntryBytes>::getHits() const {
+		return _hits;
+	}
+
+
+	/**
+	 * Get the number of glyphs that had to be added to the cache.
+	 * @return The miss count.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	inline uint16_t GlyphCache<TGraphicsLibrary,TEntries,TEntryBytes>::getMisses() const {
+		return _misses;
+	}
+
+
+	/**
+	 * Look for a glyph in the cache. A glyph that is found becomes the most recently used.
+	 * @param font The font.
+	 * @param code The character code.
+	 * @param[out] index The entry index if found.
+	 * @return true if found.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	inline bool GlyphCache<TGraphicsLibrary,TEntries,TEntryBytes>::findEntry(const FontBase& font,uint8_t code,uint8_t& index) {
+
+		uint8_t position;
+		const Entry *entry;
+
+		for(position=0;position<TEntries;position++) {
+
+			index=_order[position];
+			entry=&_entries[index];
+
+			if(entry->Font==&font && entry->Code==code) {
+				moveToFront(position);
+				_hits++;
+				return true;
+			}
+		}
+
+		_misses++;
+		return false;
+	}
+
+
+	/**
+	 * Take an entry for a new glyph. An empty entry is used if there is one, otherwise the least
+	 * recently used. The entry becomes the most recently used.
+	 * @param font The font.
+	 * @param code The character code.
+	 * @return The entry index.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	inline uint8_t GlyphCache<TGraphicsLibrary,TEntries,TEntryBytes>::claimEntry(const FontBase& font,uint8_t code) {
+
+		uint8_t position,index;
+
+		for(position=TEntries-1;position>0;position--)
+			if(_entries[_order[position]].Font==0)
+				break;
+
+		if(position==0 && _entries[_order[0]].Font!=0)
+			position=TEntries-1;
+
+		index=_order[position];
+		moveToFront(position);
+
+		_entries[index].Font=&font;
+		_entries[index].Code=code;
+
+		return index;
+	}
+
+
+	/**
+	 * Move the entry at a position in the usage order to the front.
+	 * @param position The position in the order.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	inline void GlyphCache<TGraphicsLibrary,TEntries,TEntryBytes>::moveToFront(uint8_t position) {
+
+		uint8_t index;
+
+		index=_order[position];
+
+		for(;position;position--)
+			_order[position]=_order[position-1];
+
+		_order[0]=index;
+	}
+
+
+	/**
+	 * Drop the bitmap glyphs, which were expanded in colours that are no longer current.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	inline void GlyphCache<TGraphicsLibrary,TEntries,TEntryBytes>::dropBitmapEntries() {
+
+		uint8_t i;
+
+		for(i=0;i<TEntries;i++)
+			if(_entries[i].Font!=0 && _entries[i].Font->getType()==FontBase::FONT_BITMAP)
+				_entries[i].Font=0;
+	}
+
+
+	/**
+	 * Expand a bitmap glyph into pixels in the current colours. Bits are stored LSB first and
+	 * packed across rows.
+	 * @param fc The glyph.
+	 * @param numPixels The number of pixels in the glyph.
+	 * @param pixels Where to write the pixels.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	inline void GlyphCache<TGraphicsLibrary,TEntries,TEntryBytes>::expandGlyph(const FontChar& fc,uint16_t numPixels,UnpackedColour *pixels) const {
+
+		const uint8_t *ptr;
+		uint8_t value,mask;
+
+		ptr=fc.Data;
+		value=0;
+		mask=0;
+
+		while(numPixels--) {
+
+			if(mask==0) {
+				value=pgm_read_byte(ptr++);
+				mask=1;
+			}
+
+			*pixels++=(value & mask)!=0 ? _unpackedForeground : _unpackedBackground;
+			mask<<=1;
+		}
+	}
+
+
+	/**
+	 * Check if a rectangle is entirely inside the clip rectangle of the graphics library.
+	 * @param rc The rectangle.
+	 * @return true if it is.
+	 */
+
+	template<class TGraphicsLibrary,uint8_t TEntries,uint16_t TEntryBytes>
+	inline bool GlyphCache<TGraphicsLibrary,TEntries,TEntryBytes>::isInsideClip(const Rectangle& rc) const {
+
+		const Rectangle& clip(_gl->getClip());
+
+		return rc.X>=clip.X && rc.Y>=clip.Y
+		    && rc.X+rc.Width<=clip.X+clip.Width
+		    && rc.Y+rc.Height<=clip.Y+clip.Height;
+	}
+}
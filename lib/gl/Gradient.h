@@ -0,0 +1,165 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file Gradient.h
+ * @brief Support structures for the gradient fills
+ * @ingroup GraphicsLibrary
+ */
+
+#pragma once
+
+
+namespace lcd {
+
+	/**
+	 * @brief A colour stop in a multi-stop gradient
+	 *
+	 * The position runs from 0 at the start of the gradient to 255 at the end. Stops must be
+	 * supplied in ascending position order.
+	 * @ingroup GraphicsLibrary
+	 */
+
+	struct GradientStop {
+
+		/**
+		 * The position of this stop along the gradient, 0..255
+		 */
+
+		uint8_t Position;
+
+
+		/**
+		 * The colour at this stop, as rrggbb
+		 */
+
+		uint32_t Colour;
+
+
+		/**
+		 * Default constructor
+		 */
+
+		GradientStop()
+			: Position(), Colour() {
+		}
+
+
+		/**
+		 * Constructor with parameters
+		 * @param position The position, 0..255
+		 * @param colour The colour as rrggbb
+		 */
+
+		GradientStop(uint8_t position,uint32_t colour) :
+			Position(position),
+			Colour(colour) {
+		}
+	};
+
+
+	/**
+	 * @brief Step a colour component from one value to another over a number of steps.
+	 *
+	 * This is a bresenham style interpolator. The value is always exact and all the arithmetic in next()
+	 * is 16-bit, which matters on the AVR where 32-bit maths is expensive. Starting part way through an
+	 * interpolation costs one 32-bit multiply and divide in begin().
+	 * @ingroup GraphicsLibrary
+	 */
+
+	class GradientInterpolator {
+
+		protected:
+			int16_t _value;
+			int16_t _step;
+			int16_t _remainderStep;
+			int16_t _remainder;
+			int16_t _steps;
+
+		public:
+
+			/**
+			 * Start a new interpolation
+			 * @param from The first value
+			 * @param to The value that would be reached after 'steps' calls to next()
+			 * @param steps The number of steps, must be greater than zero
+			 * @param start The step to start at, as if next() had already been called this many times
+			 */
+
+			void begin(uint8_t from,uint8_t to,int16_t steps,int16_t start=0) {
+
+				int16_t diff=(int16_t)to-(int16_t)from;
+				int32_t total;
+
+				_value=from;
+				_steps=steps;
+				_remainder=0;
+				_step=diff/steps;
+				_remainderStep=diff % steps;
+
+				if(_remainderStep<0) {
+					_step--;
+					_remainderStep+=steps;
+				}
+
+				// the value after 'start' steps is from+floor(start*diff/steps)
+
+				if(start) {
+
+					total=(int32_t)diff*start;
+
+					_value+=total/steps;
+					_remainder=total % steps;
+
+					if(_remainder<0) {
+						_value--;
+						_remainder+=steps;
+					}
+				}
+			}
+
+
+			/**
+			 * Get the current value
+			 * @return The current value
+			 */
+
+			uint8_t getValue() const {
+				return _value;
+			}
+
+
+			/**
+			 * Advance to the next value
+			 */
+
+			void next() {
+
+				_value+=_step;
+				_remainder+=_remainderStep;
+
+				if(_remainder>=_steps) {
+					_remainder-=_steps;
+					_value++;
+				}
+			}
+	};
+}
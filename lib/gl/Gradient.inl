@@ -0,0 +1,571 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+/**
+ * @file Gradient.inl
+ * @brief Linear and radial gradient fills
+ * @ingroup GraphicsLibrary
+ */
+
+#pragma once
+
+
+namespace lcd {
+
+	/**
+	 * Gradient fill a rectangle from one colour to another.
+	 * @param rc The bounding rectangle of the entire gradient.
+	 * @param dir The direction of the gradient: horizontal, vertical or diagonal.
+	 * @param first The starting colour of the gradient.
+	 * @param last The ending colour of the gradient.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::gradientFillRectangle(
+							const Rectangle& rc,
+							Direction dir,
+							TColour first,
+							TColour last) const {
+
+		GradientStop stops[2];
+
+		stops[0]=GradientStop(0,first);
+		stops[1]=GradientStop(255,last);
+
+		multiStopGradientFillRectangle(rc,dir,stops,2);
+	}
+
+
+	/**
+	 * @brief Gradient fill a rectangle through a number of colour stops.
+	 *
+	 * The colour ramp is calculated in batches of up to GRADIENT_RUN_BATCH runs of identical unpacked
+	 * colours held on the stack, so no colour maths is done while the pixels are being written and
+	 * nothing is allocated from the heap.
+	 *
+	 *  - HORIZONTAL gradients set a window for the columns covered by each batch and stream every row
+	 *    from it, using writePixelAgain() within each run.
+	 *  - VERTICAL gradients fill each run as one rectangle, so identical adjacent lines cost nothing extra.
+	 *  - DIAGONAL gradients go from the top-left to the bottom-right. Each row starts one pixel further
+	 *    along the ramp than the row above it. The rectangle is drawn in tiles of GRADIENT_RUN_BATCH/2
+	 *    rows with a window for each batch.
+	 *
+	 * The ramp always covers the whole rectangle so a gradient that is partly clipped looks the same as the
+	 * corresponding part of the unclipped gradient. Only the visible part of the ramp is calculated.
+	 *
+	 * @param rc The bounding rectangle of the entire gradient.
+	 * @param dir The direction of the gradient.
+	 * @param stops The colour stops, in ascending position order.
+	 * @param count The number of colour stops.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::multiStopGradientFillRectangle(
+							const Rectangle& rc,
+							Direction dir,
+							const GradientStop *stops,
+							uint8_t count) const {
+
+		GradientRun runs[GRADIENT_RUN_BATCH];
+		const GradientRun *run;
+		uint16_t length,position,remaining,offset,numPixels;
+		uint8_t numRuns;
+		int16_t i;
+		Rectangle visible(rc),batch;
+
+		// the ramp covers the whole rectangle but only the part inside the clip rectangle is drawn
+
+		if(count==0 || !clipRectangle(visible))
+			return;
+
+		if(dir==VERTICAL) {
+
+			// one block fill per run of identical colours
+
+			batch=Rectangle(visible.X,visible.Y,visible.Width,0);
+			position=visible.Y-rc.Y;
+
+			for(remaining=visible.Height;remaining;remaining-=numPixels) {
+
+				numPixels=buildGradientRamp(stops,count,rc.Height,position,remaining,runs,numRuns);
+				position+=numPixels;
+
+				for(run=runs;run!=runs+numRuns;run++) {
+
+					batch.Height=run->Count;
+					fillClippedRectangle(batch,run->Colour);
+					batch.Y+=run->Count;
+				}
+			}
+		}
+		else if(dir==HORIZONTAL) {
+
+			// a window for the columns in each batch, every row is the same
+
+			batch=Rectangle(visible.X,visible.Y,0,visible.Height);
+			position=visible.X-rc.X;
+
+			for(remaining=visible.Width;remaining;remaining-=batch.Width) {
+
+				batch.Width=buildGradientRamp(stops,count,rc.Width,position,remaining,runs,numRuns);
+				position+=batch.Width;
+
+				this->moveTo(batch);
+				this->beginWriting();
+
+				for(i=0;i<visible.Height;i++)
+					writeGradientRuns(runs,0,batch.Width);
+
+				batch.X+=batch.Width;
+			}
+		}
+		else {
+
+			// a tile of w columns and h rows needs w+h-1 pixels of ramp. A full batch of runs covers at
+			// least GRADIENT_RUN_BATCH pixels so with half that many rows every tile is at least one column wide.
+
+			length=rc.Width+rc.Height-1;
+			batch.Y=visible.Y;
+
+			for(remaining=visible.Height;remaining;remaining-=batch.Height) {
+
+				batch.Height=Min<int16_t>(remaining,GRADIENT_RUN_BATCH/2);
+				batch.X=visible.X;
+
+				while(batch.X<visible.X+visible.Width) {
+
+					position=(batch.X-rc.X)+(batch.Y-rc.Y);
+
+					batch.Width=buildGradientRamp(
+							stops,
+							count,
+							length,
+							position,
+							(visible.X+visible.Width-batch.X)+batch.Height-1,
+							runs,
+							numRuns)-(batch.Height-1);
+
+					this->moveTo(batch);
+					this->beginWriting();
+
+					run=runs;
+					offset=0;
+
+					for(i=0;i<batch.Height;i++) {
+
+						writeGradientRuns(run,offset,batch.Width);
+
+						// the next row starts one pixel further along the ramp
+
+						if(++offset==run->Count) {
+							run++;
+							offset=0;
+						}
+					}
+
+					batch.X+=batch.Width;
+				}
+
+				batch.Y+=batch.Height;
+			}
+		}
+	}
+
+
+	/**
+	 * Radial gradient fill a rectangle from one colour at the center to another at the radius.
+	 * @param rc The rectangle to fill.
+	 * @param center The center of the gradient. Does not have to be inside the rectangle.
+	 * @param radius The distance from the center at which the last colour is reached.
+	 * @param first The colour at the center.
+	 * @param last The colour at the radius and beyond.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::radialGradientFillRectangle(
+							const Rectangle& rc,
+							const Point& center,
+							int16_t radius,
+							TColour first,
+							TColour last) const {
+
+		GradientStop stops[2];
+
+		stops[0]=GradientStop(0,first);
+		stops[1]=GradientStop(255,last);
+
+		multiStopRadialGradientFillRectangle(rc,center,radius,stops,2);
+	}
+
+
+	/**
+	 * @brief Radial gradient fill a rectangle through a number of colour stops.
+	 *
+	 * The ramp is indexed by the distance of each pixel from the center, clamped to the radius. The
+	 * part of the rectangle inside the clip rectangle is written through a single window. The integer square root is only taken once per row.
+	 * Along the row the distance can only change by one pixel per step so it is tracked incrementally
+	 * with additions and comparisons.
+	 *
+	 * The ramp is held on the stack in batches of up to GRADIENT_RUN_BATCH runs. The next batch is
+	 * calculated when the distance walks off either end of the current one.
+	 *
+	 * @param rc The rectangle to fill.
+	 * @param center The center of the gradient. Does not have to be inside the rectangle.
+	 * @param radius The distance from the center at which the last stop is reached.
+	 * @param stops The colour stops, in ascending position order.
+	 * @param count The number of colour stops.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::multiStopRadialGradientFillRectangle(
+							const Rectangle& rc,
+							const Point& center,
+							int16_t radius,
+							const GradientStop *stops,
+							uint8_t count) const {
+
+		GradientRun runs[GRADIENT_RUN_BATCH];
+		const GradientRun *run,*lastRun;
+		uint16_t offset,first,numPixels;
+		uint8_t numRuns;
+		int16_t x,y,dx,dy,distance,index,newIndex;
+		uint32_t sum,distanceSquared;
+
+		Rectangle visible(rc);
+
+		if(count==0 || !clipRectangle(visible))
+			return;
+
+		if(radius<1)
+			radius=1;
+
+		this->moveTo(visible);
+		this->beginWriting();
+
+		lastRun=NULL;
+		first=numPixels=0;
+
+		for(y=0;y<visible.Height;y++) {
+
+			// square root for the first pixel in the row
+
+			dy=visible.Y+y-center.Y;
+			dx=visible.X-center.X;
+
+			sum=(int32_t)dx*dx+(int32_t)dy*dy;
+			distance=squareRoot(sum);
+			distanceSquared=(uint32_t)distance*distance;
+
+			// find the ramp position for the first pixel. If it's not in the current batch then calculate
+			// a new one, ending at the pixel if the row starts by moving towards the center.
+
+			index=Min(distance,radius);
+
+			if(index<(int16_t)first || index>=(int16_t)(first+numPixels)) {
+
+				first=dx<0 ? Max<int16_t>(index-(GRADIENT_RUN_BATCH-1),0) : index;
+				numPixels=buildGradientRamp(stops,count,radius+1,first,radius+1-first,runs,numRuns);
+				lastRun=NULL;
+			}
+
+			run=findGradientRun(runs,index-first,offset);
+
+			for(x=0;x<visible.Width;x++) {
+
+				if(run==lastRun)
+					this->writePixelAgain(run->Colour);
+				else {
+					this->writePixel(run->Colour);
+					lastRun=run;
+				}
+
+				// step the distance to the next pixel
+
+				sum+=2*(int32_t)dx+1;
+				dx++;
+
+				if(sum>=distanceSquared+2*distance+1) {
+					distanceSquared+=2*distance+1;
+					distance++;
+				}
+				else if(sum<distanceSquared) {
+					distance--;
+					distanceSquared-=2*distance+1;
+				}
+
+				// move the ramp position by at most one, calculating the next batch in that direction if
+				// the position walks off the end of this one
+
+				newIndex=Min(distance,radius);
+
+				if(newIndex>index) {
+
+					if(++offset==run->Count) {
+
+						offset=0;
+
+						if(++run==runs+numRuns) {
+
+							first+=numPixels;
+							numPixels=buildGradientRamp(stops,count,radius+1,first,radius+1-first,runs,numRuns);
+							run=runs;
+							lastRun=NULL;
+						}
+					}
+				}
+				else if(newIndex<index) {
+
+					if(offset)
+						offset--;
+					else if(run!=runs) {
+						run--;
+						offset=run->Count-1;
+					}
+					else {
+
+						first=Max<int16_t>(newIndex-(GRADIENT_RUN_BATCH-1),0);
+						numPixels=buildGradientRamp(stops,count,radius+1,first,radius+1-first,runs,numRuns);
+						run=findGradientRun(runs,newIndex-first,offset);
+						lastRun=NULL;
+					}
+				}
+
+				index=newIndex;
+			}
+		}
+	}
+
+
+	/**
+	 * Calculate a batch of the colour ramp for a gradient. Adjacent pixels that unpack to the same colour
+	 * are merged into a single run, which is common because the panel colour depth is lower than the
+	 * 8-bits per component that is interpolated. The interpolators are started part way through the stop
+	 * that contains the first pixel so the pixels before the batch cost nothing.
+	 * @param stops The colour stops.
+	 * @param count The number of colour stops.
+	 * @param length The number of pixels in the whole ramp.
+	 * @param position The first pixel of the batch.
+	 * @param numPixels The most pixels to calculate. position+numPixels must not be more than length.
+	 * @param runs Where to write the runs. There must be room for GRADIENT_RUN_BATCH.
+	 * @param numRuns Output the number of runs.
+	 * @return The number of pixels calculated. Less than numPixels if the batch filled up.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline uint16_t GraphicsLibrary<TDevice,TAccessMode>::buildGradientRamp(
+							const GradientStop *stops,
+							uint8_t count,
+							uint16_t length,
+							uint16_t position,
+							uint16_t numPixels,
+							GradientRun *runs,
+							uint8_t& numRuns) const {
+
+		GradientInterpolator red,green,blue;
+		UnpackedColour cr;
+		uint16_t index,nextIndex,end,i;
+		uint8_t stop;
+
+		numRuns=0;
+		i=position;
+		end=position+numPixels;
+
+		// solid colour up to the first stop
+
+		index=getGradientStopIndex(stops[0],length);
+
+		if(i<index) {
+
+			this->unpackColour(stops[0].Colour,cr);
+			addGradientRun(runs,numRuns,cr,Min(index,end)-i);
+			i=Min(index,end);
+		}
+
+		// interpolate between the stops
+
+		for(stop=0;stop<count-1 && i<end;stop++) {
+
+			nextIndex=getGradientStopIndex(stops[stop+1],length);
+
+			if(nextIndex>i) {
+
+				red.begin(stops[stop].Colour >> 16,stops[stop+1].Colour >> 16,nextIndex-index,i-index);
+				green.begin(stops[stop].Colour >> 8,stops[stop+1].Colour >> 8,nextIndex-index,i-index);
+				blue.begin(stops[stop].Colour,stops[stop+1].Colour,nextIndex-index,i-index);
+
+				for(;i<nextIndex && i<end;i++) {
+
+					this->unpackColour(red.getValue(),green.getValue(),blue.getValue(),cr);
+
+					if(!addGradientRun(runs,numRuns,cr,1))
+						return i-position;
+
+					red.next();
+					green.next();
+					blue.next();
+				}
+			}
+
+			if(nextIndex>index)
+				index=nextIndex;
+		}
+
+		// solid colour from the last stop to the end
+
+		if(i<end) {
+
+			this->unpackColour(stops[count-1].Colour,cr);
+
+			if(!addGradientRun(runs,numRuns,cr,end-i))
+				return i-position;
+		}
+
+		return numPixels;
+	}
+
+
+	/**
+	 * Append pixels to a batch of gradient runs, extending the last run if the colour has not changed.
+	 * @param runs The runs.
+	 * @param numRuns The number of runs so far. Updated.
+	 * @param cr The colour to append.
+	 * @param count The number of pixels of this colour.
+	 * @return false if a new run is needed and the batch already has GRADIENT_RUN_BATCH runs.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline bool GraphicsLibrary<TDevice,TAccessMode>::addGradientRun(
+							GradientRun *runs,
+							uint8_t& numRuns,
+							const UnpackedColour& cr,
+							uint16_t count) {
+
+		if(numRuns && memcmp(&runs[numRuns-1].Colour,&cr,sizeof(UnpackedColour))==0)
+			runs[numRuns-1].Count+=count;
+		else {
+
+			if(numRuns==GRADIENT_RUN_BATCH)
+				return false;
+
+			runs[numRuns].Colour=cr;
+			runs[numRuns].Count=count;
+			numRuns++;
+		}
+
+		return true;
+	}
+
+
+	/**
+	 * Convert the 0..255 position of a gradient stop to an offset into a ramp.
+	 * @param stop The gradient stop.
+	 * @param length The number of pixels in the ramp.
+	 * @return The offset, 0..length-1
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline uint16_t GraphicsLibrary<TDevice,TAccessMode>::getGradientStopIndex(const GradientStop& stop,uint16_t length) {
+		return ((uint32_t)stop.Position*(length-1))/255;
+	}
+
+
+	/**
+	 * Write pixels from the gradient ramp to the current output position. The first pixel of each run is
+	 * a full write and the remainder are written with writePixelAgain().
+	 * Assumes that the caller has already issued the beginWriting() command.
+	 * @param run The run that contains the first pixel.
+	 * @param offset The offset of the first pixel within its run.
+	 * @param numPixels The number of pixels to write. The ramp must be long enough.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::writeGradientRuns(const GradientRun *run,uint16_t offset,uint16_t numPixels) const {
+
+		uint16_t count;
+
+		while(numPixels) {
+
+			count=Min<uint16_t>(run->Count-offset,numPixels);
+			numPixels-=count;
+
+			this->writePixel(run->Colour);
+
+			while(--count)
+				this->writePixelAgain(run->Colour);
+
+			run++;
+			offset=0;
+		}
+	}
+
+
+	/**
+	 * Find the run in a gradient ramp that contains a pixel.
+	 * @param runs The ramp.
+	 * @param index The pixel offset into the ramp. Must be inside the ramp.
+	 * @param offset Output the offset of the pixel within the run.
+	 * @return The run.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline const typename GraphicsLibrary<TDevice,TAccessMode>::GradientRun *GraphicsLibrary<TDevice,TAccessMode>::findGradientRun(
+							const GradientRun *runs,
+							uint16_t index,
+							uint16_t& offset) {
+
+		for(offset=index;offset>=runs->Count;runs++)
+			offset-=runs->Count;
+
+		return runs;
+	}
+
+
+	/**
+	 * Integer square root, rounded down.
+	 * @param value The value to take the root of.
+	 * @return The largest integer whose square is not greater than value.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline uint16_t GraphicsLibrary<TDevice,TAccessMode>::squareRoot(uint32_t value) {
+
+		uint32_t result,bit;
+
+		result=0;
+		bit=1UL << 30;
+
+		while(bit>value)
+			bit>>=2;
+
+		while(bit) {
+
+			if(value>=result+bit) {
+				value-=result+bit;
+				result=(result >> 1)+bit;
+			}
+			else
+				result>>=1;
+
+			bit>>=2;
+		}
+
+		return result;
+	}
+}
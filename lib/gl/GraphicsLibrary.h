@@ -62,9 +62,15 @@
 
 namespace lcd {
 
+	struct PolygonEdge;
+
 	/**
 	 * Template implementation of a graphics library. This library inherits from the device implementation
 	 * that provides the methods that the graphics library needs to access the hardware
+	 *
+	 * All drawing is restricted to the clip rectangle set with setClip(). The default clip rectangle is the
+	 * whole panel. clearScreen() also respects the clip and only clears the area inside it, so call
+	 * resetClip() first if the whole panel must be cleared.
 	 * @ingroup GraphicsLibrary
 	 * @tparam TDevice the underlying device (e.g. an instantiation of the ILI9325 template)
 	 * @tparam TAccessMode The access mode, (e.g. an instantiation of the Gpio16LatchAccessMode template)
@@ -78,18 +84,62 @@ namespace lcd {
 			typedef typename TDevice::TColour TColour;
 
 			enum {
-				MAX_DOUBLE_FRACTION_DIGITS = 5
+				MAX_DOUBLE_FRACTION_DIGITS = 5,
+				POLYGON_SPAN_BATCH = 8,
+				GRADIENT_RUN_BATCH = 16,
+				TEXT_WINDOW_GLYPHS = 16
 			};
 
 		protected:
+
+			/*
+			 * A run of identical colours in a gradient ramp
+			 */
+
+			struct GradientRun {
+				UnpackedColour Colour;
+				uint16_t Count;
+			};
+
+			/*
+			 * A pending run of foreground or background pixels in a bitmap glyph
+			 */
+
+			struct GlyphRun {
+				bool Foreground;
+				uint16_t Length;
+			};
+
 			UnpackedColour _foreground;
 			UnpackedColour _background;
 
 			Point _streamSelectedPoint;									// need to keep a copy so rvalue points can be used
 			const Font *_streamSelectedFont;						// can keep a ptr, user should not delete font while selected
 
+			Rectangle _clip;														// all drawing is restricted to this area
+
 		protected:
-			void plot4EllipsePoints(int16_t cx,int16_t cy,int16_t x,int16_t y) const;
+			void plot4EllipseColumns(int16_t cx,int16_t cy,int16_t x,int16_t y1,int16_t y2) const;
+			void plot4EllipseRows(int16_t cx,int16_t cy,int16_t x1,int16_t x2,int16_t y) const;
+			void drawSteepLine(const Point& p1,const Point& p2,bool clip) const;
+			void fillClippedRectangle(const Rectangle& rc,const UnpackedColour& cr) const;
+			bool clipRectangle(Rectangle& rc) const;
+			bool clipLine(int16_t& x0,int16_t& y0,int16_t& x1,int16_t& y1,int16_t& err,bool steep) const;
+			uint8_t getOutCode(const Point& p) const;
+			bool isVisible(int16_t x,int16_t y) const;
+			void rasterizePolygon(const Point *points,uint8_t count,PolygonEdge *edges,PolygonEdge **active) const;
+
+			uint16_t buildGradientRamp(const GradientStop *stops,uint8_t count,uint16_t length,uint16_t position,uint16_t numPixels,GradientRun *runs,uint8_t& numRuns) const;
+			static bool addGradientRun(GradientRun *runs,uint8_t& numRuns,const UnpackedColour& cr,uint16_t count);
+			void writeGradientRuns(const GradientRun *run,uint16_t offset,uint16_t numPixels) const;
+			static const GradientRun *findGradientRun(const GradientRun *runs,uint16_t index,uint16_t& offset);
+			static uint16_t getGradientStopIndex(const GradientStop& stop,uint16_t length);
+			void writeCharacters(const Point& p,const Font& font,const FontChar *chars,uint8_t count,int16_t width) const;
+			void addGlyphBits(GlyphRun& run,const uint8_t *data,uint16_t index,uint16_t count) const;
+			void addGlyphRun(GlyphRun& run,bool foreground,uint16_t count) const;
+			void flushGlyphRun(const GlyphRun& run) const;
+			static uint16_t squareRoot(uint32_t value);
+			static int16_t getLineMinorSteps(int16_t majorLength,int16_t minorLength,int16_t steps);
 
 			template<typename T>
 			static const T& Max(const T& a,const T& b);
@@ -101,6 +151,8 @@ namespace lcd {
 			static const T Abs(const T a);
 
 		public:
+			GraphicsLibrary();
+
 			// colour choices
 
 			void setForeground(TColour cr);
@@ -111,6 +163,12 @@ namespace lcd {
 			int16_t getXmax() const;
 			int16_t getYmax() const;
 
+			// clipping
+
+			void setClip(const Rectangle& rc);
+			void resetClip();
+			const Rectangle& getClip() const;
+
 			// text output methods - any font
 
 			Size measureString(const FontBase& font,const char *str) const;
@@ -125,6 +183,14 @@ namespace lcd {
 			Size writeString(const Point& p,const LzgFont& font,const char *str) const;
 			void writeCharacter(const Point& p,const LzgFont& font,const FontChar& fc) const;
 
+			template<class TContext> Size writeString(const Point& p,const LzgFont& font,const char *str,TContext& context) const;
+			template<class TContext> void writeCharacter(const Point& p,const LzgFont& font,const FontChar& fc,TContext& context) const;
+
+			// text output methods - transparent span fonts
+
+			Size writeString(const Point& p,const SpanFont& font,const char *str) const;
+			void writeCharacter(const Point& p,const SpanFont& font,const FontChar& fc) const;
+
 			// text stream operators
 
 			GraphicsLibrary& operator<<(const char *str);
@@ -133,9 +199,15 @@ namespace lcd {
 			GraphicsLibrary& operator<<(int32_t val);
 			GraphicsLibrary& operator<<(const DoublePrecision& val);
 			GraphicsLibrary& operator<<(double val);
+			GraphicsLibrary& operator<<(const FixedPoint& val);
+			GraphicsLibrary& operator<<(const ScaledInteger& val);
+			GraphicsLibrary& operator<<(const UnsignedInteger& val);
+			GraphicsLibrary& operator<<(const HexInteger& val);
 			GraphicsLibrary& operator<<(const Point& p);
 			GraphicsLibrary& operator<<(const Font& f);
 
+			template<class TNumber> GraphicsLibrary& writeNumber(const TNumber& val);
+
 			static void modp_dtoa(double value,int8_t prec,char *str);
 
 			// drawing primitives
@@ -147,12 +219,23 @@ namespace lcd {
 			void fillRectangle(const Rectangle& rc) const;
 			void clearRectangle(const Rectangle& rc) const;
 			void gradientFillRectangle(const Rectangle& rc,Direction dir,TColour first,TColour last) const;
+			void multiStopGradientFillRectangle(const Rectangle& rc,Direction dir,const GradientStop *stops,uint8_t count) const;
+			void radialGradientFillRectangle(const Rectangle& rc,const Point& center,int16_t radius,TColour first,TColour last) const;
+			void multiStopRadialGradientFillRectangle(const Rectangle& rc,const Point& center,int16_t radius,const GradientStop *stops,uint8_t count) const;
 			void drawEllipse(const Point& center,const Size& size) const;
 			void fillEllipse(const Point& center,const Size& size) const;
+			void drawCircle(const Point& center,int16_t radius) const;
 			void drawLine(const Point& p1,const Point& p2) const;
+			void fillSpans(const Span *spans,uint16_t count) const;
+			void fillTriangle(const Point& p1,const Point& p2,const Point& p3) const;
+			void fillPolygon(const Point *points,uint8_t count) const;
+			template<class TEdgeTable> void fillPolygon(const Point *points,uint8_t count,TEdgeTable& table) const;
 
 			void drawUncompressedBitmap(const Point& p,const Bitmap& bm) const;
+			void drawUncompressedBitmap(const Point& p,const Size& size,ByteSource& source) const;
 			void drawCompressedBitmap(const Point& p,const Bitmap& bm) const;
+			template<class TContext> void drawCompressedBitmap(const Point& p,const Bitmap& bm,TContext& context) const;
+			template<class TContext> void drawCompressedBitmap(const Point& p,const Size& size,ByteSource& source,TContext& context) const;
 
 			void drawJpeg(const Point& p,JpegDataSource& ds) const;
 	};
@@ -166,7 +249,10 @@ namespace lcd {
 #include "gl/Fundamentals.inl"
 #include "gl/Primitives.inl"
 #include "gl/Ellipse.inl"
+#include "gl/Polygon.inl"
 #include "gl/Rectangle.inl"
+#include "gl/Gradient.inl"
 #include "gl/Bitmap.inl"
 #include "gl/Text.inl"
 #include "gl/LzgText.inl"
+#include "gl/SpanText.inl"
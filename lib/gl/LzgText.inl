@@ -37,7 +37,8 @@ namespace lcd {
 
 
 	/**
-	 * Write a null terminated string of characters to the display.
+	 * Write a null terminated string of characters to the display. One default LzgDecoderContext
+	 * is set up on the stack for the whole string.
 	 * @param p The upper-left co-ordinate on the panel to start writing at.
 	 * @param font The LzgFont that the characters will come from.
 	 * @param str The character string to write.
@@ -47,6 +48,25 @@ namespace lcd {
 	template<class TDevice,class TAccessMode>
 	inline Size GraphicsLibrary<TDevice,TAccessMode>::writeString(const Point& p,const LzgFont& font,const char *str) const {
 
+		LzgDecoderContext<> context;
+		return writeString(p,font,str,context);
+	}
+
+
+	/**
+	 * Write a null terminated string of characters to the display, decoding each character with
+	 * the history window in the given context.
+	 * @param p The upper-left co-ordinate on the panel to start writing at.
+	 * @param font The LzgFont that the characters will come from.
+	 * @param str The character string to write.
+	 * @param context The LzgDecoderContext to decode with. Its window must be large enough for the font's characters.
+	 * @return The pixel size of the string.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	template<class TContext>
+	inline Size GraphicsLibrary<TDevice,TAccessMode>::writeString(const Point& p,const LzgFont& font,const char *str,TContext& context) const {
+
 		const char *ptr;
 		Point pos(p);
 		FontChar fc;
@@ -63,7 +83,7 @@ namespace lcd {
 			font.getCharacter(*ptr,fc);
 
 			if(fc.Code!=' ')										// space is special and never has any data but does have a size
-				writeCharacter(pos,font,fc);
+				writeCharacter(pos,font,fc,context);
 
 			width=fc.PixelWidth+font.getCharacterSpacing();
 			pos.X+=width;
@@ -84,6 +104,23 @@ namespace lcd {
 	template<class TDevice,class TAccessMode>
 	inline void GraphicsLibrary<TDevice,TAccessMode>::writeCharacter(const Point& p,const LzgFont& font,const FontChar& fc) const {
 
+		LzgDecoderContext<> context;
+		writeCharacter(p,font,fc,context);
+	}
+
+
+	/**
+	 * Write a single character, decoding it with the history window in the given context
+	 * @param p The upper-left co-ordinate on the panel to start writing at.
+	 * @param font The LzgFont that the characters will come from.
+	 * @param fc The FontChar definition of the character to write. LzgFont.getCharacter() will get you this structure,.
+	 * @param context The LzgDecoderContext to decode with.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	template<class TContext>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::writeCharacter(const Point& p,const LzgFont& font,const FontChar& fc,TContext& context) const {
+
 		Bitmap bm;
 		uint16_t lsb,msb;
 		const uint8_t *ptr;
@@ -104,6 +141,6 @@ namespace lcd {
 
 		// draw the bitmap
 
-		drawCompressedBitmap(charLocation,bm);
+		drawCompressedBitmap(charLocation,bm,context);
 	}
 }
@@ -0,0 +1,298 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file NumberFormat.h
+ * @brief Integer-only number formatting
+ * @ingroup GraphicsLibrary
+ */
+
+#pragma once
+
+
+namespace lcd {
+
+	/**
+	 * @brief Carrier for a signed Q16.16 fixed point number and its desired output precision.
+	 *
+	 * The value is the number multiplied by 65536, e.g. 0x00018000 is 1.5. Formatting uses only
+	 * integer arithmetic so it is much cheaper than DoublePrecision on an MCU without an FPU.
+	 *
+	 * @ingroup GraphicsLibrary
+	 */
+
+	struct FixedPoint {
+
+		int32_t Value;						///< The number multiplied by 65536
+		uint8_t Precision;				///< The desired number of fractional digits, up to 5
+
+		/**
+		 * Constructor. Must be fully constructed.
+		 * @param value The number multiplied by 65536.
+		 * @param precision The desired number of fractional digits, up to 5.
+		 */
+
+		FixedPoint(int32_t value,uint8_t precision) {
+			Value=value;
+			Precision=precision;
+		}
+	};
+
+
+	/**
+	 * @brief Carrier for an integer that holds a number scaled by a power of ten.
+	 *
+	 * For example a temperature held in hundredths of a degree as 2345 is written as "23.45"
+	 * when the number of decimals is 2.
+	 *
+	 * @ingroup GraphicsLibrary
+	 */
+
+	struct ScaledInteger {
+
+		int32_t Value;						///< The scaled number
+		uint8_t Decimals;					///< The number of digits after the decimal point, up to 9
+
+		/**
+		 * Constructor. Must be fully constructed.
+		 * @param value The scaled number.
+		 * @param decimals The number of digits after the decimal point, up to 9.
+		 */
+
+		ScaledInteger(int32_t value,uint8_t decimals) {
+			Value=value;
+			Decimals=decimals;
+		}
+	};
+
+
+	/**
+	 * @brief Carrier for an unsigned integer written in decimal and padded with leading zeros.
+	 * @ingroup GraphicsLibrary
+	 */
+
+	struct UnsignedInteger {
+
+		uint32_t Value;						///< The number
+		uint8_t Width;						///< The minimum number of digits, up to 10. Zero for no padding.
+
+		/**
+		 * Constructor.
+		 * @param value The number.
+		 * @param width The minimum number of digits, up to 10. Zero for no padding.
+		 */
+
+		explicit UnsignedInteger(uint32_t value,uint8_t width=0) {
+			Value=value;
+			Width=width;
+		}
+	};
+
+
+	/**
+	 * @brief Carrier for an unsigned integer written in upper case hexadecimal and padded with leading zeros.
+	 * @ingroup GraphicsLibrary
+	 */
+
+	struct HexInteger {
+
+		uint32_t Value;						///< The number
+		uint8_t Width;						///< The minimum number of digits, up to 8. Zero for no padding.
+
+		/**
+		 * Constructor.
+		 * @param value The number.
+		 * @param width The minimum number of digits, up to 8. Zero for no padding.
+		 */
+
+		explicit HexInteger(uint32_t value,uint8_t width=0) {
+			Value=value;
+			Width=width;
+		}
+	};
+
+
+	/**
+	 * @brief Convert numbers to text using integer arithmetic only.
+	 *
+	 * Each method writes a nul-terminated string to a buffer supplied by the caller and returns a pointer
+	 * to the terminating nul. A buffer of MAX_LENGTH characters is large enough for any of them.
+	 *
+	 * @ingroup GraphicsLibrary
+	 */
+
+	struct NumberFormat {
+
+		enum {
+			MAX_LENGTH = 13,						///< sign, ten digits, a decimal point and the nul
+			MAX_FIXED_FRACTION_DIGITS = 5
+		};
+
+		static char *format(const FixedPoint& val,char *str);
+		static char *format(const ScaledInteger& val,char *str);
+		static char *format(const UnsignedInteger& val,char *str);
+		static char *format(const HexInteger& val,char *str);
+
+		static char *formatDecimal(uint32_t value,uint8_t minDigits,uint8_t decimals,char *str);
+	};
+
+
+	/**
+	 * Write a Q16.16 fixed point number. The fraction is rounded to the nearest digit, halves round up.
+	 * @param val The number and its precision.
+	 * @param str Where to write the text.
+	 * @return A pointer to the terminating nul.
+	 */
+
+	inline char *NumberFormat::format(const FixedPoint& val,char *str) {
+
+		uint32_t magnitude,whole,frac,scale;
+		uint8_t i,precision;
+
+		precision=val.Precision;
+
+		if(precision>MAX_FIXED_FRACTION_DIGITS)
+			precision=MAX_FIXED_FRACTION_DIGITS;
+
+		magnitude=val.Value<0 ? -static_cast<uint32_t>(val.Value) : val.Value;
+
+		// 10^p is 5^p * 2^p so the fraction digits are (f*5^p + half) >> (16-p). 5^5*65535 fits in 32 bits.
+
+		for(i=0,scale=1;i<precision;i++)
+			scale*=5;
+
+		whole=magnitude >> 16;
+		frac=((magnitude & 0xffff)*scale+(0x8000UL >> precision)) >> (16-precision);
+
+		// the whole part is at most 32768 so whole*10^5 plus the rounding carry cannot overflow
+
+		for(i=0;i<precision;i++)
+			whole*=10;
+
+		whole+=frac;
+
+		if(val.Value<0 && whole)
+			*str++='-';
+
+		return formatDecimal(whole,precision+1,precision,str);
+	}
+
+
+	/**
+	 * Write an integer scaled by a power of ten.
+	 * @param val The number and its number of decimals.
+	 * @param str Where to write the text.
+	 * @return A pointer to the terminating nul.
+	 */
+
+	inline char *NumberFormat::format(const ScaledInteger& val,char *str) {
+
+		uint8_t decimals;
+
+		decimals=val.Decimals>9 ? 9 : val.Decimals;
+
+		if(val.Value<0)
+			*str++='-';
+
+		return formatDecimal(val.Value<0 ? -static_cast<uint32_t>(val.Value) : val.Value,decimals+1,decimals,str);
+	}
+
+
+	/**
+	 * Write an unsigned decimal integer.
+	 * @param val The number and its width.
+	 * @param str Where to write the text.
+	 * @return A pointer to the terminating nul.
+	 */
+
+	inline char *NumberFormat::format(const UnsignedInteger& val,char *str) {
+		return formatDecimal(val.Value,val.Width,0,str);
+	}
+
+
+	/**
+	 * Write an unsigned hexadecimal integer.
+	 * @param val The number and its width.
+	 * @param str Where to write the text.
+	 * @return A pointer to the terminating nul.
+	 */
+
+	inline char *NumberFormat::format(const HexInteger& val,char *str) {
+
+		uint32_t value;
+		uint8_t count,i;
+
+		// count the digits
+
+		for(count=1,value=val.Value >> 4;value;value>>=4)
+			count++;
+
+		if(count<val.Width)
+			count=val.Width>8 ? 8 : val.Width;
+
+		// fill in from the right
+
+		str[count]='\0';
+
+		for(i=count,value=val.Value;i;value>>=4)
+			str[--i]="0123456789ABCDEF"[value & 0xf];
+
+		return str+count;
+	}
+
+
+	/**
+	 * Write an unsigned decimal number with an optional decimal point.
+	 * @param value The number.
+	 * @param minDigits The minimum number of digits, up to 10. Leading zeros are added to make it up.
+	 * @param decimals The number of digits to place after the decimal point. Zero for no decimal point.
+	 * @param str Where to write the text.
+	 * @return A pointer to the terminating nul.
+	 */
+
+	inline char *NumberFormat::formatDecimal(uint32_t value,uint8_t minDigits,uint8_t decimals,char *str) {
+
+		char digits[10];
+		uint8_t count;
+
+		// generate the digits in reverse order
+
+		count=0;
+
+		do {
+			digits[count++]='0'+value % 10;
+			value/=10;
+		} while(value || (count<minDigits && count<sizeof(digits)));
+
+		// copy them out in the right order with the decimal point in place
+
+		while(count) {
+
+			*str++=digits[--count];
+
+			if(count==decimals && count)
+				*str++='.';
+		}
+
+		*str='\0';
+		return str;
+	}
+}
@@ -0,0 +1,315 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file NumericField.h
+ * @brief A text field that only repaints the characters that change
+ * @ingroup GraphicsLibrary
+ */
+
+#pragma once
+
+
+namespace lcd {
+
+	/**
+	 * Possible horizontal alignments of text within a NumericField
+	 */
+
+	enum TextAlignment {
+		TEXT_ALIGN_LEFT,				///< text starts at the left edge
+		TEXT_ALIGN_CENTRE,			///< text is centred
+		TEXT_ALIGN_RIGHT				///< text ends at the right edge
+	};
+
+
+	/**
+	 * @brief Display a number or short string at a fixed place, repainting only what changes.
+	 *
+	 * Readouts such as temperatures and counters change one or two digits at a time. The field remembers the
+	 * text that it last wrote and where each character cell was. On an update each new cell is compared with
+	 * the old cell at the same position and only the runs of cells that differ are written. Parts of the field
+	 * that the old text covered and the new text does not are cleared. Proportional fonts are handled because
+	 * the comparison is made by position: a cell whose character moved is written again.
+	 *
+	 * The text is written in the graphics library's current colours and the rest of the field is cleared with
+	 * the current background colour. Call invalidate() after changing the colours so that the next update
+	 * repaints the whole field. The clip rectangle is narrowed to the field while it is repainted, so text that
+	 * is wider than the field is cut off at its edges, and the caller's clip rectangle is restored afterwards.
+	 *
+	 * @tparam TGraphicsLibrary The graphics library implementation.
+	 * @tparam TFont The font class, Font or LzgFont. Fonts that do not paint their background cannot be used.
+	 * @tparam TMaxLength The maximum number of characters in the field. The default holds any int32_t.
+	 * @ingroup GraphicsLibrary
+	 */
+
+	template<class TGraphicsLibrary,class TFont,uint8_t TMaxLength=11>
+	class NumericField {
+
+		protected:
+			TGraphicsLibrary *_gl;
+			const TFont& _font;
+			Rectangle _field;
+			TextAlignment _alignment;
+			char _text[TMaxLength+1];
+			int16_t _textX;												// left edge of the text as last written
+			int16_t _textWidth;										// width of the text as last written
+			bool _valid;
+
+		protected:
+			int16_t getTextWidth(const char *str) const;
+			int16_t getCellWidth(char c) const;
+			void writeCells(int16_t x,const char *first,const char *last) const;
+			void clearColumns(int16_t x1,int16_t x2) const;
+
+		public:
+			NumericField(TGraphicsLibrary *gl,const TFont& font,const Point& p,int16_t width,TextAlignment alignment=TEXT_ALIGN_RIGHT);
+
+			void setValue(int32_t value);
+			void setText(const char *str);
+			void invalidate();
+	};
+
+
+	/**
+	 * Constructor. Nothing is written until the first update.
+	 * @param gl A pointer to the graphics library implementation.
+	 * @param font The font to write with. The field keeps a reference to it.
+	 * @param p The upper-left corner of the field.
+	 * @param width The width of the field in pixels. The height is the font height.
+	 * @param alignment The alignment of the text within the field.
+	 */
+
+	template<class TGraphicsLibrary,class TFont,uint8_t TMaxLength>
+	inline NumericField<TGraphicsLibrary,TFont,TMaxLength>::NumericField(TGraphicsLibrary *gl,const TFont& font,const Point& p,int16_t width,TextAlignment alignment)
+		: _gl(gl),
+		  _font(font),
+		  _field(p.X,p.Y,width,font.getHeight()),
+		  _alignment(alignment),
+		  _valid(false) {
+	}
+
+
+	/**
+	 * Show a number in decimal.
+	 * @param value The number.
+	 */
+
+	template<class TGraphicsLibrary,class TFont,uint8_t TMaxLength>
+	inline void NumericField<TGraphicsLibrary,TFont,TMaxLength>::setValue(int32_t value) {
+
+		char buf[12];
+
+		ltoa(value,buf,10);
+		setText(buf);
+	}
+
+
+	/**
+	 * Show a string. Characters beyond TMaxLength are ignored.
+	 * @param str The string.
+	 */
+
+	template<class TGraphicsLibrary,class TFont,uint8_t TMaxLength>
+	inline void NumericField<TGraphicsLibrary,TFont,TMaxLength>::setText(const char *str) {
+
+		char text[TMaxLength+1];
+		const char *oldPtr,*runStart;
+		int16_t x,oldX,width,runX,right,bottom;
+		uint8_t i;
+		Rectangle saved,clip;
+
+		// take a bounded copy of the new text and position it
+
+		for(i=0;i<TMaxLength && str[i];i++)
+			text[i]=str[i];
+
+		text[i]='\0';
+
+		width=getTextWidth(text);
+
+		if(_alignment==TEXT_ALIGN_LEFT)
+			x=_field.X;
+		else if(_alignment==TEXT_ALIGN_RIGHT)
+			x=_field.X+_field.Width-width;
+		else
+			x=_field.X+(_field.Width-width)/2;
+
+		// draw only inside the field and the caller's clip rectangle
+
+		saved=_gl->getClip();
+
+		clip.X=_field.X>saved.X ? _field.X : saved.X;
+		clip.Y=_field.Y>saved.Y ? _field.Y : saved.Y;
+		right=_field.X+_field.Width<saved.X+saved.Width ? _field.X+_field.Width : saved.X+saved.Width;
+		bottom=_field.Y+_field.Height<saved.Y+saved.Height ? _field.Y+_field.Height : saved.Y+saved.Height;
+		clip.Width=right>clip.X ? right-clip.X : 0;
+		clip.Height=bottom>clip.Y ? bottom-clip.Y : 0;
+
+		_gl->setClip(clip);
+
+		// an invalid field is repainted in full: the old text is treated as covering the whole field
+
+		if(!_valid) {
+			_text[0]='\0';
+			_textX=_field.X;
+			_textWidth=_field.Width;
+		}
+
+		// clear the parts of the old text that the new text does not cover
+
+		clearColumns(_textX,x<_textX+_textWidth ? x : _textX+_textWidth);
+		clearColumns(x+width>_textX ? x+width : _textX,_textX+_textWidth);
+
+		// walk the new cells alongside the old ones. a cell is unchanged if the old text had the same
+		// character starting at the same position. runs of changed cells are written together.
+
+		oldPtr=_text;
+		oldX=_textX;
+		runStart=0;
+		runX=0;
+
+		for(i=0;text[i];i++) {
+
+			while(*oldPtr && oldX<x)
+				oldX+=getCellWidth(*oldPtr++);
+
+			if(*oldPtr && oldX==x && *oldPtr==text[i]) {
+
+				if(runStart) {
+					writeCells(runX,runStart,text+i);
+					runStart=0;
+				}
+			}
+			else if(!runStart) {
+				runStart=text+i;
+				runX=x;
+			}
+
+			x+=getCellWidth(text[i]);
+		}
+
+		if(runStart)
+			writeCells(runX,runStart,text+i);
+
+		// remember what is on the display now
+
+		for(i=0;(_text[i]=text[i])!='\0';i++);
+
+		_textX=x-width;
+		_textWidth=width;
+		_valid=true;
+
+		_gl->setClip(saved);
+	}
+
+
+	/**
+	 * Mark the field as needing a full repaint at the next update, e.g. after the colours change or
+	 * something else has been drawn over it.
+	 */
+
+	template<class TGraphicsLibrary,class TFont,uint8_t TMaxLength>
+	inline void NumericField<TGraphicsLibrary,TFont,TMaxLength>::invalidate() {
+		_valid=false;
+	}
+
+
+	/**
+	 * Get the width of a string, including the spacing after each character.
+	 * @param str The string.
+	 * @return The width in pixels.
+	 */
+
+	template<class TGraphicsLibrary,class TFont,uint8_t TMaxLength>
+	inline int16_t NumericField<TGraphicsLibrary,TFont,TMaxLength>::getTextWidth(const char *str) const {
+
+		int16_t width;
+
+		for(width=0;*str;str++)
+			width+=getCellWidth(*str);
+
+		return width;
+	}
+
+
+	/**
+	 * Get the width of a character cell, which is the character and the spacing after it.
+	 * @param c The character.
+	 * @return The width in pixels.
+	 */
+
+	template<class TGraphicsLibrary,class TFont,uint8_t TMaxLength>
+	inline int16_t NumericField<TGraphicsLibrary,TFont,TMaxLength>::getCellWidth(char c) const {
+		return _font.getCharacterWidth(c)+_font.getCharacterSpacing();
+	}
+
+
+	/**
+	 * Write a run of character cells. The cells are cleared first where the font would leave
+	 * old pixels behind: LZG fonts do not paint the spacing between characters or the space character.
+	 * @param x The left edge of the first cell.
+	 * @param first The first character.
+	 * @param last One past the last character.
+	 */
+
+	template<class TGraphicsLibrary,class TFont,uint8_t TMaxLength>
+	inline void NumericField<TGraphicsLibrary,TFont,TMaxLength>::writeCells(int16_t x,const char *first,const char *last) const {
+
+		char run[TMaxLength+1];
+		uint8_t i;
+		int16_t cellX;
+
+		if(_font.getType()==FontBase::FONT_LZG) {
+
+			for(cellX=x,i=0;first+i!=last;i++) {
+
+				if(first[i]==' ')
+					clearColumns(cellX,cellX+getCellWidth(' '));
+				else if(_font.getCharacterSpacing())
+					clearColumns(cellX+_font.getCharacterWidth(first[i]),cellX+getCellWidth(first[i]));
+
+				cellX+=getCellWidth(first[i]);
+			}
+		}
+
+		for(i=0;first!=last;i++)
+			run[i]=*first++;
+
+		run[i]='\0';
+
+		_gl->writeString(Point(x,_field.Y),_font,run);
+	}
+
+
+	/**
+	 * Clear a band of columns that covers the height of the field.
+	 * @param x1 The first column.
+	 * @param x2 One past the last column. Nothing is cleared if this is not after x1.
+	 */
+
+	template<class TGraphicsLibrary,class TFont,uint8_t TMaxLength>
+	inline void NumericField<TGraphicsLibrary,TFont,TMaxLength>::clearColumns(int16_t x1,int16_t x2) const {
+
+		if(x2>x1)
+			_gl->clearRectangle(Rectangle(x1,_field.Y,x2-x1,_field.Height));
+	}
+}
@@ -0,0 +1,347 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+/**
+ * @file Polygon.inl
+ * @brief Span list filling and the scanline polygon rasterizer
+ * @ingroup GraphicsLibrary
+ */
+
+#pragma once
+
+
+namespace lcd {
+
+	/**
+	 * @brief One edge in the polygon rasterizer's edge table.
+	 *
+	 * The X intercept is stepped down the edge in whole pixels with an exact remainder, bresenham
+	 * style, so there is no accumulated rounding error and no fixed point multiplication.
+	 * @ingroup GraphicsLibrary
+	 */
+
+	struct PolygonEdge {
+
+		/// The first row that this edge is active on
+		int16_t YMin;
+
+		/// The row after the last row that this edge is active on
+		int16_t YMax;
+
+		/// The integer part of the X intercept on the current row
+		int16_t X;
+
+		/// The fractional part of the X intercept, in units of 1/Dy
+		int16_t Remainder;
+
+		/// The integer amount added to X on each row
+		int16_t Step;
+
+		/// The fractional amount added to Remainder on each row
+		int16_t RemainderStep;
+
+		/// The height of the edge
+		int16_t Dy;
+
+
+		/**
+		 * Get the first pixel column that lies on or to the right of the X intercept
+		 * @return The column.
+		 */
+
+		int16_t getColumn() const {
+			return Remainder ? X+1 : X;
+		}
+	};
+
+
+	/**
+	 * @brief Storage for the edge table used to fill a polygon.
+	 *
+	 * A polygon needs one edge and one active edge pointer for each vertex, which is 16 bytes per
+	 * vertex on the AVR. fillPolygon() sets up a default table on the stack. Declare your own and pass
+	 * it to fillPolygon() to fill polygons with more vertices, or to keep the table out of the stack.
+	 *
+	 * @tparam TMaxPoints The most vertices that a polygon filled with this table can have.
+	 * @ingroup GraphicsLibrary
+	 */
+
+	template<uint8_t TMaxPoints=16>
+	struct PolygonEdgeTable {
+		PolygonEdge Edges[TMaxPoints];				///< the edges sorted by top row
+		PolygonEdge *Active[TMaxPoints];			///< the edges that cross the current row
+	};
+
+
+	/**
+	 * @brief Fill a list of horizontal spans with the foreground colour.
+	 *
+	 * Each span costs one window update and one fillPixels() call. This is the common output path
+	 * for the filled shapes that are not rectangles. Spans are trimmed to the clip rectangle.
+	 *
+	 * @param spans The array of spans.
+	 * @param count The number of spans in the array.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::fillSpans(const Span *spans,uint16_t count) const {
+
+		int16_t xstart,xend;
+
+		while(count--) {
+
+			if(spans->Y>=_clip.Y && spans->Y<_clip.Y+_clip.Height) {
+
+				xstart=Max(spans->X,_clip.X);
+				xend=Min<int16_t>(spans->X+spans->Length,_clip.X+_clip.Width);
+
+				if(xend>xstart) {
+					this->moveTo(xstart,spans->Y,xend-1,spans->Y);
+					this->fillPixels(xend-xstart,_foreground);
+				}
+			}
+
+			spans++;
+		}
+	}
+
+
+	/**
+	 * @brief Fill a triangle with the foreground colour.
+	 *
+	 * The edge table is small enough to live on the stack so this does not touch the heap. The
+	 * same fill convention as fillPolygon() applies.
+	 *
+	 * @param p1 The first vertex.
+	 * @param p2 The second vertex.
+	 * @param p3 The third vertex.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::fillTriangle(const Point& p1,const Point& p2,const Point& p3) const {
+
+		Point points[3];
+		PolygonEdge edges[3];
+		PolygonEdge *active[3];
+
+		points[0]=p1;
+		points[1]=p2;
+		points[2]=p3;
+
+		rasterizePolygon(points,3,edges,active);
+	}
+
+
+	/**
+	 * @brief Fill a convex or concave polygon with the foreground colour.
+	 *
+	 * The polygon is closed automatically from the last point back to the first. Self-intersecting
+	 * polygons are filled with the even-odd rule. A pixel is filled if its top-left corner lies inside
+	 * the polygon, so the right-most column and bottom-most row of the outline are not filled. This
+	 * means that a polygon with the corners of a rectangle fills exactly the same pixels as
+	 * fillRectangle() and adjacent polygons that share an edge neither overlap nor leave a gap.
+	 *
+	 * This costs 256 bytes of stack on the AVR because it sets up a default PolygonEdgeTable. Use the
+	 * overload that takes a table to fill polygons with more than 16 vertices.
+	 *
+	 * @param points The vertices of the polygon.
+	 * @param count The number of vertices. Fewer than 3 or more than 16 draws nothing.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::fillPolygon(const Point *points,uint8_t count) const {
+
+		PolygonEdgeTable<> table;
+		fillPolygon(points,count,table);
+	}
+
+
+	/**
+	 * @brief Fill a convex or concave polygon with the foreground colour using the given edge table.
+	 *
+	 * The fill convention is the same as the overload that sets up its own table.
+	 *
+	 * @param points The vertices of the polygon.
+	 * @param count The number of vertices. Fewer than 3 or more than the table holds draws nothing.
+	 * @param table The PolygonEdgeTable to rasterize with.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	template<class TEdgeTable>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::fillPolygon(const Point *points,uint8_t count,TEdgeTable& table) const {
+
+		if(count<3 || count>sizeof(table.Edges)/sizeof(table.Edges[0]))
+			return;
+
+		rasterizePolygon(points,count,table.Edges,table.Active);
+	}
+
+
+	/**
+	 * @brief The edge table scanline rasterizer.
+	 *
+	 * Non-horizontal edges are sorted into an edge table by their top row. Each row the edges that
+	 * start on that row join the active list, the edges that have ended leave it and the active list is
+	 * insertion sorted by X, which is cheap because it is nearly always sorted already. Pairs of
+	 * intercepts become spans that are batched up and handed to fillSpans().
+	 *
+	 * @param points The vertices of the polygon.
+	 * @param count The number of vertices.
+	 * @param edges Storage for up to 'count' edges.
+	 * @param active Storage for up to 'count' active edge pointers.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::rasterizePolygon(const Point *points,uint8_t count,PolygonEdge *edges,PolygonEdge **active) const {
+
+		uint8_t i,j,numEdges,numActive,next;
+		int16_t y,dx;
+		PolygonEdge *edge;
+		const Point *top,*bottom;
+		Span spans[POLYGON_SPAN_BATCH];
+		uint8_t numSpans;
+
+		// build the edge table
+
+		numEdges=0;
+
+		for(i=0;i<count;i++) {
+
+			top=&points[i];
+			bottom=&points[i==count-1 ? 0 : i+1];
+
+			// horizontal edges do not cross any rows
+
+			if(top->Y==bottom->Y)
+				continue;
+
+			if(top->Y>bottom->Y) {
+				const Point *t=top;
+				top=bottom;
+				bottom=t;
+			}
+
+			edge=&edges[numEdges];
+
+			edge->YMin=top->Y;
+			edge->YMax=bottom->Y;
+			edge->X=top->X;
+			edge->Remainder=0;
+			edge->Dy=bottom->Y-top->Y;
+
+			// floor division so that the remainder step is never negative
+
+			dx=bottom->X-top->X;
+			edge->Step=dx/edge->Dy;
+			edge->RemainderStep=dx % edge->Dy;
+
+			if(edge->RemainderStep<0) {
+				edge->Step--;
+				edge->RemainderStep+=edge->Dy;
+			}
+
+			// insertion sort into the table by the top row
+
+			for(j=numEdges;j>0 && edges[j-1].YMin>edge->YMin;j--);
+
+			if(j!=numEdges) {
+				PolygonEdge e=*edge;
+				memmove(&edges[j+1],&edges[j],(numEdges-j)*sizeof(PolygonEdge));
+				edges[j]=e;
+			}
+
+			numEdges++;
+		}
+
+		if(numEdges==0)
+			return;
+
+		// walk down the rows
+
+		y=edges[0].YMin;
+		next=numActive=numSpans=0;
+
+		do {
+
+			// drop the edges that have ended
+
+			for(i=j=0;i<numActive;i++)
+				if(active[i]->YMax>y)
+					active[j++]=active[i];
+
+			numActive=j;
+
+			// add the edges that start on this row
+
+			while(next<numEdges && edges[next].YMin==y)
+				active[numActive++]=&edges[next++];
+
+			// insertion sort the active list by X
+
+			for(i=1;i<numActive;i++) {
+
+				edge=active[i];
+
+				for(j=i;j>0 && active[j-1]->getColumn()>edge->getColumn();j--)
+					active[j]=active[j-1];
+
+				active[j]=edge;
+			}
+
+			// output the spans between pairs of intercepts
+
+			for(i=0;i+1<numActive;i+=2) {
+
+				int16_t xstart=active[i]->getColumn();
+				int16_t xend=active[i+1]->getColumn();
+
+				if(xend>xstart) {
+
+					spans[numSpans++]=Span(xstart,y,xend-xstart);
+
+					if(numSpans==POLYGON_SPAN_BATCH) {
+						fillSpans(spans,numSpans);
+						numSpans=0;
+					}
+				}
+			}
+
+			// step each active edge down to the next row
+
+			for(i=0;i<numActive;i++) {
+
+				edge=active[i];
+
+				edge->X+=edge->Step;
+				edge->Remainder+=edge->RemainderStep;
+
+				if(edge->Remainder>=edge->Dy) {
+					edge->Remainder-=edge->Dy;
+					edge->X++;
+				}
+			}
+
+			y++;
+
+		} while(numActive>0 || next<numEdges);
+
+		fillSpans(spans,numSpans);
+	}
+}
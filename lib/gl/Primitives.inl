@@ -53,6 +53,9 @@ namespace lcd {
 	template<class TDevice,class TAccessMode>
 	inline void GraphicsLibrary<TDevice,TAccessMode>::plotPoint(int16_t x,int16_t y) const {
 
+		if(!isVisible(x,y))
+			return;
+
 		this->moveTo(
 				Rectangle(
 						x,
@@ -73,7 +76,10 @@ namespace lcd {
 	 * Uses the bresenham algorithm for lines that are not straight. This is an optimised version
 	 * of the algorithm that takes advantage of the windowed capability of the TFT panel controller.
 	 * See my website for a writeup of how this algorithm works and a performance analysis versus
-	 * standard bresenham and the 'Extremely Fast Line Algorithm'.
+	 * standard bresenham and the 'Extremely Fast Line Algorithm'. Lines that are steeper than 45
+	 * degrees are handed off to drawSteepLine(). Lines that are entirely on one side of the clip
+	 * rectangle are rejected with the Cohen-Sutherland out-codes and lines that cross the edge of it
+	 * are trimmed by clipLine().
 	 *
 	 * @param p1 The first end of the line.
 	 * @param p2 The other end of the line.
@@ -82,6 +88,8 @@ namespace lcd {
 	template<class TDevice,class TAccessMode>
 	inline void GraphicsLibrary<TDevice,TAccessMode>::drawLine(const Point& p1,const Point& p2) const {
 
+		uint8_t code1,code2;
+
 		// optimisation for straight lines. filling rectangles is much more efficient than plotting points
 
 		if(p1.X==p2.X)
@@ -90,6 +98,19 @@ namespace lcd {
 			fillRectangle(Rectangle(Min(p1.X,p2.X),p1.Y,Abs(p2.X-p1.X)+1,1));
 		else {
 
+			// lines that are entirely outside the clip rectangle cost nothing
+
+			code1=getOutCode(p1);
+			code2=getOutCode(p2);
+
+			if((code1 & code2)!=0)
+				return;
+
+			if(Abs(p2.Y-p1.Y)>Abs(p2.X-p1.X)) {
+				drawSteepLine(p1,p2,(code1 | code2)!=0);
+				return;
+			}
+
 			int16_t x0,x1,y0,y1;
 
 			x0=p1.X;
@@ -122,6 +143,11 @@ namespace lcd {
 			int16_t err=dx-dy;
 			bool xinc;
 
+			// skip forward to the first visible pixel and stop at the last one
+
+			if((code1 | code2)!=0 && !clipLine(x0,y0,x1,y1,err,false))
+				return;
+
 			// set the drawing rectangle that we need and plot the first point
 
 			this->moveTo(x0,y0,this->getXmax(),this->getYmax());
@@ -182,4 +208,268 @@ namespace lcd {
 			}
 		}
 	}
+
+
+	/**
+	 * @brief Draw a line that is steeper than 45 degrees.
+	 *
+	 * This is the y-major counterpart of the optimised bresenham in drawLine(). The drawing window
+	 * is set to a single pixel wide column that extends to the bottom of the display. The address
+	 * counter wraps back to the same column on the next row after every pixel so a vertical run of
+	 * pixels becomes a sequence of writePixelAgain() calls. The window only needs to be moved when
+	 * X changes.
+	 *
+	 * @param p1 The first end of the line.
+	 * @param p2 The other end of the line.
+	 * @param clip true if the line crosses the edge of the clip rectangle.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::drawSteepLine(const Point& p1,const Point& p2,bool clip) const {
+
+		int16_t x0,x1,y0,y1;
+
+		x0=p1.X;
+		y0=p1.Y;
+		x1=p2.X;
+		y1=p2.Y;
+
+		// always go down the display
+
+		if(y0>y1) {
+
+			int16_t t;
+
+			t=x0;
+			x0=x1;
+			x1=t;
+
+			t=y0;
+			y0=y1;
+			y1=t;
+		}
+
+		// calculate constants up-front
+
+		int16_t dy=y1-y0;
+		int16_t dx=Abs(x1-x0);
+		int16_t sx=x0<x1 ? 1 : -1;
+		int16_t mdx=-dx;
+		int16_t err=dy-dx;
+		bool yinc;
+
+		// skip forward to the first visible pixel and stop at the last one
+
+		if(clip && !clipLine(x0,y0,x1,y1,err,true))
+			return;
+
+		// set the single column window and plot the first point
+
+		this->moveTo(x0,y0,x0,this->getYmax());
+		this->beginWriting();
+		this->writePixel(_foreground);
+
+		while(x0!=x1 || y0!=y1) {
+
+			int16_t e2=2*err;
+
+			if(e2>mdx) {
+
+				err-=dx;
+				y0++;
+
+				// make a note that Y has incremented
+
+				yinc=true;
+			}
+			else
+				yinc=false;
+
+			if(x0==x1 && y0==y1) {
+
+				// plot the pending Y increment before returning
+
+				if(yinc)
+					this->writePixelAgain(_foreground);
+				break;
+			}
+
+			if(e2<dy) {
+				err+=dy;
+				x0+=sx;
+
+				// X has changed. Move the column and reset the Y position
+
+				this->moveX(x0,x0);
+
+				if(yinc)
+					this->moveY(y0,this->getYmax());
+
+				this->beginWriting();
+				this->writePixel(_foreground);
+			}
+			else {
+
+				// X has not changed, the address counter has already wrapped
+				// to the next row in this column
+
+				if(yinc)
+					this->writePixelAgain(_foreground);
+			}
+		}
+	}
+
+
+	/**
+	 * @brief Trim a bresenham line to the clip rectangle.
+	 *
+	 * Moving the ends of the line to where the ideal line crosses the clip rectangle and then restarting
+	 * bresenham would round differently to the unclipped line, so a line redrawn through a clip rectangle
+	 * would not match what is already on the display. Instead the number of minor axis steps taken after
+	 * n major axis steps is calculated directly, which gives the range of steps that are inside the clip
+	 * rectangle and the exact state of the bresenham error term at the first of them.
+	 *
+	 * @param x0 The x co-ord of the first end. Updated to the first visible pixel.
+	 * @param y0 The y co-ord of the first end. Updated to the first visible pixel.
+	 * @param x1 The x co-ord of the other end. Updated to the last visible pixel.
+	 * @param y1 The y co-ord of the other end. Updated to the last visible pixel.
+	 * @param err The bresenham error term. Updated to match the first visible pixel.
+	 * @param steep true if Y is the major axis. The major axis co-ord must increase from the first end to the other.
+	 * @return false if no part of the line is inside the clip rectangle.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline bool GraphicsLibrary<TDevice,TAccessMode>::clipLine(int16_t& x0,int16_t& y0,int16_t& x1,int16_t& y1,int16_t& err,bool steep) const {
+
+		int16_t major0,minor0,majorLength,minorLength,majorMin,majorMax,minorMin,minorMax,first,last,kfirst,klast;
+		int32_t kmin,kmax;
+		int8_t minorStep;
+
+		if(steep) {
+			major0=y0;
+			minor0=x0;
+			majorLength=y1-y0;
+			minorLength=Abs(x1-x0);
+			minorStep=x0<x1 ? 1 : -1;
+			majorMin=_clip.Y;
+			majorMax=_clip.Y+_clip.Height-1;
+			minorMin=_clip.X;
+			minorMax=_clip.X+_clip.Width-1;
+		}
+		else {
+			major0=x0;
+			minor0=y0;
+			majorLength=x1-x0;
+			minorLength=Abs(y1-y0);
+			minorStep=y0<y1 ? 1 : -1;
+			majorMin=_clip.X;
+			majorMax=_clip.X+_clip.Width-1;
+			minorMin=_clip.Y;
+			minorMax=_clip.Y+_clip.Height-1;
+		}
+
+		// the range of steps that are inside the clip rectangle on the major axis
+
+		first=Max<int16_t>(0,majorMin-major0);
+		last=Min<int16_t>(majorLength,majorMax-major0);
+
+		// the range of minor axis steps that are inside the clip rectangle
+
+		if(minorStep>0) {
+			kmin=(int32_t)minorMin-minor0;
+			kmax=(int32_t)minorMax-minor0;
+		}
+		else {
+			kmin=(int32_t)minor0-minorMax;
+			kmax=(int32_t)minor0-minorMin;
+		}
+
+		if(kmax<0 || kmin>minorLength)
+			return false;
+
+		kmax=Min<int32_t>(kmax,minorLength);
+
+		// convert it to major axis steps and intersect
+
+		if(kmin>0)
+			first=Max<int16_t>(first,(int16_t)(((int32_t)majorLength*(2*kmin-1))/(2*minorLength))+1);
+
+		last=Min<int16_t>(last,(int16_t)(((int32_t)majorLength*(2*kmax+1))/(2*minorLength)));
+
+		if(first>last)
+			return false;
+
+		// move the ends and set the error term for the first visible pixel
+
+		kfirst=getLineMinorSteps(majorLength,minorLength,first);
+		klast=getLineMinorSteps(majorLength,minorLength,last);
+
+		err=(int16_t)((int32_t)majorLength-minorLength-(int32_t)first*minorLength+(int32_t)kfirst*majorLength);
+
+		if(steep) {
+			y1=y0+last;
+			x1=x0+minorStep*klast;
+			y0+=first;
+			x0+=minorStep*kfirst;
+		}
+		else {
+			x1=x0+last;
+			y1=y0+minorStep*klast;
+			x0+=first;
+			y0+=minorStep*kfirst;
+		}
+
+		return true;
+	}
+
+
+	/**
+	 * Get the number of minor axis steps that bresenham has taken after a number of major axis steps.
+	 * This is the smallest k where 2*majorLength*k >= 2*minorLength*steps-majorLength.
+	 * @param majorLength The length of the line on the major axis.
+	 * @param minorLength The length of the line on the minor axis.
+	 * @param steps The number of major axis steps.
+	 * @return The number of minor axis steps.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline int16_t GraphicsLibrary<TDevice,TAccessMode>::getLineMinorSteps(int16_t majorLength,int16_t minorLength,int16_t steps) {
+
+		int32_t numerator;
+
+		numerator=2*(int32_t)minorLength*steps-majorLength;
+
+		if(numerator<=0)
+			return 0;
+
+		return (int16_t)((numerator+2*(int32_t)majorLength-1)/(2*(int32_t)majorLength));
+	}
+
+
+	/**
+	 * Get the Cohen-Sutherland out-code for a point. Bit 0 is left of the clip rectangle, bit 1 is right,
+	 * bit 2 is above and bit 3 is below.
+	 * @param p The point.
+	 * @return The out-code.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline uint8_t GraphicsLibrary<TDevice,TAccessMode>::getOutCode(const Point& p) const {
+
+		uint8_t code;
+
+		code=0;
+
+		if(p.X<_clip.X)
+			code|=1;
+		else if(p.X>=_clip.X+_clip.Width)
+			code|=2;
+
+		if(p.Y<_clip.Y)
+			code|=4;
+		else if(p.Y>=_clip.Y+_clip.Height)
+			code|=8;
+
+		return code;
+	}
 }
@@ -157,6 +157,27 @@ namespace lcd {
 		bool containsPoint(const Point& p) const {
 			return p.X>=X && p.X<=X+Width && p.Y>=Y && p.Y<=Y+Height;
 		}
+
+
+		/**
+		 * Get the area covered by this rectangle
+		 * @return The width multiplied by the height.
+		 */
+
+		uint32_t getArea() const {
+			return static_cast<uint32_t>(Width)*static_cast<uint32_t>(Height);
+		}
+
+
+		/**
+		 * Check if this rectangle shares any pixels with another rectangle.
+		 * @param rc The other rectangle.
+		 * @return true if they intersect.
+		 */
+
+		bool intersects(const Rectangle& rc) const {
+			return X<rc.X+rc.Width && rc.X<X+Width && Y<rc.Y+rc.Height && rc.Y<Y+Height;
+		}
 	};
 
 
@@ -36,9 +36,7 @@ namespace lcd {
 
 	template<class TDevice,class TAccessMode>
 	inline void GraphicsLibrary<TDevice,TAccessMode>::fillRectangle(const Rectangle& rc) const {
-
-		this->moveTo(rc);
-		this->fillPixels((int32_t)rc.Width*(int32_t)rc.Height,_foreground);
+		fillClippedRectangle(rc,_foreground);
 	}
 
 
@@ -49,9 +47,27 @@ namespace lcd {
 
 	template<class TDevice,class TAccessMode>
 	inline void GraphicsLibrary<TDevice,TAccessMode>::clearRectangle(const Rectangle& rc) const {
+		fillClippedRectangle(rc,_background);
+	}
+
+
+	/**
+	 * Fill the part of a rectangle that is inside the clip rectangle. Nothing is sent to the panel
+	 * if the rectangle is entirely outside.
+	 * @param rc The rectangle to fill.
+	 * @param cr The colour to fill with.
+	 */
 
-		this->moveTo(rc);
-		this->fillPixels((int32_t)rc.Width*(int32_t)rc.Height,_background);
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::fillClippedRectangle(const Rectangle& rc,const UnpackedColour& cr) const {
+
+		Rectangle clipped(rc);
+
+		if(!clipRectangle(clipped))
+			return;
+
+		this->moveTo(clipped);
+		this->fillPixels((int32_t)clipped.Width*(int32_t)clipped.Height,cr);
 	}
 
 
@@ -87,119 +103,4 @@ namespace lcd {
 		rc.X+=rect.Width-1;
 		fillRectangle(rc);
 	}
-
-
-	/**
-	 * Gradient fill a rectangle from the foreground to the background colour. This uses line
-	 * draing to create the gradient, which will fall back to a fast rectangle fill because
-	 * all the lines are straight.
-	 * @param rc The bounding rectangle of the entire gradient.
-	 * @param dir The direction of the gradient, horizontal or vertical.
-	 * @param first The starting colour of the gradient.
-	 * @param last The ending colour of the gradient.
-	 */
-
-	template<class TDevice,class TAccessMode>
-	inline void GraphicsLibrary<TDevice,TAccessMode>::gradientFillRectangle(
-							const Rectangle& rc,
-							Direction dir,
-							TColour first,
-							TColour last) const {
-
-		uint8_t r1,g1,b1,r2,g2,b2;
-		int32_t rstep,gstep,bstep;
-		int16_t raccum,gaccum,baccum,i,r,g,b,val,div,xdisp,ydisp,px;
-		Rectangle rcBlock;
-		TColour cr;
-		UnpackedColour lineColour;
-
-		// get the start and end colour components
-
-		r1=first >> 16;
-		g1=first >> 8;
-		b1=first;
-
-		r2=last >> 16;
-		g2=last >> 8;
-		b2=last;
-
-		// calculate initial sizes and directions
-
-		rcBlock.X=rc.X;
-		rcBlock.Y=rc.Y;
-
-		if(dir==VERTICAL) {
-			rcBlock.Width=rc.Width;
-			rcBlock.Height=1;
-			xdisp=0;
-			ydisp=1;
-			div=rc.Height;
-			px=rc.Width;
-		}
-		else {
-			rcBlock.Width=1;
-			rcBlock.Height=rc.Height;
-			xdisp=1;
-			ydisp=0;
-			div=rc.Width;
-			px=rc.Height;
-		}
-
-		// calculate the step values, scaled up x256 for greater precision
-
-		rstep=(((int32_t)r2-(int32_t)r1)*256)/div;
-		gstep=(((int32_t)g2-(int32_t)g1)*256)/div;
-		bstep=(((int32_t)b2-(int32_t)b1)*256)/div;
-
-		// initial colour and reset accumulators
-
-		cr=first;
-		raccum=gaccum=baccum=0;
-
-		r=r1;
-		g=g1;
-		b=b1;
-
-		for(i=0;i<div;i++) {
-
-			// draw the line
-
-			this->moveTo(rcBlock);
-			this->unpackColour(cr,lineColour);
-			this->fillPixels(px,lineColour);
-
-			// update for the next line
-
-			rcBlock.X+=xdisp;
-			rcBlock.Y+=ydisp;
-
-			// update the accumulators
-
-			raccum+=rstep;
-			gaccum+=gstep;
-			baccum+=bstep;
-
-			// if any accumulator has moved past 0 (scaled by 256) then add that accumulator
-			// to the colour and reduce the accumulator accordingly
-
-			if((val=raccum/256)!=0) {
-				r+=val;
-				raccum-=val*256;
-			}
-
-			if((val=gaccum/256)!=0) {
-				g+=val;
-				gaccum-=val*256;
-			}
-
-			if((val=baccum/256)!=0) {
-				b+=val;
-				baccum-=val*256;
-			}
-
-			// if any accumulator was reset then we have a new colour
-
-			cr=(uint32_t)r<<16 | (uint32_t)g<<8 | b;
-		}
-	}
 }
@@ -0,0 +1,77 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file Span.h
+ * @brief The definition of the Span structure
+ * @ingroup GraphicsLibrary
+ */
+
+
+#pragma once
+
+
+namespace lcd {
+
+	/**
+	 * @brief A horizontal run of pixels on a single row
+	 * @ingroup GraphicsLibrary
+	 */
+
+	struct Span {
+
+		/**
+		 * @brief The panel co-ordinates of the left-most pixel in the run
+		 */
+
+		int16_t X,Y;
+
+
+		/**
+		 * @brief The number of pixels in the run
+		 */
+
+		int16_t Length;
+
+
+		/**
+		 * Default constructor
+		 */
+
+		Span()
+			: X(), Y(), Length() {
+		}
+
+
+		/**
+		 * Constructor with parameters
+		 * @param x X-coord of the first pixel
+		 * @param y Y-coord of the row
+		 * @param length The number of pixels in the run
+		 */
+
+		Span(int16_t x,int16_t y,int16_t length) :
+			X(x),
+			Y(y),
+			Length(length) {
+		}
+	};
+}
@@ -0,0 +1,129 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+/**
+ * @file SpanText.inl
+ * @brief Transparent text output functions
+ *
+ * Span fonts are exported by FontConv with the "Arduino spans" target. Each character row is stored
+ * as the runs of foreground pixels on that row. Each run is written with one window update and one
+ * fillPixels() call and the background is never touched, so text can be written over gradients,
+ * bitmaps and JPEGs without repainting the area first.
+ *
+ * @ingroup GraphicsLibrary
+ */
+
+#pragma once
+
+
+namespace lcd {
+
+
+	/**
+	 * Write a null terminated string of characters to the display in the foreground colour. Background
+	 * pixels, including the spacing between characters, are left as they are.
+	 * @param p The upper-left co-ordinate on the panel to start writing at.
+	 * @param font The SpanFont that the characters will come from.
+	 * @param str The character string to write.
+	 * @return The pixel size of the string.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline Size GraphicsLibrary<TDevice,TAccessMode>::writeString(const Point& p,const SpanFont& font,const char *str) const {
+
+		Point pos(p);
+		FontChar fc;
+		int16_t width;
+		Size s;
+
+		s.Height=font.getHeight();
+		s.Width=0;
+
+		while(*str) {
+
+			font.getCharacter(*str++,fc);
+			writeCharacter(pos,font,fc);
+
+			width=fc.PixelWidth+font.getCharacterSpacing();
+			pos.X+=width;
+			s.Width+=width;
+		}
+
+		return s;
+	}
+
+
+	/**
+	 * Write a single character from a span font in the foreground colour. Only the parts of the
+	 * runs that lie inside the clip rectangle are written.
+	 * @param p The upper-left co-ordinate on the panel to start writing at.
+	 * @param font The SpanFont that the character comes from.
+	 * @param fc The FontChar structure defining the character. You can use SpanFont.getCharacter() to get this.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::writeCharacter(const Point& p,const SpanFont& font,const FontChar& fc) const {
+
+		const uint8_t *ptr;
+		uint8_t y,count,x,length;
+		int16_t row,xstart,xend,clipRight,clipBottom;
+
+		clipRight=_clip.X+_clip.Width;
+		clipBottom=_clip.Y+_clip.Height;
+
+		// nothing to do if the character cell is entirely outside the clip rectangle
+
+		if(p.X>=clipRight || p.X+fc.PixelWidth<=_clip.X || p.Y>=clipBottom || p.Y+font.getHeight()<=_clip.Y)
+			return;
+
+		ptr=fc.Data;
+
+		for(y=0;y<font.getHeight();y++) {
+
+			row=p.Y+y;
+
+			if(row>=clipBottom)
+				return;
+
+			count=pgm_read_byte(ptr++);
+
+			// rows above the clip rectangle are stepped over
+
+			if(row<_clip.Y) {
+				ptr+=count*2;
+				continue;
+			}
+
+			while(count--) {
+
+				x=pgm_read_byte(ptr++);
+				length=pgm_read_byte(ptr++);
+
+				xstart=Max<int16_t>(p.X+x,_clip.X);
+				xend=Min<int16_t>(p.X+x+length,clipRight);
+
+				if(xend>xstart) {
+					this->moveTo(xstart,row,xend-1,row);
+					this->fillPixels(xend-xstart,_foreground);
+				}
+			}
+		}
+	}
+}
@@ -38,7 +38,9 @@ namespace lcd {
 
 	/**
 	 * Write a null terminated string of characters to the display. Characters are written in the foreground colour
-	 * and blank spaces are filled using the background colour. Additional spacing between characters is not filled.
+	 * and blank spaces are filled using the background colour. The spacing columns between characters are also
+	 * filled with the background colour. Up to TEXT_WINDOW_GLYPHS characters are written through a single
+	 * window that covers all of them so that the window is not moved for each character.
 	 * @param p The upper-left point to write out at.
 	 * @param font The font structure reference created by FontConv and compiled in by you.
 	 * @param str The character string to write out.
@@ -48,23 +50,28 @@ namespace lcd {
 	template<class TDevice,class TAccessMode>
 	inline Size GraphicsLibrary<TDevice,TAccessMode>::writeString(const Point& p,const Font& font,const char *str) const {
 
-		const char *ptr;
-		Point pos(p);
-		FontChar fc;
+		FontChar chars[TEXT_WINDOW_GLYPHS];
+		uint8_t count;
 		int16_t width;
+		Point pos(p);
 		Size s;
 
 		s.Height=font.getHeight();
 		s.Width=0;
 
-		// print each character in turn
+		while(*str) {
 
-		for(ptr=str;*ptr;ptr++) {
+			// gather the next batch of characters and the width that they cover
 
-			font.getCharacter(*ptr,fc);
-			writeCharacter(pos,font,fc);
+			width=0;
+
+			for(count=0;*str && count<TEXT_WINDOW_GLYPHS;count++) {
+				font.getCharacter(*str++,chars[count]);
+				width+=chars[count].PixelWidth+font.getCharacterSpacing();
+			}
+
+			writeCharacters(pos,font,chars,count,width);
 
-			width=fc.PixelWidth+font.getCharacterSpacing();
 			pos.X+=width;
 			s.Width+=width;
 		}
@@ -74,7 +81,76 @@ namespace lcd {
 
 
 	/**
-	 * Write a single character from a bitmap font
+	 * Write a batch of characters through one window. The window covers the characters and the spacing
+	 * columns that follow each of them. Each scanline of the window is streamed across all the characters
+	 * in turn. Only the part of the window that lies inside the clip rectangle is written.
+	 * @param p The upper-left point to write out at.
+	 * @param font The font that the characters come from.
+	 * @param chars The characters to write.
+	 * @param count The number of characters.
+	 * @param width The total width of the characters including the spacing after each one.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::writeCharacters(const Point& p,const Font& font,const FontChar *chars,uint8_t count,int16_t width) const {
+
+		Rectangle rc,visible;
+		GlyphRun run;
+		int16_t x,left,right,visibleRight;
+		uint8_t i,y,spacing;
+
+		rc.X=p.X;
+		rc.Y=p.Y;
+		rc.Width=width;
+		rc.Height=font.getHeight();
+
+		visible=rc;
+
+		if(!clipRectangle(visible))
+			return;
+
+		this->moveTo(visible);
+		this->beginWriting();
+
+		spacing=font.getCharacterSpacing();
+		visibleRight=visible.X+visible.Width;
+		run.Length=0;
+
+		for(y=visible.Y-rc.Y;y<visible.Y-rc.Y+visible.Height;y++) {
+
+			x=rc.X;
+
+			for(i=0;i<count;i++) {
+
+				// the visible part of the glyph on this scanline
+
+				left=Max(x,visible.X);
+				right=Min<int16_t>(x+chars[i].PixelWidth,visibleRight);
+
+				if(left<right)
+					addGlyphBits(run,chars[i].Data,y*chars[i].PixelWidth+(left-x),right-left);
+
+				x+=chars[i].PixelWidth;
+
+				// the visible part of the spacing after it
+
+				left=Max(x,visible.X);
+				right=Min<int16_t>(x+spacing,visibleRight);
+
+				if(left<right)
+					addGlyphRun(run,false,right-left);
+
+				x+=spacing;
+			}
+		}
+
+		flushGlyphRun(run);
+	}
+
+
+	/**
+	 * Write a single character from a bitmap font. Only the part of the character that lies
+	 * inside the clip rectangle is written.
 	 * @param p The upper-left point to write out at.
 	 * @param font The font structure reference created by FontConv and compiled in by you.
 	 * @param fc The FontChar structure defining the character. You can use Font.getCharacter() to get this.
@@ -83,56 +159,146 @@ namespace lcd {
 	template<class TDevice,class TAccessMode>
 	inline void GraphicsLibrary<TDevice,TAccessMode>::writeCharacter(const Point& p,const Font& font,const FontChar& fc) const {
 
-		const uint8_t *ptr;
-		uint8_t value,i,x,y;
+		Rectangle rc,visible;
+		GlyphRun run;
+		uint8_t y;
 
 		// move to the rectangle that encloses the character
 
-		this->moveTo(
-			Rectangle(
-					p.X,
-					p.Y,
-					fc.PixelWidth,
-					font.getHeight()
-			)
-		);
-
-		// get the first value
+		rc.X=p.X;
+		rc.Y=p.Y;
+		rc.Width=fc.PixelWidth;
+		rc.Height=font.getHeight();
 
-		ptr=fc.Data;
-		value=pgm_read_byte(ptr);
-		ptr++;
-		i=1;
+		visible=rc;
 
-		// go from top to bottom, left to right
+		if(!clipRectangle(visible))
+			return;
 
+		this->moveTo(visible);
 		this->beginWriting();
 
-		for(y=0;y<font.getHeight();y++) {
+		run.Length=0;
+
+		if(visible.Width!=rc.Width || visible.Height!=rc.Height) {
+
+			// partially visible: index directly into the bit stream for the visible pixels
+
+			for(y=visible.Y-rc.Y;y<visible.Y-rc.Y+visible.Height;y++)
+				addGlyphBits(run,fc.Data,y*fc.PixelWidth+(visible.X-rc.X),visible.Width);
+		}
+		else {
+
+			// fully visible: the window matches the glyph so the whole bit stream is one sequence
 
-			for(x=0;x<fc.PixelWidth;x++) {
+			addGlyphBits(run,fc.Data,0,fc.PixelWidth*font.getHeight());
+		}
 
-				// if there's a value at this position, write a pixel
+		flushGlyphRun(run);
+	}
 
-				if((value & i)!=0)
-					this->writePixel(_foreground);
-				else
-					this->writePixel(_background);
 
-				// move to the next bit, or the next byte if we've run out of bits
+	/**
+	 * Add a sequence of glyph bits to the pending run. Bits are stored LSB first and packed across rows.
+	 * Whole bytes that are all background or all foreground are added in one step, which makes short
+	 * work of the empty rows above and below the glyph body. Only the bytes that hold the bits are read.
+	 * @param run The pending run.
+	 * @param data The glyph bit stream in flash.
+	 * @param index The index of the first bit.
+	 * @param count The number of bits to add.
+	 */
 
-				if(i==0x80) {
-					i=1;
-					value=pgm_read_byte(ptr);
-					ptr++;
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::addGlyphBits(GlyphRun& run,const uint8_t *data,uint16_t index,uint16_t count) const {
+
+		const uint8_t *ptr;
+		uint8_t value,mask;
+
+		if(!count)
+			return;
+
+		ptr=data+(index >> 3);
+		mask=1 << (index & 7);
+		value=pgm_read_byte(ptr++);
+
+		for(;;) {
+
+			if(mask==1 && count>=8 && (value==0 || value==0xff)) {
+
+				// a whole byte of the same colour
+
+				addGlyphRun(run,value!=0,8);
+				count-=8;
+			}
+			else {
+
+				addGlyphRun(run,(value & mask)!=0,1);
+				count--;
+
+				if(mask!=0x80) {
+					mask<<=1;
+
+					if(count)
+						continue;
 				}
-				else
-					i<<=1;
 			}
+
+			if(!count)
+				return;
+
+			// next byte
+
+			mask=1;
+			value=pgm_read_byte(ptr++);
+		}
+	}
+
+
+	/**
+	 * Add pixels to the pending run. A change of colour flushes the pending run to the display.
+	 * @param run The pending run.
+	 * @param foreground true for foreground pixels, false for background.
+	 * @param count The number of pixels.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::addGlyphRun(GlyphRun& run,bool foreground,uint16_t count) const {
+
+		if(run.Length && run.Foreground==foreground && run.Length<=0xffff-count)
+			run.Length+=count;
+		else {
+
+			flushGlyphRun(run);
+
+			run.Foreground=foreground;
+			run.Length=count;
 		}
 	}
 
 
+	/**
+	 * Write a pending run to the display. The first pixel is a full write and the remainder are written
+	 * with writePixelAgain(). Assumes that the caller has already issued the beginWriting() command.
+	 * @param run The run to write. Nothing is written if it is empty.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline void GraphicsLibrary<TDevice,TAccessMode>::flushGlyphRun(const GlyphRun& run) const {
+
+		uint16_t count;
+
+		if((count=run.Length)==0)
+			return;
+
+		const UnpackedColour& cr(run.Foreground ? _foreground : _background);
+
+		this->writePixel(cr);
+
+		while(--count)
+			this->writePixelAgain(cr);
+	}
+
+
 	/**
 	 * Measure the rectangle required to display the given null terminated string.
 	 * @param The font to measure from. This is compatible with LZG and bitmap fonts.
@@ -145,15 +311,12 @@ namespace lcd {
 
 		Size size;
 		uint8_t c;
-		FontChar fc;
 
 		size.Height=font.getHeight();
 		size.Width=0;
 
-		while((c=*str++) != 0) {
-			font.getCharacter(c,fc);
-			size.Width+=fc.PixelWidth+font.getCharacterSpacing();
-		}
+		while((c=*str++) != 0)
+			size.Width+=font.getCharacterWidth(c)+font.getCharacterSpacing();
 
 		return size;
 	}
@@ -285,6 +448,72 @@ namespace lcd {
 	}
 
 
+	/**
+	 * Output a Q16.16 fixed point number using integer arithmetic only.
+	 * @param val the value to write out.
+	 * @return a self reference to allow chaining of << operators.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline GraphicsLibrary<TDevice,TAccessMode>& GraphicsLibrary<TDevice,TAccessMode>::operator<<(const FixedPoint& val) {
+		return writeNumber(val);
+	}
+
+
+	/**
+	 * Output an integer scaled by a power of ten, e.g. hundredths written as "23.45".
+	 * @param val the value to write out.
+	 * @return a self reference to allow chaining of << operators.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline GraphicsLibrary<TDevice,TAccessMode>& GraphicsLibrary<TDevice,TAccessMode>::operator<<(const ScaledInteger& val) {
+		return writeNumber(val);
+	}
+
+
+	/**
+	 * Output an unsigned decimal integer, optionally padded with leading zeros.
+	 * @param val the value to write out.
+	 * @return a self reference to allow chaining of << operators.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline GraphicsLibrary<TDevice,TAccessMode>& GraphicsLibrary<TDevice,TAccessMode>::operator<<(const UnsignedInteger& val) {
+		return writeNumber(val);
+	}
+
+
+	/**
+	 * Output an unsigned hexadecimal integer, optionally padded with leading zeros.
+	 * @param val the value to write out.
+	 * @return a self reference to allow chaining of << operators.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	inline GraphicsLibrary<TDevice,TAccessMode>& GraphicsLibrary<TDevice,TAccessMode>::operator<<(const HexInteger& val) {
+		return writeNumber(val);
+	}
+
+
+	/**
+	 * Format a number with NumberFormat into a stack buffer and write it at the stream position.
+	 * @param val the value to write out.
+	 * @return a self reference to allow chaining of << operators.
+	 */
+
+	template<class TDevice,class TAccessMode>
+	template<class TNumber>
+	inline GraphicsLibrary<TDevice,TAccessMode>& GraphicsLibrary<TDevice,TAccessMode>::writeNumber(const TNumber& val) {
+
+		char str[NumberFormat::MAX_LENGTH];
+
+		NumberFormat::format(val,str);
+		_streamSelectedPoint.X+=writeString(_streamSelectedPoint,*_streamSelectedFont,str).Width;
+		return *this;
+	}
+
+
 	/**
 	 * Derived from http://code.google.com/p/stringencoders/source/browse/trunk/src/modp_numtoa.c
 	 * "string encoders: A collection of high performance c-string transformations". This converts
@@ -0,0 +1,143 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file host/Arduino.h
+ * @brief Minimal stand-in for the Arduino core when the library is compiled on a desktop host.
+ *
+ * Only the handful of core functions and types that this library references are provided. Add
+ * the 'host' directory to the front of your include path when building a host program (e.g. a
+ * unit test that drives a HostAccessMode) and this header will be picked up in place of the
+ * real Arduino.h. Flash addresses are passed around as 32-bit integers so host programs should
+ * be linked as a non-position-independent executable (-no-pie) to keep static data within the
+ * low 4Gb of the address space.
+ */
+
+#pragma once
+
+#if defined(__AVR__)
+#error "host/Arduino.h must not be used for an AVR build"
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "avr/pgmspace.h"
+
+
+/*
+ * Pin control is a no-op on the host
+ */
+
+enum {
+	LOW=0,
+	HIGH=1,
+	INPUT=0,
+	OUTPUT=1
+};
+
+inline void pinMode(uint8_t /* pin */,uint8_t /* mode */) {}
+inline void digitalWrite(uint8_t /* pin */,uint8_t /* value */) {}
+inline void analogWrite(uint8_t /* pin */,int /* value */) {}
+
+
+/*
+ * Time does not pass on the host
+ */
+
+inline void delay(unsigned long /* ms */) {}
+inline void delayMicroseconds(unsigned int /* us */) {}
+
+
+/*
+ * The Arduino core provides min/max as macros. Function templates are used here so that the
+ * standard library headers can still be included after this one.
+ */
+
+template<class T> inline T min(T a,T b) { return a<b ? a : b; }
+template<class T> inline T max(T a,T b) { return a>b ? a : b; }
+
+
+/*
+ * avr-libc non-standard integer to string conversions
+ */
+
+inline char *ltoa(long value,char *str,int radix) {
+
+	char *ptr,*start;
+	unsigned long uvalue;
+
+	ptr=str;
+
+	if(value<0 && radix==10) {
+		*ptr++='-';
+		uvalue=-static_cast<unsigned long>(value);
+	}
+	else
+		uvalue=static_cast<unsigned long>(value);
+
+	start=ptr;
+
+	do {
+		uint8_t digit=uvalue % radix;
+		*ptr++=digit<10 ? '0'+digit : 'a'+digit-10;
+		uvalue/=radix;
+	} while(uvalue);
+
+	*ptr='\0';
+
+	// digits were generated in reverse order
+
+	for(ptr--;start<ptr;start++,ptr--) {
+		char c=*start;
+		*start=*ptr;
+		*ptr=c;
+	}
+
+	return str;
+}
+
+inline char *itoa(int value,char *str,int radix) {
+	return ltoa(value,str,radix);
+}
+
+
+/**
+ * Minimal Stream interface. Host programs derive from this to feed data into the
+ * serial-based decoders.
+ */
+
+class Stream {
+
+	public:
+		virtual ~Stream() {}
+		virtual int available()=0;
+		virtual int read()=0;
+		virtual size_t write(uint8_t c)=0;
+};
+
+
+/*
+ * Far addresses are simply the address of the object on the host
+ */
+
+#define GET_FAR_ADDRESS(var) ((uint32_t)(uintptr_t)&(var))
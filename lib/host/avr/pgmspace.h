@@ -0,0 +1,44 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file host/avr/pgmspace.h
+ * @brief Minimal stand-in for avr-libc's program space utilities on a desktop host.
+ *
+ * There is no separate program address space on the host so the 'flash' readers simply
+ * dereference the address. See host/Arduino.h for the linkage requirement.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+
+#define pgm_read_byte_near(address) (*(const uint8_t *)(uintptr_t)(address))
+#define pgm_read_byte_far(address) pgm_read_byte_near(address)
+#define pgm_read_byte(address) pgm_read_byte_near(address)
+
+#define pgm_read_word_near(address) (*(const uint16_t *)(uintptr_t)(address))
+#define pgm_read_word(address) pgm_read_word_near(address)
+
+#define memcpy_P(dest,src,n) memcpy((dest),(src),(n))
@@ -47,6 +47,10 @@ namespace lcd {
 	 * The font must be fixed width or wierd stuff will happen. Each controller implementation contains appropriate
 	 * typedefs for terminal implementations in landscape and portrait.
 	 *
+	 * Characters passed to writeCharacter() are collected into a run and the run is written as one string when
+	 * a newline, carriage return or line wrap is reached, when the run buffer is full or when flush() is called.
+	 * The string and stream output methods flush when they are done so their output appears immediately.
+	 *
 	 * @tparam TImpl This a CRTP-style class. TImpl is the type of the derived class.
 	 * @tparam TGraphicsLibrary. The graphics library implementation.
 	 * @ingroup Terminal
@@ -55,6 +59,11 @@ namespace lcd {
 	template<class TImpl,class TGraphicsLibrary>
 	class TerminalBase {
 
+		public:
+			enum {
+				MAX_RUN_LENGTH = 32					///< the most characters that are buffered before they are written
+			};
+
 		protected:
 			TGraphicsLibrary *_gl;
 			const Font *_font;
@@ -63,10 +72,15 @@ namespace lcd {
 			Size _fontSize;
 			Point _cursor;
 
+			char _run[MAX_RUN_LENGTH+1];
+			uint8_t _runLength;
+
 		protected:
 			void calcTerminalSize();
 			void incrementY();
 
+			template<class TNumber> TerminalBase& writeNumber(const TNumber& val);
+
 		public:
 			TerminalBase(
 					TGraphicsLibrary *gl,
@@ -74,6 +88,7 @@ namespace lcd {
 
 			void writeCharacter(char c);
 			void writeString(const char *str);
+			void flush();
 
 			TerminalBase& operator<<(const char *str);
 			TerminalBase& operator<<(char c);
@@ -81,6 +96,10 @@ namespace lcd {
 			TerminalBase& operator<<(int32_t val);
 			TerminalBase& operator<<(const DoublePrecision& val);
 			TerminalBase& operator<<(double val);
+			TerminalBase& operator<<(const FixedPoint& val);
+			TerminalBase& operator<<(const ScaledInteger& val);
+			TerminalBase& operator<<(const UnsignedInteger& val);
+			TerminalBase& operator<<(const HexInteger& val);
 
 			void clearScreen();
 			void clearLine();
@@ -98,7 +117,8 @@ namespace lcd {
 			TGraphicsLibrary *gl,
 			const Font *font)
 		: _gl(gl),
-		  _font(font) {
+		  _font(font),
+		  _runLength(0) {
 
 		calcTerminalSize();
 	}
@@ -113,16 +133,17 @@ namespace lcd {
 
 	  FontChar fc;
 
-		// need to know the width of the characters. They're all the same so measure a space.
+		// need to know the width of the characters. They're all the same so measure a space. Each cell
+		// includes the character spacing so that a run of cells can be written as one string.
 
 	  _font->getCharacter(' ',fc);
 
 	  _fontSize.Height=_font->getHeight();
-	  _fontSize.Width=fc.PixelWidth;
+	  _fontSize.Width=fc.PixelWidth+_font->getCharacterSpacing();
 
 	  // height is rounded down if the fixed lines don't sum to a multiple of the font height
 
-		_terminalSize.Width=_gl->getWidth()/fc.PixelWidth;
+		_terminalSize.Width=_gl->getWidth()/_fontSize.Width;
 		_terminalSize.Height=(_gl->getHeight())/_font->getHeight();
 	}
 
@@ -136,6 +157,7 @@ namespace lcd {
 
 	  this->_cursor.X=0;
  	  this->_cursor.Y=0;
+ 	  _runLength=0;
 
 	  // allow the derivation to reset any parameters
 
@@ -170,6 +192,7 @@ namespace lcd {
 		_gl->clearRectangle(rc);
 
 		_cursor.X=0;
+		_runLength=0;
 	}
 
 
@@ -184,49 +207,66 @@ namespace lcd {
 		const char *ptr;
 
 		for(ptr=str;*ptr;writeCharacter(*ptr++));
+		flush();
 	}
 
 
 	/**
-	 * @brief Write a character to the display
+	 * @brief Write a character to the display. The character is buffered until the run is flushed.
 	 * @param c The character to write.
 	 */
 
 	template<class TImpl,class TGraphicsLibrary>
 	inline void TerminalBase<TImpl,TGraphicsLibrary>::writeCharacter(char c) {
 
-		char buffer[2];
-		Point p;
-
 		if(c == '\n') {
+			flush();
 			incrementY();
 			_cursor.X=0;
 		} else if(c=='\r') {
+			flush();
 			_cursor.X=0;
 		} else {
 
-			// scale up the x,y character co-ords to pixel co-ords
-
-			p.X=_cursor.X*_fontSize.Width;
-			p.Y=(_cursor.Y % _terminalSize.Height)*_fontSize.Height;
-
-			// create a string
-
-			buffer[0]=c;
-			buffer[1]='\0';
+			// add to the run. the cursor moves now, the pixels are written when the run is flushed
 
-			// move the cursor and write
-
-			_gl->writeString(p,*_font,buffer);
+			_run[_runLength++]=c;
 
 			if(++_cursor.X >= _terminalSize.Width) {
+				flush();
 				_cursor.X=0;
 				incrementY();
 			}
+			else if(_runLength==MAX_RUN_LENGTH)
+				flush();
 		}
 	}
 
 
+	/**
+	 * @brief Write any buffered characters to the display as one string.
+	 */
+
+	template<class TImpl,class TGraphicsLibrary>
+	inline void TerminalBase<TImpl,TGraphicsLibrary>::flush() {
+
+		Point p;
+
+		if(!_runLength)
+			return;
+
+		// the run ends at the cursor. scale up the x,y character co-ords to pixel co-ords.
+
+		p.X=(_cursor.X-_runLength)*_fontSize.Width;
+		p.Y=(_cursor.Y % _terminalSize.Height)*_fontSize.Height;
+
+		_run[_runLength]='\0';
+		_runLength=0;
+
+		_gl->writeString(p,*_font,_run);
+	}
+
+
 	/**
 	 * @brief Increment the row and scroll if we have hit the bottom.
 	 *
@@ -269,6 +309,7 @@ namespace lcd {
 	inline TerminalBase<TImpl,TGraphicsLibrary>& TerminalBase<TImpl,TGraphicsLibrary>::operator<<(char c) {
 
 		writeCharacter(c);
+		flush();
 		return *this;
 	}
 
@@ -339,5 +380,70 @@ namespace lcd {
 		writeString(buf);
 		return *this;
 	}
-}
 
+
+	/**
+	 * Output a Q16.16 fixed point number using integer arithmetic only.
+	 * @param val the value to write out.
+	 * @return a self reference to allow chaining of << operators.
+	 */
+
+	template<class TImpl,class TGraphicsLibrary>
+	inline TerminalBase<TImpl,TGraphicsLibrary>& TerminalBase<TImpl,TGraphicsLibrary>::operator<<(const FixedPoint& val) {
+		return writeNumber(val);
+	}
+
+
+	/**
+	 * Output an integer scaled by a power of ten, e.g. hundredths written as "23.45".
+	 * @param val the value to write out.
+	 * @return a self reference to allow chaining of << operators.
+	 */
+
+	template<class TImpl,class TGraphicsLibrary>
+	inline TerminalBase<TImpl,TGraphicsLibrary>& TerminalBase<TImpl,TGraphicsLibrary>::operator<<(const ScaledInteger& val) {
+		return writeNumber(val);
+	}
+
+
+	/**
+	 * Output an unsigned decimal integer, optionally padded with leading zeros.
+	 * @param val the value to write out.
+	 * @return a self reference to allow chaining of << operators.
+	 */
+
+	template<class TImpl,class TGraphicsLibrary>
+	inline TerminalBase<TImpl,TGraphicsLibrary>& TerminalBase<TImpl,TGraphicsLibrary>::operator<<(const UnsignedInteger& val) {
+		return writeNumber(val);
+	}
+
+
+	/**
+	 * Output an unsigned hexadecimal integer, optionally padded with leading zeros.
+	 * @param val the value to write out.
+	 * @return a self reference to allow chaining of << operators.
+	 */
+
+	template<class TImpl,class TGraphicsLibrary>
+	inline TerminalBase<TImpl,TGraphicsLibrary>& TerminalBase<TImpl,TGraphicsLibrary>::operator<<(const HexInteger& val) {
+		return writeNumber(val);
+	}
+
+
+	/**
+	 * Format a number with NumberFormat into a stack buffer and write it out.
+	 * @param val the value to write out.
+	 * @return a self reference to allow chaining of << operators.
+	 */
+
+	template<class TImpl,class TGraphicsLibrary>
+	template<class TNumber>
+	inline TerminalBase<TImpl,TGraphicsLibrary>& TerminalBase<TImpl,TGraphicsLibrary>::writeNumber(const TNumber& val) {
+
+		char buf[NumberFormat::MAX_LENGTH];
+
+		NumberFormat::format(val,buf);
+		writeString(buf);
+		return *this;
+	}
+}
@@ -0,0 +1,279 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+/**
+ * @file ClipTest.cpp
+ * @brief Check that nothing is drawn outside the clip rectangle and that the inside is unchanged
+ */
+
+#include <vector>
+#include "HostSimulation.h"
+#include "Font_apple.h"
+#include "HostTest.h"
+
+using namespace lcd;
+
+typedef ILI9325_Portrait_64K_Host TGraphicsLibrary;
+
+enum {
+	LINES,
+	RECTANGLES,
+	POLYGONS,
+	ELLIPSES,
+	POINTS,
+	COMPRESSED_BITMAP,
+	UNCOMPRESSED_BITMAP,
+	TEXT,
+	NUM_PRIMITIVES
+};
+
+enum {
+	BITMAP_WIDTH = 30,
+	BITMAP_HEIGHT = 20
+};
+
+
+/*
+ * A 16-bit test pattern and an LZG encoding of it with literals and near copies. Bytes that
+ * match a marker are escaped as the marker followed by zero.
+ */
+
+static std::vector<uint8_t> Pixels;
+static std::vector<uint8_t> Compressed;
+
+
+static void createBitmaps() {
+
+	static const uint8_t markers[]={ 0xfa,0xfb,0xfc,0xfd };
+	uint32_t i,size;
+	uint8_t b;
+
+	for(i=0;i<BITMAP_WIDTH*BITMAP_HEIGHT;i++) {
+
+		// runs of flat colour with a few changing pixels
+
+		b=i % 7<4 ? 0x1f : static_cast<uint8_t>(i);
+		Pixels.push_back(b);
+		Pixels.push_back(static_cast<uint8_t>(i >> 3));
+	}
+
+	Compressed.assign(16,0);
+	Compressed.insert(Compressed.end(),markers,markers+4);
+
+	for(i=0;i<Pixels.size();i++) {
+
+		// a near copy of 2 repeats the previous pixel, length code 2 is 4 bytes
+
+		if(i>=2 && i+4<=Pixels.size() && Pixels[i]==Pixels[i-2] && Pixels[i+1]==Pixels[i-1] &&
+				Pixels[i+2]==Pixels[i] && Pixels[i+3]==Pixels[i+1]) {
+			Compressed.push_back(0xfd);
+			Compressed.push_back(0x22);
+			i+=3;
+			continue;
+		}
+
+		Compressed.push_back(Pixels[i]);
+
+		if(Pixels[i]>=0xfa && Pixels[i]<=0xfd)
+			Compressed.push_back(0);
+	}
+
+	Compressed[0]='L';
+	Compressed[1]='Z';
+	Compressed[2]='G';
+	Compressed[6]=Pixels.size();
+	Compressed[5]=Pixels.size() >> 8;
+
+	size=Compressed.size()-16;
+	Compressed[10]=size;
+	Compressed[9]=size >> 8;
+	Compressed[15]=1;
+}
+
+
+/*
+ * Draw a set of primitives that cross every edge of the clip rectangles used below
+ */
+
+static void draw(TGraphicsLibrary& gl,uint8_t primitive) {
+
+	static const Point star[]={ Point(120,0),Point(160,319),Point(0,100),Point(239,120),Point(70,300) };
+
+	LzgDecoderContext<> context;
+	Font_APPLE8 font;
+	FontChar fc;
+	int16_t i;
+
+	gl.setForeground(ColourNames::RED);
+	gl.setBackground(0x404040);
+
+	switch(primitive) {
+
+		case LINES:
+			for(i=0;i<240;i+=20) {
+				gl.drawLine(Point(i,0),Point(239-i,319));
+				gl.drawLine(Point(0,i),Point(239,319-i));
+			}
+			gl.drawLine(Point(0,150),Point(239,150));
+			gl.drawLine(Point(100,0),Point(100,319));
+			break;
+
+		case RECTANGLES:
+			gl.drawRectangle(Rectangle(10,10,220,300));
+			gl.drawRectangle(Rectangle(50,90,100,40));
+			gl.fillRectangle(Rectangle(20,200,200,30));
+			gl.clearRectangle(Rectangle(90,20,30,290));
+			break;
+
+		case POLYGONS:
+			gl.fillPolygon(star,5);
+			gl.fillTriangle(Point(0,319),Point(239,250),Point(40,60));
+			break;
+
+		case ELLIPSES:
+			gl.fillEllipse(Point(120,160),Size(100,60));
+			gl.drawEllipse(Point(120,160),Size(110,150));
+			gl.drawCircle(Point(60,70),60);
+			break;
+
+		case POINTS:
+			for(i=0;i<320;i+=3)
+				gl.plotPoint(i*7 % 240,i);
+			break;
+
+		case COMPRESSED_BITMAP:
+			for(i=0;i<8;i++) {
+				SramByteSource source(&Compressed[0],Compressed.size());
+				gl.drawCompressedBitmap(Point(i*27,i*37),Size(BITMAP_WIDTH,BITMAP_HEIGHT),source,context);
+			}
+			break;
+
+		case UNCOMPRESSED_BITMAP:
+			for(i=0;i<8;i++) {
+				SramByteSource source(&Pixels[0],Pixels.size());
+				gl.drawUncompressedBitmap(Point(i*27+5,i*37+10),Size(BITMAP_WIDTH,BITMAP_HEIGHT),source);
+			}
+			break;
+
+		case TEXT:
+			for(i=0;i<320;i+=23) {
+				gl.writeString(Point(i % 100,i),font,"The quick brown fox jumps");
+				font.getCharacter('Q',fc);
+				gl.writeCharacter(Point(200,i),font,fc);
+			}
+			break;
+	}
+}
+
+
+/*
+ * Draw unclipped, then clipped, and check that inside the clip the pixels match and outside it
+ * the panel still has the colour it was cleared to.
+ */
+
+void testClip(const Rectangle& clip) {
+
+	static TGraphicsLibrary gl;
+	GramSnapshot<ILI9325HostAccessMode> reference;
+	uint8_t primitive;
+	int16_t x,y;
+	uint32_t pixel;
+	bool inside,ok;
+
+	for(primitive=0;primitive<NUM_PRIMITIVES;primitive++) {
+
+		gl.resetClip();
+		gl.setBackground(ColourNames::BLUE);
+		gl.clearScreen();
+		draw(gl,primitive);
+		reference.save(gl.getWidth(),gl.getHeight());
+
+		gl.setBackground(ColourNames::BLUE);
+		gl.clearScreen();
+		gl.setClip(clip);
+		draw(gl,primitive);
+
+		ok=true;
+
+		for(y=0;y<gl.getHeight();y++) {
+			for(x=0;x<gl.getWidth();x++) {
+
+				inside=x>=clip.X && x<clip.X+clip.Width && y>=clip.Y && y<clip.Y+clip.Height;
+				pixel=ILI9325HostAccessMode::getGramModel().getPixel(x,y);
+
+				ok&=pixel==(inside ? reference.getPixel(x,y) : 0x001fU);
+			}
+		}
+
+		if(!ok)
+			fprintf(stderr,"primitive %d, clip %d,%d %dx%d\n",primitive,clip.X,clip.Y,clip.Width,clip.Height);
+
+		CHECK(ok);
+	}
+}
+
+
+/*
+ * clearScreen() only clears inside the clip rectangle
+ */
+
+void testClearScreen() {
+
+	static TGraphicsLibrary gl;
+	const Rectangle clip(30,40,50,60);
+	int16_t x,y;
+	bool inside,ok;
+
+	gl.resetClip();
+	gl.setBackground(ColourNames::BLUE);
+	gl.clearScreen();
+
+	gl.setClip(clip);
+	gl.setBackground(ColourNames::RED);
+	gl.clearScreen();
+
+	ok=true;
+
+	for(y=0;y<gl.getHeight();y++) {
+		for(x=0;x<gl.getWidth();x++) {
+			inside=x>=clip.X && x<clip.X+clip.Width && y>=clip.Y && y<clip.Y+clip.Height;
+			ok&=ILI9325HostAccessMode::getGramModel().getPixel(x,y)==(inside ? 0xf800U : 0x001fU);
+		}
+	}
+
+	CHECK(ok);
+	gl.resetClip();
+}
+
+
+int main() {
+
+	createBitmaps();
+
+	testClip(Rectangle(37,53,101,117));
+	testClip(Rectangle(0,0,240,100));
+	testClip(Rectangle(200,250,40,70));
+	testClip(Rectangle(1,1,1,1));
+	testClearScreen();
+
+	return HostTest::getFailures();
+}
@@ -0,0 +1,201 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+/**
+ * @file DirtyRegionTest.cpp
+ * @brief Check that a dirty region covers everything marked and that flush() clips and restores
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include "HostSimulation.h"
+#include "HostTest.h"
+
+using namespace lcd;
+
+typedef ILI9325_Portrait_64K_Host TGraphicsLibrary;
+
+enum {
+	WIDTH = 240,
+	HEIGHT = 320
+};
+
+
+/*
+ * Rectangle::containsPoint() includes the right and bottom edges, this does not
+ */
+
+static bool isInside(const Rectangle& rc,int16_t x,int16_t y) {
+	return x>=rc.X && x<rc.X+rc.Width && y>=rc.Y && y<rc.Y+rc.Height;
+}
+
+
+/*
+ * Mark random rectangles and check that the region stays within its capacity and that every
+ * marked pixel is inside one of the region's rectangles, however they were merged.
+ */
+
+template<uint8_t TCapacity,uint16_t TWindowCost>
+void testCoverage(uint32_t seed) {
+
+	static bool marked[HEIGHT][WIDTH];
+	DirtyRegion<TCapacity,TWindowCost> region;
+	Rectangle rc;
+	int16_t x,y;
+	uint8_t i,j;
+	bool covered,ok;
+
+	memset(marked,0,sizeof(marked));
+	srand(seed);
+
+	for(i=0;i<20;i++) {
+
+		rc.X=rand() % WIDTH;
+		rc.Y=rand() % HEIGHT;
+		rc.Width=rand() % (WIDTH-rc.X+1);
+		rc.Height=rand() % (HEIGHT-rc.Y+1);
+
+		if(rand() % 2) {
+			rc.Width=rc.Width % 20;
+			rc.Height=rc.Height % 20;
+		}
+
+		region.markDirty(rc);
+
+		for(y=rc.Y;y<rc.Y+rc.Height;y++)
+			for(x=rc.X;x<rc.X+rc.Width;x++)
+				marked[y][x]=true;
+
+		CHECK(region.getCount()<=TCapacity);
+	}
+
+	ok=true;
+
+	for(y=0;y<HEIGHT;y++) {
+		for(x=0;x<WIDTH;x++) {
+
+			if(!marked[y][x])
+				continue;
+
+			covered=false;
+
+			for(j=0;j<region.getCount() && !covered;j++)
+				covered=isInside(region.getRectangle(j),x,y);
+
+			ok&=covered;
+		}
+	}
+
+	CHECK(ok);
+}
+
+
+/*
+ * flush() with a graphics library sets the clip to each rectangle in turn and then puts back
+ * the caller's clip. A callback that fills the whole panel can only touch the dirty rectangles.
+ */
+
+struct FlushContext {
+	TGraphicsLibrary *Gl;
+	uint8_t Calls;
+	bool ClipMatches;
+};
+
+
+static void redraw(const Rectangle& rc,void *context) {
+
+	FlushContext *fc;
+	const Rectangle& clip(static_cast<FlushContext *>(context)->Gl->getClip());
+
+	fc=static_cast<FlushContext *>(context);
+	fc->Calls++;
+	fc->ClipMatches&=clip.X==rc.X && clip.Y==rc.Y && clip.Width==rc.Width && clip.Height==rc.Height;
+
+	fc->Gl->fillRectangle(Rectangle(0,0,WIDTH,HEIGHT));
+}
+
+
+void testFlush() {
+
+	static TGraphicsLibrary gl;
+	DirtyRegion<4> region;
+	FlushContext context;
+	const Rectangle callerClip(5,6,200,300);
+	Rectangle rc;
+	int16_t x,y;
+	bool inside,ok;
+
+	gl.setBackground(ColourNames::BLACK);
+	gl.clearScreen();
+	gl.setForeground(ColourNames::RED);
+
+	// two far apart areas are not worth merging
+
+	region.markDirty(Rectangle(10,10,20,20));
+	region.markDirty(Rectangle(150,250,30,10));
+
+	CHECK(region.getCount()==2);
+
+	gl.setClip(callerClip);
+
+	context.Gl=&gl;
+	context.Calls=0;
+	context.ClipMatches=true;
+
+	region.flush(gl,redraw,&context);
+
+	CHECK(context.Calls==2);
+	CHECK(context.ClipMatches);
+	CHECK(region.isEmpty());
+
+	rc=gl.getClip();
+	CHECK(rc.X==callerClip.X && rc.Y==callerClip.Y && rc.Width==callerClip.Width && rc.Height==callerClip.Height);
+
+	ok=true;
+
+	for(y=0;y<HEIGHT;y++) {
+		for(x=0;x<WIDTH;x++) {
+
+			inside=isInside(Rectangle(10,10,20,20),x,y) || isInside(Rectangle(150,250,30,10),x,y);
+			ok&=ILI9325HostAccessMode::getGramModel().getPixel(x,y)==(inside ? 0xf800U : 0U);
+		}
+	}
+
+	CHECK(ok);
+}
+
+
+int main() {
+
+	uint32_t seed;
+
+	for(seed=1;seed<=50;seed++) {
+		testCoverage<3,32>(seed);
+		testCoverage<4,32>(seed);
+		testCoverage<8,0>(seed);
+		testCoverage<8,1000>(seed);
+	}
+
+	testFlush();
+
+	return HostTest::getFailures();
+}
@@ -0,0 +1,184 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+/**
+ * @file DrawListTest.cpp
+ * @brief Check that an optimised draw list leaves the same pixels as drawing immediately
+ */
+
+#include <cstdlib>
+#include "HostSimulation.h"
+#include "HostTest.h"
+
+using namespace lcd;
+
+typedef ILI9325_Portrait_64K_Host TGraphicsLibrary;
+typedef DrawList<TGraphicsLibrary,64> TDrawList;
+
+
+/*
+ * Send the same random operation to the graphics library or the draw list. The shapes are
+ * clustered in the middle of the panel in a few colours so that plenty of them overlap and
+ * the optimiser has to decide which ones it may reorder.
+ */
+
+template<class TTarget>
+void drawRandom(TTarget& target,uint32_t seed,uint8_t count) {
+
+	static const uint32_t colours[]={ ColourNames::RED,ColourNames::GREEN,ColourNames::BLUE };
+
+	uint8_t i;
+	int16_t x,y,w,h;
+
+	srand(seed);
+
+	for(i=0;i<count;i++) {
+
+		target.setForeground(colours[rand() % 3]);
+
+		x=40+rand() % 120;
+		y=60+rand() % 160;
+		w=1+rand() % 50;
+		h=1+rand() % 50;
+
+		switch(rand() % 9) {
+
+			case 0:
+				target.fillRectangle(Rectangle(x,y,w,h));
+				break;
+
+			case 1:
+				target.clearRectangle(Rectangle(x,y,w,h));
+				break;
+
+			case 2:
+				target.drawRectangle(Rectangle(x,y,w+1,h+1));
+				break;
+
+			case 3:
+				target.drawLine(Point(x,y),Point(x+w,y+h-25));
+				break;
+
+			case 4:
+				target.drawLine(Point(x,y),Point(x,y+h));
+				break;
+
+			case 5:
+				target.plotPoint(Point(x,y));
+				break;
+
+			case 6:
+				target.drawEllipse(Point(x,y),Size(w/2+1,h/2+1));
+				break;
+
+			case 7:
+				target.fillEllipse(Point(x,y),Size(w/2+1,h/2+1));
+				break;
+
+			default:
+				target.drawCircle(Point(x,y),w/2+1);
+				break;
+		}
+	}
+}
+
+
+/*
+ * Draw a random scene immediately, then record, optimise and replay it over a cleared panel
+ */
+
+void testRandomScene(uint32_t seed,uint8_t count) {
+
+	static TGraphicsLibrary gl;
+	GramSnapshot<ILI9325HostAccessMode> reference;
+	TDrawList list(&gl);
+
+	gl.setBackground(ColourNames::BLACK);
+	list.setBackground(ColourNames::BLACK);
+
+	gl.clearScreen();
+	drawRandom(gl,seed,count);
+	reference.save(gl.getWidth(),gl.getHeight());
+
+	gl.clearScreen();
+	drawRandom(list,seed,count);
+	list.flush();
+
+	CHECK(reference.countDifferences()==0);
+}
+
+
+/*
+ * Adjacent fills of the same colour are merged, a fill of another colour that overlaps them
+ * keeps its place above them and the list can be replayed more than once.
+ */
+
+void testMerge() {
+
+	static TGraphicsLibrary gl;
+	GramSnapshot<ILI9325HostAccessMode> reference;
+	TDrawList list(&gl);
+
+	gl.setBackground(ColourNames::BLACK);
+	gl.clearScreen();
+
+	list.setForeground(ColourNames::RED);
+	list.fillRectangle(Rectangle(10,10,20,10));
+	list.setForeground(ColourNames::BLUE);
+	list.fillRectangle(Rectangle(15,15,10,10));
+	list.setForeground(ColourNames::RED);
+	list.fillRectangle(Rectangle(10,20,20,10));
+	list.fillRectangle(Rectangle(100,10,20,10));
+	list.fillRectangle(Rectangle(100,20,20,10));
+
+	list.optimise();
+
+	// the two red fills on the right merge, the ones under the blue fill cannot move past it
+
+	CHECK(list.getCount()==4);
+
+	list.replay();
+
+	CHECK(ILI9325HostAccessMode::getGramModel().getPixel(20,17)==0x001f);
+	CHECK(ILI9325HostAccessMode::getGramModel().getPixel(20,22)==0xf800);
+	CHECK(ILI9325HostAccessMode::getGramModel().getPixel(12,12)==0xf800);
+
+	reference.save(gl.getWidth(),gl.getHeight());
+	list.replay();
+
+	CHECK(reference.countDifferences()==0);
+}
+
+
+int main() {
+
+	uint32_t seed;
+
+	testMerge();
+
+	// lists that fit and lists that flush automatically when they fill up
+
+	for(seed=1;seed<=100;seed++)
+		testRandomScene(seed,seed % 2 ? 40 : 150);
+
+	return HostTest::getFailures();
+}
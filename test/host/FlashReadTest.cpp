@@ -0,0 +1,204 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+/**
+ * @file FlashReadTest.cpp
+ * @brief Cycle counts for the old per-byte flash reader and FarFlashReader
+ *
+ * There is no AVR simulator in the host build so the cycles are counted, not measured. The bus
+ * writes are charged by ProfilingAccessMode from its cost tables and the flash reads and loop
+ * control are charged from the instruction counts below. Both readers are run against the GRAM
+ * model and must leave the same pixels behind. The results are printed so that they can be
+ * compared with the FlashReadBenchmark example on real hardware.
+ */
+
+#include <stdio.h>
+#include <vector>
+#include "HostSimulation.h"
+#include "drv/accessModes/ProfilingAccessMode.h"
+#include "HostTest.h"
+
+using namespace lcd;
+
+
+/*
+ * The same block as the FlashReadBenchmark example: 128x128 16-bit pixels starting 16Kb below
+ * the first 64Kb boundary, so both readers cross a segment.
+ */
+
+enum {
+	BLOCK_ADDRESS = 0xc000,
+	BLOCK_WIDTH = 128,
+	BLOCK_HEIGHT = 128,
+	BLOCK_BYTES = BLOCK_WIDTH*BLOCK_HEIGHT*2
+};
+
+
+/*
+ * Instruction counts for the flash reads and loop control, excluding the bus write itself
+ */
+
+enum {
+	OLD_NEAR_PIXEL = 26,		// movw, lpm, adiw, lpm + 32-bit add, 32-bit decrement, compare with 64K, test count, 2 branches
+	OLD_FAR_PIXEL = 27,			// out RAMPZ, movw, elpm, 32-bit add, out RAMPZ, movw, elpm + 32-bit add, 32-bit decrement, test count, branch
+	NEW_PIXEL = 0,					// the two 'elpm Z+' are in the FLASH_DATA_PER_VALUE cost
+	NEW_BATCH = 6,					// 16-bit compare, subtract and branch once per unrolled batch of 8
+	NEW_SEGMENT = 20				// beginSegment(): out RAMPZ, 32-bit subtract, two 32-bit compares
+};
+
+static std::vector<uint8_t> Flash;
+
+
+/*
+ * The reader that the drivers used before FarFlashReader, run against the profiled access mode.
+ * Flash addresses are translated to the host buffer. Returns the cycles spent reading.
+ */
+
+template<class TAccessMode>
+uint32_t oldFlashTransfer(uint32_t data,uint32_t numBytes) {
+
+	uint32_t numPixels,cycles;
+	const uint8_t *ptr;
+
+	numPixels=numBytes/2;
+	ptr=&Flash[0];
+	cycles=0;
+
+	while(data<65536 && numPixels>0) {
+		TAccessMode::writeData(ptr[0],ptr[1]);
+		cycles+=OLD_NEAR_PIXEL;
+		ptr+=2;
+		data+=2;
+		numPixels--;
+	}
+
+	while(numPixels>0) {
+		TAccessMode::writeData(ptr[0],ptr[1]);
+		cycles+=OLD_FAR_PIXEL;
+		ptr+=2;
+		data+=2;
+		numPixels--;
+	}
+
+	return cycles;
+}
+
+
+/*
+ * The loop control around the writeFlashDataBlock() transfers, following FarFlashReader's
+ * segment walk
+ */
+
+uint32_t newLoopCycles(uint32_t data,uint32_t numBytes) {
+
+	uint32_t count,cycles;
+
+	cycles=0;
+
+	while(numBytes) {
+
+		count=0x10000-(data & 0xffff);
+
+		if(count>0x8000)
+			count=0x8000;
+
+		if(count>numBytes)
+			count=numBytes;
+
+		data+=count;
+		numBytes-=count;
+
+		cycles+=NEW_SEGMENT+(count/16)*NEW_BATCH+(count/2)*NEW_PIXEL;
+	}
+
+	return cycles;
+}
+
+
+/*
+ * Draw the block with both readers through one access mode's cost table and print the cycles
+ */
+
+template<class TCostTable>
+void testFlashRead(const char *name) {
+
+	typedef ProfilingAccessMode<ILI9325HostAccessMode,TCostTable,ili9325::ILI932X_RW_GRAM> TProfiledMode;
+	typedef GraphicsLibrary<ILI9325<PORTRAIT,COLOURS_16BIT,TProfiledMode>,TProfiledMode> TGraphicsLibrary;
+
+	static TGraphicsLibrary gl;
+	GramSnapshot<ILI9325HostAccessMode> reference;
+	BusProfile oldProfile,newProfile;
+	uint32_t oldCycles,newCycles;
+	Bitmap bm;
+
+	bm.Dimensions.Width=BLOCK_WIDTH;
+	bm.Dimensions.Height=BLOCK_HEIGHT;
+	bm.Pixels=reinterpret_cast<uintptr_t>(&Flash[0]);
+	bm.DataSize=BLOCK_BYTES;
+
+	gl.setBackground(ColourNames::BLACK);
+	gl.clearScreen();
+
+	{
+		BusProfileScope<TProfiledMode> scope(oldProfile);
+
+		gl.moveTo(Rectangle(0,0,BLOCK_WIDTH,BLOCK_HEIGHT));
+		gl.beginWriting();
+		oldCycles=oldFlashTransfer<TProfiledMode>(BLOCK_ADDRESS,BLOCK_BYTES);
+	}
+
+	reference.save(gl.getWidth(),gl.getHeight());
+	gl.clearScreen();
+
+	{
+		BusProfileScope<TProfiledMode> scope(newProfile);
+		gl.drawUncompressedBitmap(Point(0,0),bm);
+	}
+
+	CHECK(reference.countDifferences()==0);
+
+	oldCycles+=oldProfile.getTotalCycles();
+	newCycles=newProfile.getTotalCycles()+newLoopCycles(BLOCK_ADDRESS,BLOCK_BYTES);
+
+	CHECK(newCycles<oldCycles);
+
+	printf("%-16s old %7u cycles %5.2f/pixel %6u us   new %7u cycles %5.2f/pixel %6u us\n",
+			name,
+			oldCycles,oldCycles/static_cast<double>(BLOCK_WIDTH*BLOCK_HEIGHT),oldCycles/16,
+			newCycles,newCycles/static_cast<double>(BLOCK_WIDTH*BLOCK_HEIGHT),newCycles/16);
+}
+
+
+int main() {
+
+	uint32_t i;
+
+	for(i=0;i<BLOCK_BYTES;i++)
+		Flash.push_back(i*37+(i >> 9));
+
+	printf("%dx%d pixels from flash at 0x%x, counted cycles at 16MHz:\n",BLOCK_WIDTH,BLOCK_HEIGHT,BLOCK_ADDRESS);
+
+	testFlashRead<Xmem16CostTable>("Xmem16");
+	testFlashRead<Gpio16LatchCostTable>("Gpio16Latch");
+
+	return HostTest::getFailures();
+}
@@ -0,0 +1,141 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+/**
+ * @file FontTest.cpp
+ * @brief Check the character lookup for fonts with and without an index table
+ */
+
+#include <string.h>
+#include "HostSimulation.h"
+#include "Font_apple.h"
+#include "HostTest.h"
+
+using namespace lcd;
+
+
+/*
+ * A font with gaps in its character codes, including codes at both ends of the code space
+ */
+
+static const uint8_t Pixels[]={ 0 };
+
+static const FontChar GappedChars[]={
+	{ 1,3,Pixels },
+	{ 2,4,Pixels },
+	{ 32,5,Pixels },
+	{ 65,6,Pixels },
+	{ 66,7,Pixels },
+	{ 200,8,Pixels },
+	{ 255,9,Pixels }
+};
+
+enum {
+	GAPPED_COUNT = sizeof(GappedChars)/sizeof(GappedChars[0])
+};
+
+
+/*
+ * Find a character by scanning the array
+ */
+
+int16_t findCharacter(const FontChar *chars,uint8_t count,uint8_t character) {
+
+	uint8_t i;
+
+	for(i=0;i<count;i++)
+		if(chars[i].Code==character)
+			return i;
+
+	return -1;
+}
+
+
+/*
+ * Every code resolves to the same position as a scan of the FontChar array
+ */
+
+void testIndexTable() {
+
+	uint8_t index[255];
+	uint8_t widths[GAPPED_COUNT];
+	uint16_t code;
+	uint8_t i;
+	bool ok;
+
+	memset(index,FontBase::NO_CHARACTER,sizeof(index));
+
+	for(i=0;i<GAPPED_COUNT;i++) {
+		index[GappedChars[i].Code-1]=i;
+		widths[i]=GappedChars[i].PixelWidth;
+	}
+
+	Font font(1,GAPPED_COUNT,8,0,GappedChars,index,sizeof(index),widths);
+
+	ok=true;
+
+	for(code=0;code<256;code++)
+		ok&=font.getCharacterIndex(code)==findCharacter(GappedChars,GAPPED_COUNT,code);
+
+	CHECK(ok);
+	CHECK(font.getCharacterWidth(200)==8);
+	CHECK(font.getCharacterWidth(255)==9);
+}
+
+
+/*
+ * Without an index table the codes are sequential from the first character
+ */
+
+void testSequential() {
+
+	static const FontChar chars[]={ { 48,5,Pixels },{ 49,6,Pixels },{ 50,7,Pixels } };
+
+	Font font(48,3,8,0,chars);
+	Font_APPLE8 apple;
+	uint16_t code;
+	bool ok;
+
+	ok=true;
+
+	for(code=0;code<256;code++)
+		ok&=font.getCharacterIndex(code)==(code>=48 && code<51 ? code-48 : -1);
+
+	CHECK(ok);
+	CHECK(font.getCharacterWidth('1')==6);
+
+	ok=true;
+
+	for(code=0;code<256;code++)
+		ok&=apple.getCharacterIndex(code)==(code>=32 && code<127 ? code-32 : -1);
+
+	CHECK(ok);
+}
+
+
+int main() {
+
+	testIndexTable();
+	testSequential();
+
+	return HostTest::getFailures();
+}
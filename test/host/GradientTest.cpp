@@ -0,0 +1,216 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+/**
+ * @file GradientTest.cpp
+ * @brief Check that gradients drawn from batches of runs match a per-pixel reference
+ */
+
+#include "HostSimulation.h"
+#include "HostTest.h"
+
+using namespace lcd;
+
+
+/*
+ * The colour of one pixel of a gradient ramp, calculated directly from the stops
+ */
+
+static uint32_t getRampColour(const GradientStop *stops,uint8_t count,uint16_t length,uint16_t index) {
+
+	uint16_t from,to;
+	uint32_t colour;
+	int32_t a,b;
+	uint8_t stop,shift;
+
+	for(stop=0;stop<count;stop++)
+		if(index<((uint32_t)stops[stop].Position*(length-1))/255)
+			break;
+
+	if(stop==0)
+		return stops[0].Colour;
+
+	if(stop==count)
+		return stops[count-1].Colour;
+
+	from=((uint32_t)stops[stop-1].Position*(length-1))/255;
+	to=((uint32_t)stops[stop].Position*(length-1))/255;
+
+	colour=0;
+
+	for(shift=0;shift<24;shift+=8) {
+
+		a=(stops[stop-1].Colour >> shift) & 0xff;
+		b=(stops[stop].Colour >> shift) & 0xff;
+
+		// floor division, the difference may be negative
+
+		a=a*(to-from)+(b-a)*(index-from);
+		colour|=(uint32_t)((a-(a<0 ? (to-from)-1 : 0))/(to-from)) << shift;
+	}
+
+	return colour;
+}
+
+
+/*
+ * Plot the reference gradient a pixel at a time, save it, then draw the real one over the top.
+ * The part of the screen outside the clip must be untouched in both.
+ */
+
+template<class TGraphicsLibrary,class TAccessMode>
+class GradientCheck {
+
+	public:
+		TGraphicsLibrary gl;
+		uint32_t *expected;
+
+		GradientCheck() {
+			expected=new uint32_t[(uint32_t)gl.getWidth()*gl.getHeight()];
+		}
+
+		~GradientCheck() {
+			delete [] expected;
+		}
+
+		void begin() {
+			gl.setBackground(ColourNames::BLACK);
+			gl.clearScreen();
+		}
+
+		void plot(int16_t x,int16_t y,uint32_t colour) {
+
+			const Rectangle& clip(gl.getClip());
+
+			if(x>=clip.X && x<clip.X+clip.Width && y>=clip.Y && y<clip.Y+clip.Height) {
+				gl.setForeground(colour);
+				gl.plotPoint(x,y);
+			}
+		}
+
+		void save() {
+
+			int16_t x,y;
+
+			for(y=0;y<gl.getHeight();y++)
+				for(x=0;x<gl.getWidth();x++)
+					expected[(uint32_t)y*gl.getWidth()+x]=TAccessMode::getGramModel().getPixel(x,y);
+
+			begin();
+		}
+
+		bool compare() {
+
+			int16_t x,y;
+			bool ok;
+
+			ok=true;
+
+			for(y=0;y<gl.getHeight();y++)
+				for(x=0;x<gl.getWidth();x++)
+					ok&=expected[(uint32_t)y*gl.getWidth()+x]==TAccessMode::getGramModel().getPixel(x,y);
+
+			return ok;
+		}
+};
+
+
+template<class TGraphicsLibrary,class TAccessMode>
+void testLinear(const Rectangle& rc,Direction dir,const GradientStop *stops,uint8_t count) {
+
+	static GradientCheck<TGraphicsLibrary,TAccessMode> check;
+	uint16_t length;
+	int16_t x,y;
+
+	length=dir==HORIZONTAL ? rc.Width : dir==VERTICAL ? rc.Height : rc.Width+rc.Height-1;
+
+	check.begin();
+
+	for(y=0;y<rc.Height;y++)
+		for(x=0;x<rc.Width;x++)
+			check.plot(rc.X+x,rc.Y+y,getRampColour(stops,count,length,dir==HORIZONTAL ? x : dir==VERTICAL ? y : x+y));
+
+	check.save();
+	check.gl.multiStopGradientFillRectangle(rc,dir,stops,count);
+
+	CHECK(check.compare());
+}
+
+
+template<class TGraphicsLibrary,class TAccessMode>
+void testRadial(const Rectangle& rc,const Point& center,int16_t radius,const GradientStop *stops,uint8_t count) {
+
+	static GradientCheck<TGraphicsLibrary,TAccessMode> check;
+	int32_t dx,dy,distance;
+	int16_t x,y;
+
+	check.begin();
+
+	for(y=rc.Y;y<rc.Y+rc.Height;y++) {
+		for(x=rc.X;x<rc.X+rc.Width;x++) {
+
+			dx=x-center.X;
+			dy=y-center.Y;
+
+			for(distance=0;(distance+1)*(distance+1)<=dx*dx+dy*dy;distance++);
+
+			check.plot(x,y,getRampColour(stops,count,radius+1,distance<radius ? distance : radius));
+		}
+	}
+
+	check.save();
+	check.gl.multiStopRadialGradientFillRectangle(rc,center,radius,stops,count);
+
+	CHECK(check.compare());
+}
+
+
+/*
+ * Long ramps on a 24-bit panel need many batches because nearly every pixel is a new run
+ */
+
+template<class TGraphicsLibrary,class TAccessMode>
+void testGradients() {
+
+	static const GradientStop two[]={ GradientStop(0,0xff8000),GradientStop(255,0x0040ff) };
+	static const GradientStop many[]={ GradientStop(30,0xffffff),GradientStop(90,0x000000),GradientStop(128,0xff00ff),GradientStop(128,0x00ffff),GradientStop(220,0x808000) };
+
+	testLinear<TGraphicsLibrary,TAccessMode>(Rectangle(0,0,240,320),HORIZONTAL,two,2);
+	testLinear<TGraphicsLibrary,TAccessMode>(Rectangle(0,0,240,320),VERTICAL,many,5);
+	testLinear<TGraphicsLibrary,TAccessMode>(Rectangle(0,0,240,320),DIAGONAL,two,2);
+	testLinear<TGraphicsLibrary,TAccessMode>(Rectangle(-50,-30,200,400),DIAGONAL,many,5);
+	testLinear<TGraphicsLibrary,TAccessMode>(Rectangle(100,250,300,200),HORIZONTAL,many,5);
+	testLinear<TGraphicsLibrary,TAccessMode>(Rectangle(3,7,2,300),DIAGONAL,many,5);
+
+	testRadial<TGraphicsLibrary,TAccessMode>(Rectangle(0,0,240,320),Point(120,160),100,many,5);
+	testRadial<TGraphicsLibrary,TAccessMode>(Rectangle(20,30,150,200),Point(-40,-40),600,two,2);
+	testRadial<TGraphicsLibrary,TAccessMode>(Rectangle(0,0,240,320),Point(300,100),1,two,2);
+}
+
+
+int main() {
+
+	testGradients<ILI9325_Portrait_64K_Host,ILI9325HostAccessMode>();
+	testGradients<Nokia6300_Portrait_16M_Host,MC2PA8201HostAccessMode>();
+
+	return HostTest::getFailures();
+}
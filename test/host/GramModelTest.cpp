@@ -0,0 +1,167 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file GramModelTest.cpp
+ * @brief Check the pixels that the drivers leave in the host GRAM models
+ */
+
+#include <vector>
+#include "HostSimulation.h"
+#include "HostTest.h"
+
+using namespace lcd;
+
+
+/*
+ * A filled rectangle lands in GRAM at the right place in portrait and landscape, and nothing
+ * outside it is touched.
+ */
+
+template<class TGraphicsLibrary>
+void testFillRectangle() {
+
+	static TGraphicsLibrary gl;
+	const ILI9325GramModel& gram=ILI9325HostAccessMode::getGramModel();
+	int16_t x,y;
+	bool inside,ok;
+
+	gl.setBackground(ColourNames::BLACK);
+	gl.clearScreen();
+	gl.setForeground(ColourNames::RED);
+	gl.fillRectangle(Rectangle(10,20,30,40));
+
+	ok=true;
+
+	for(y=0;y<gl.getHeight();y++) {
+		for(x=0;x<gl.getWidth();x++) {
+			inside=x>=10 && x<40 && y>=20 && y<60;
+			ok&=gram.getPixel(x,y)==(inside ? 0xf800U : 0U);
+		}
+	}
+
+	CHECK(ok);
+}
+
+
+/*
+ * Single points and the address counter. After plotting, the counter is left on the point
+ * because a one pixel window has been written once.
+ */
+
+void testPlotPoint() {
+
+	static ILI9325_Portrait_64K_Host gl;
+	const ILI9325GramModel& gram=ILI9325HostAccessMode::getGramModel();
+
+	gl.setBackground(ColourNames::BLACK);
+	gl.clearScreen();
+	gl.setForeground(ColourNames::BLUE);
+	gl.plotPoint(0,0);
+	gl.plotPoint(239,319);
+	gl.setForeground(0x00ff00);
+	gl.plotPoint(100,200);
+
+	CHECK(gram.getPixel(0,0)==0x001f);
+	CHECK(gram.getPixel(239,319)==0x001f);
+	CHECK(gram.getPixel(100,200)==0x07e0);
+	CHECK(gram.getPixel(101,200)==0);
+	CHECK(gram.getPixel(100,201)==0);
+}
+
+
+/*
+ * In 18-bit 3-transfer mode the driver writes each colour byte as its own transfer, but a stream
+ * of bytes goes out in (lo8,hi8) pairs as it does from the 16-bit access modes. The controller
+ * takes lo8 of each transfer.
+ */
+
+void testStreamedTripleTransfer() {
+
+	static ILI9325_Portrait_262K_Host gl;
+	const ILI9325GramModel& gram=ILI9325HostAccessMode::getGramModel();
+	static const uint8_t stream[]={ 0x10,0xaa,0x20,0xbb,0x30,0xcc,0x40,0xdd,0x50,0xee,0x60,0xff };
+	uint8_t i;
+
+	gl.setBackground(ColourNames::BLACK);
+	gl.clearScreen();
+	gl.setForeground(0xfc8004);
+	gl.plotPoint(5,5);
+
+	CHECK(gram.getPixel(5,5)==0xfc8004);
+
+	gl.moveTo(Rectangle(0,0,2,1));
+	gl.beginWriting();
+
+	for(i=0;i<sizeof(stream);i++)
+		ILI9325HostAccessMode::writeStreamedData(stream[i]);
+
+	CHECK(gram.getPixel(0,0)==0x102030);
+	CHECK(gram.getPixel(1,0)==0x405060);
+}
+
+
+/*
+ * A block of pixels that is too big for the 16-bit byte count of writeDataBlock() is split
+ * up and lands in GRAM the same as writing the pixels one at a time.
+ */
+
+template<class TGraphicsLibrary,class TAccessMode>
+void testLargePixelBlock() {
+
+	static TGraphicsLibrary gl;
+	GramSnapshot<TAccessMode> reference;
+	std::vector<typename TGraphicsLibrary::UnpackedColour> pixels(65535);
+	uint32_t i;
+
+	for(i=0;i<pixels.size();i++)
+		gl.unpackColour(i,i >> 8,i*7,pixels[i]);
+
+	gl.setBackground(ColourNames::BLACK);
+	gl.clearScreen();
+	gl.moveTo(Rectangle(0,0,gl.getWidth(),gl.getHeight()));
+	gl.beginWriting();
+
+	for(i=0;i<pixels.size();i++)
+		gl.writePixel(pixels[i]);
+
+	reference.save(gl.getWidth(),gl.getHeight());
+
+	gl.clearScreen();
+	gl.moveTo(Rectangle(0,0,gl.getWidth(),gl.getHeight()));
+	gl.beginWriting();
+	gl.writePixels(&pixels[0],pixels.size());
+
+	CHECK(reference.countDifferences()==0);
+}
+
+
+int main() {
+
+	testFillRectangle<ILI9325_Portrait_64K_Host>();
+	testFillRectangle<ILI9325_Landscape_64K_Host>();
+	testPlotPoint();
+	testStreamedTripleTransfer();
+	testLargePixelBlock<ILI9325_Portrait_64K_Host,ILI9325HostAccessMode>();
+	testLargePixelBlock<Nokia6300_Portrait_16M_Host,MC2PA8201HostAccessMode>();
+
+	return HostTest::getFailures();
+}
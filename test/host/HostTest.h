@@ -0,0 +1,147 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file HostTest.h
+ * @brief Minimal assertion and GRAM comparison support for the host unit tests
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+
+namespace lcd {
+
+	/**
+	 * @brief Counts and reports failed checks. A test program returns getFailures() from main().
+	 */
+
+	class HostTest {
+
+		protected:
+			static int _failures;
+
+		public:
+
+			/**
+			 * Record the result of a check and report it if it failed.
+			 * @param ok The result of the check.
+			 * @param expr The text of the checked expression.
+			 * @param file The source file.
+			 * @param line The source line.
+			 */
+
+			static void check(bool ok,const char *expr,const char *file,int line) {
+
+				if(!ok) {
+					fprintf(stderr,"%s:%d: check failed: %s\n",file,line,expr);
+					_failures++;
+				}
+			}
+
+			/**
+			 * Get the number of failed checks.
+			 * @return The count.
+			 */
+
+			static int getFailures() {
+
+				if(_failures==0)
+					printf("all checks passed\n");
+
+				return _failures;
+			}
+	};
+
+	int HostTest::_failures;
+
+
+	/**
+	 * @brief A copy of the panel as seen through a host access mode's GRAM model, for comparing the
+	 * output of two ways of drawing the same thing.
+	 * @tparam TAccessMode The host access mode, e.g. ILI9325HostAccessMode.
+	 */
+
+	template<class TAccessMode>
+	class GramSnapshot {
+
+		protected:
+			std::vector<uint32_t> _pixels;
+			int16_t _width;
+			int16_t _height;
+
+		public:
+
+			/**
+			 * Copy the panel.
+			 * @param width The panel width in the current orientation.
+			 * @param height The panel height in the current orientation.
+			 */
+
+			void save(int16_t width,int16_t height) {
+
+				int16_t x,y;
+
+				_width=width;
+				_height=height;
+				_pixels.resize(static_cast<uint32_t>(width)*height);
+
+				for(y=0;y<height;y++)
+					for(x=0;x<width;x++)
+						_pixels[static_cast<uint32_t>(y)*width+x]=TAccessMode::getGramModel().getPixel(x,y);
+			}
+
+			/**
+			 * Get a saved pixel.
+			 * @param x The x co-ordinate.
+			 * @param y The y co-ordinate.
+			 * @return The pixel.
+			 */
+
+			uint32_t getPixel(int16_t x,int16_t y) const {
+				return _pixels[static_cast<uint32_t>(y)*_width+x];
+			}
+
+			/**
+			 * Compare the panel with the saved copy.
+			 * @return The number of pixels that differ.
+			 */
+
+			uint32_t countDifferences() const {
+
+				int16_t x,y;
+				uint32_t count;
+
+				count=0;
+
+				for(y=0;y<_height;y++)
+					for(x=0;x<_width;x++)
+						if(getPixel(x,y)!=TAccessMode::getGramModel().getPixel(x,y))
+							count++;
+
+				return count;
+			}
+	};
+}
+
+#define CHECK(expr) lcd::HostTest::check((expr),#expr,__FILE__,__LINE__)
@@ -0,0 +1,127 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/**
+ * @file LzgPixelRunTest.cpp
+ * @brief Check that LZG pixel runs put the same data on the bus as streaming the decoded bytes
+ */
+
+#include "HostSimulation.h"
+#include "HostTest.h"
+
+using namespace lcd;
+
+
+/*
+ * 8 pixels of 3 bytes. Two runs are encoded as near copies with an offset of one pixel:
+ * 9 bytes that repeat 10 20 30 and 6 bytes that repeat 40 50 60.
+ */
+
+static const uint8_t Asset24[]={
+	'L','Z','G',0,0,0,24,0,0,0,17,0,0,0,0,1,		// header: decoded size 24, encoded size 17
+	0xfa,0xfb,0xfc,0xfd,													// markers
+	0x10,0x20,0x30,0xfd,0x47,											// literal pixel, copy 9 from 3 back
+	0x40,0x50,0x60,0xfd,0x44,											// literal pixel, copy 6 from 3 back
+	0x70,0x80,0x90,
+	0,0,0,3																				// window size trailer
+};
+
+static const uint8_t Decoded24[]={
+	0x10,0x20,0x30,0x10,0x20,0x30,0x10,0x20,0x30,0x10,0x20,0x30,
+	0x40,0x50,0x60,0x40,0x50,0x60,0x40,0x50,0x60,0x70,0x80,0x90
+};
+
+
+/*
+ * 9 pixels of 2 bytes with runs encoded as near copies with an offset of one pixel
+ */
+
+static const uint8_t Asset16[]={
+	'L','Z','G',0,0,0,18,0,0,0,12,0,0,0,0,1,		// header: decoded size 18, encoded size 12
+	0xfa,0xfb,0xfc,0xfd,													// markers
+	0x12,0x34,0xfd,0x26,													// literal pixel, copy 8 from 2 back
+	0x56,0x78,0xfd,0x24,													// literal pixel, copy 6 from 2 back
+	0,0,0,2																				// window size trailer
+};
+
+static const uint8_t Decoded16[]={
+	0x12,0x34,0x12,0x34,0x12,0x34,0x12,0x34,0x12,0x34,
+	0x56,0x78,0x56,0x78,0x56,0x78,0x56,0x78
+};
+
+
+/*
+ * Decode the asset to the top left of the screen, then stream the decoded bytes to the line
+ * below, which is what the decoder did before runs were sent as bursts. The two lines must match.
+ */
+
+template<class TGraphicsLibrary,class TAccessMode>
+void testDecode(const uint8_t *asset,uint32_t assetSize,const uint8_t *decoded,uint32_t decodedSize,int16_t width) {
+
+	static TGraphicsLibrary gl;
+	LzgDecoderContext<> context;
+	SramByteSource source(asset,assetSize);
+	uint32_t i;
+	int16_t x;
+	bool ok;
+
+	gl.setBackground(ColourNames::BLACK);
+	gl.clearScreen();
+
+	gl.drawCompressedBitmap(Point(0,0),Size(width,1),source,context);
+
+	gl.moveTo(Rectangle(0,1,width,1));
+	gl.beginWriting();
+
+	for(i=0;i<decodedSize;i++)
+		TAccessMode::writeStreamedData(decoded[i]);
+
+	ok=true;
+
+	for(x=0;x<width;x++) {
+		ok&=TAccessMode::getGramModel().getPixel(x,0)==TAccessMode::getGramModel().getPixel(x,1);
+		ok&=TAccessMode::getGramModel().getPixel(x,0)!=0;
+	}
+
+	CHECK(ok);
+}
+
+
+int main() {
+
+	// bursts are only used where a pixel boundary is a streamed transfer boundary
+
+	CHECK((LzgStreamPixelSize<ILI9325HostAccessMode,2>::VALUE==2));
+	CHECK((LzgStreamPixelSize<ILI9325HostAccessMode,3>::VALUE==1));
+	CHECK((LzgStreamPixelSize<MC2PA8201HostAccessMode,2>::VALUE==2));
+	CHECK((LzgStreamPixelSize<MC2PA8201HostAccessMode,3>::VALUE==3));
+
+	// 18-bit ILI9325 on a 16-bit bus: 3 byte pixels, streamed in pairs
+
+	testDecode<ILI9325_Portrait_262K_Host,ILI9325HostAccessMode>(Asset24,sizeof(Asset24),Decoded24,sizeof(Decoded24),4);
+
+	// 16-bit ILI9325 and 18-bit MC2PA8201, where runs are sent as bursts
+
+	testDecode<ILI9325_Portrait_64K_Host,ILI9325HostAccessMode>(Asset16,sizeof(Asset16),Decoded16,sizeof(Decoded16),9);
+	testDecode<Nokia6300_Portrait_262K_Host,MC2PA8201HostAccessMode>(Asset24,sizeof(Asset24),Decoded24,sizeof(Decoded24),8);
+
+	return HostTest::getFailures();
+}
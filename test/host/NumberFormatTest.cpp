@@ -0,0 +1,175 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+/**
+ * @file NumberFormatTest.cpp
+ * @brief Check the integer-only number formatting against snprintf
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "HostSimulation.h"
+#include "HostTest.h"
+
+using namespace lcd;
+
+enum {
+	RANDOM_VALUES = 200000
+};
+
+static const int32_t SpecialValues[]={
+	0,1,-1,5,-5,32768,-32768,65535,-65535,65536,-65536,0x18000,-0x18000,0x7fff8000,0x7fffffff,(int32_t)0x80000000
+};
+
+
+/*
+ * Compare a formatted string with the expected text. The returned end pointer must be the terminator.
+ */
+
+static bool isFormatted(const char *buffer,const char *end,const char *expected) {
+
+	if(strcmp(buffer,expected)==0 && end==buffer+strlen(buffer))
+		return true;
+
+	printf("got \"%s\", expected \"%s\"\n",buffer,expected);
+	return false;
+}
+
+
+/*
+ * Format a magnitude with a number of decimal places, as the reference for the decimal formats
+ */
+
+static void formatDecimal(char *buffer,size_t size,bool negative,long long magnitude,long long divisor,int places) {
+
+	if(places)
+		snprintf(buffer,size,"%s%lld.%0*lld",negative ? "-" : "",magnitude/divisor,places,magnitude % divisor);
+	else
+		snprintf(buffer,size,"%s%lld",negative ? "-" : "",magnitude);
+}
+
+
+/*
+ * Q16.16 values are rounded half up on the magnitude and a value that rounds to zero has no sign
+ */
+
+static bool testFixedPoint(int32_t value) {
+
+	char buffer[NumberFormat::MAX_LENGTH],expected[32];
+	long long magnitude,divisor,scaled;
+	int precision;
+	bool ok;
+
+	ok=true;
+	magnitude=value<0 ? -(long long)value : value;
+
+	for(precision=0,divisor=1;precision<=5;precision++,divisor*=10) {
+
+		scaled=(magnitude*divisor+32768) >> 16;
+		formatDecimal(expected,sizeof(expected),value<0 && scaled!=0,scaled,divisor,precision);
+
+		ok&=isFormatted(buffer,NumberFormat::format(FixedPoint(value,precision),buffer),expected);
+	}
+
+	return ok;
+}
+
+
+/*
+ * Scaled integers are exact
+ */
+
+static bool testScaledInteger(int32_t value) {
+
+	char buffer[NumberFormat::MAX_LENGTH],expected[32];
+	long long magnitude,divisor;
+	int places;
+	bool ok;
+
+	ok=true;
+	magnitude=value<0 ? -(long long)value : value;
+
+	for(places=0,divisor=1;places<=9;places++,divisor*=10) {
+
+		formatDecimal(expected,sizeof(expected),value<0,magnitude,divisor,places);
+		ok&=isFormatted(buffer,NumberFormat::format(ScaledInteger(value,places),buffer),expected);
+	}
+
+	return ok;
+}
+
+
+/*
+ * Unsigned and hex integers are zero padded to the requested width, which is capped at the maximum number of digits
+ */
+
+static bool testUnsignedAndHex(int32_t value) {
+
+	char buffer[NumberFormat::MAX_LENGTH],expected[32];
+	int width;
+	bool ok;
+
+	ok=true;
+
+	for(width=0;width<=12;width++) {
+
+		snprintf(expected,sizeof(expected),"%0*u",width>10 ? 10 : width,(unsigned)value);
+		ok&=isFormatted(buffer,NumberFormat::format(UnsignedInteger(value,width),buffer),expected);
+
+		snprintf(expected,sizeof(expected),"%0*X",width>8 ? 8 : width,(unsigned)value);
+		ok&=isFormatted(buffer,NumberFormat::format(HexInteger(value,width),buffer),expected);
+	}
+
+	return ok;
+}
+
+
+static bool testValue(int32_t value) {
+	return testFixedPoint(value) & testScaledInteger(value) & testUnsignedAndHex(value);
+}
+
+
+int main() {
+
+	uint32_t i,failures;
+	int32_t value;
+
+	failures=0;
+
+	for(i=0;i<sizeof(SpecialValues)/sizeof(SpecialValues[0]);i++)
+		if(!testValue(SpecialValues[i]))
+			failures++;
+
+	srand(1);
+
+	for(i=0;i<RANDOM_VALUES && failures<10;i++) {
+
+		value=static_cast<int32_t>((static_cast<uint32_t>(rand()) << 16) ^ rand() ^ (static_cast<uint32_t>(rand()) << 31));
+
+		if(!testValue(value))
+			failures++;
+	}
+
+	CHECK(failures==0);
+
+	return HostTest::getFailures();
+}
@@ -0,0 +1,204 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+/**
+ * @file NumericFieldTest.cpp
+ * @brief Check that incremental NumericField updates match a full repaint and stay inside the field
+ */
+
+#include <stdlib.h>
+#include "HostSimulation.h"
+#include "drv/accessModes/ProfilingAccessMode.h"
+#include "Font_apple.h"
+#include "Font_tama_ss01.h"
+#include "HostTest.h"
+
+using namespace lcd;
+
+typedef ProfilingAccessMode<ILI9325HostAccessMode,Gpio16LatchCostTable,ili9325::ILI932X_RW_GRAM> ProfiledMode;
+typedef GraphicsLibrary<ILI9325<PORTRAIT,COLOURS_16BIT,ProfiledMode>,ProfiledMode> TGraphicsLibrary;
+
+enum {
+	FOREGROUND = 0xffffff,
+	BACKGROUND = 0x000040,
+	SURROUND = 0xff0000
+};
+
+static const Rectangle Field(40,50,80,20);
+
+
+/*
+ * Check that nothing outside a rectangle differs from the snapshot
+ */
+
+bool isUnchangedOutside(const GramSnapshot<ILI9325HostAccessMode>& snapshot,const Rectangle& rc,int16_t width,int16_t height) {
+
+	int16_t x,y;
+	bool inside;
+
+	for(y=0;y<height;y++) {
+		for(x=0;x<width;x++) {
+
+			inside=x>=rc.X && x<rc.X+rc.Width && y>=rc.Y && y<rc.Y+rc.Height;
+
+			if(!inside && snapshot.getPixel(x,y)!=ILI9325HostAccessMode::getGramModel().getPixel(x,y))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+
+/*
+ * After each incremental update the field must look the same as a full repaint of the same text,
+ * and nothing outside the field may change. The values change width, sign and alignment within
+ * the field and some are too wide to fit.
+ */
+
+void testIncremental(TGraphicsLibrary& gl,const Font& font,TextAlignment alignment) {
+
+	NumericField<TGraphicsLibrary,Font> field(&gl,font,Point(Field.X,Field.Y),Field.Width,alignment);
+	GramSnapshot<ILI9325HostAccessMode> surround,incremental;
+	int32_t value;
+	uint16_t i;
+	bool ok;
+
+	gl.setBackground(SURROUND);
+	gl.clearScreen();
+	gl.setForeground(FOREGROUND);
+	gl.setBackground(BACKGROUND);
+
+	surround.save(gl.getWidth(),gl.getHeight());
+	srand(1);
+	ok=true;
+
+	for(i=0;i<400;i++) {
+
+		if(i<100)
+			value=9950+i;
+		else if(i<200)
+			value=rand() % 2000-1000;
+		else
+			value=static_cast<int32_t>(rand())*(rand() % 5+1)-rand();
+
+		field.setValue(value);
+		incremental.save(gl.getWidth(),gl.getHeight());
+
+		field.invalidate();
+		field.setValue(value);
+
+		ok&=incremental.countDifferences()==0;
+		ok&=isUnchangedOutside(surround,Field,gl.getWidth(),gl.getHeight());
+	}
+
+	CHECK(ok);
+}
+
+
+/*
+ * The caller's clip rectangle is restored after an update and still limits the drawing
+ */
+
+void testClip(TGraphicsLibrary& gl,const Font& font) {
+
+	NumericField<TGraphicsLibrary,Font> field(&gl,font,Point(Field.X,Field.Y),Field.Width);
+	GramSnapshot<ILI9325HostAccessMode> surround;
+	const Rectangle callerClip(0,0,Field.X+Field.Width/2,gl.getHeight());
+	Rectangle clip;
+
+	gl.resetClip();
+	gl.setBackground(SURROUND);
+	gl.clearScreen();
+	gl.setForeground(FOREGROUND);
+	gl.setBackground(BACKGROUND);
+
+	surround.save(gl.getWidth(),gl.getHeight());
+
+	gl.setClip(callerClip);
+	field.setValue(-123456789);
+
+	clip=gl.getClip();
+
+	CHECK(clip.X==callerClip.X && clip.Y==callerClip.Y && clip.Width==callerClip.Width && clip.Height==callerClip.Height);
+	CHECK(isUnchangedOutside(surround,Rectangle(Field.X,Field.Y,Field.Width/2,Field.Height),gl.getWidth(),gl.getHeight()));
+
+	gl.resetClip();
+}
+
+
+/*
+ * Counting up repaints far less than redrawing the whole field each time
+ */
+
+void testCycles(TGraphicsLibrary& gl,const Font& font) {
+
+	NumericField<TGraphicsLibrary,Font> field(&gl,font,Point(10,10),80);
+	BusProfile incremental,full;
+	int32_t value;
+
+	gl.setForeground(FOREGROUND);
+	gl.setBackground(BACKGROUND);
+	gl.clearScreen();
+	field.setValue(9999);
+
+	{
+		BusProfileScope<ProfiledMode> scope(incremental);
+
+		for(value=10000;value<10200;value++)
+			field.setValue(value);
+	}
+
+	{
+		BusProfileScope<ProfiledMode> scope(full);
+
+		for(value=10000;value<10200;value++) {
+			field.invalidate();
+			field.setValue(value);
+		}
+	}
+
+	printf("incremental: %u cycles, full repaint: %u cycles\n",incremental.getTotalCycles(),full.getTotalCycles());
+
+	CHECK(incremental.getTotalCycles()*100<full.getTotalCycles()*25);
+}
+
+
+int main() {
+
+	static TGraphicsLibrary gl;
+	Font_APPLE8 apple;
+	Font_TAMA_SS0117 tama;
+
+	testIncremental(gl,apple,TEXT_ALIGN_RIGHT);
+	testIncremental(gl,apple,TEXT_ALIGN_LEFT);
+	testIncremental(gl,tama,TEXT_ALIGN_RIGHT);
+	testIncremental(gl,tama,TEXT_ALIGN_CENTRE);
+	testIncremental(gl,tama,TEXT_ALIGN_LEFT);
+
+	testClip(gl,apple);
+	testClip(gl,tama);
+
+	testCycles(gl,apple);
+
+	return HostTest::getFailures();
+}
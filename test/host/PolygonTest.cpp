@@ -0,0 +1,160 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+/**
+ * @file PolygonTest.cpp
+ * @brief Check the polygon rasterizer against a per-pixel even-odd reference
+ */
+
+#include <cstdlib>
+#include "HostSimulation.h"
+#include "HostTest.h"
+
+using namespace lcd;
+
+
+/*
+ * A pixel is filled if its top-left corner is inside the polygon by the even-odd rule. An edge
+ * crosses row y if y is in [top,bottom) and the corner is counted as right of the edge if it lies on
+ * or to the right of the intercept.
+ */
+
+static bool isInside(const Point *points,uint8_t count,int16_t x,int16_t y) {
+
+	const Point *p1,*p2;
+	bool inside;
+	uint8_t i;
+	int32_t lhs,rhs;
+
+	inside=false;
+
+	for(i=0;i<count;i++) {
+
+		p1=&points[i];
+		p2=&points[i==count-1 ? 0 : i+1];
+
+		if(p1->Y>p2->Y) {
+			const Point *t=p1;
+			p1=p2;
+			p2=t;
+		}
+
+		if(y<p1->Y || y>=p2->Y)
+			continue;
+
+		// x >= p1.X + (y-p1.Y)*(p2.X-p1.X)/(p2.Y-p1.Y) without the division
+
+		lhs=static_cast<int32_t>(x-p1->X)*(p2->Y-p1->Y);
+		rhs=static_cast<int32_t>(y-p1->Y)*(p2->X-p1->X);
+
+		if(lhs>=rhs)
+			inside=!inside;
+	}
+
+	return inside;
+}
+
+
+/*
+ * Plot the reference pixel by pixel, save it, then fill the polygon and compare
+ */
+
+template<class TEdgeTable>
+void testPolygon(const Point *points,uint8_t count,TEdgeTable& table) {
+
+	static ILI9325_Portrait_64K_Host gl;
+	GramSnapshot<ILI9325HostAccessMode> reference;
+	int16_t x,y;
+
+	gl.setBackground(ColourNames::BLACK);
+	gl.clearScreen();
+	gl.setForeground(ColourNames::RED);
+
+	for(y=0;y<gl.getHeight();y++)
+		for(x=0;x<gl.getWidth();x++)
+			if(isInside(points,count,x,y))
+				gl.plotPoint(x,y);
+
+	reference.save(gl.getWidth(),gl.getHeight());
+	gl.clearScreen();
+
+	if(count==3)
+		gl.fillTriangle(points[0],points[1],points[2]);
+	else
+		gl.fillPolygon(points,count,table);
+
+	CHECK(reference.countDifferences()==0);
+}
+
+
+int main() {
+
+	static const Point square[]={ Point(10,20),Point(50,20),Point(50,60),Point(10,60) };
+	static const Point star[]={ Point(120,10),Point(150,300),Point(10,100),Point(230,100),Point(90,300) };
+
+	PolygonEdgeTable<40> table;
+	Point points[40];
+	uint8_t count,i;
+	uint16_t attempt;
+
+	// a polygon with the corners of a rectangle fills the same pixels as fillRectangle()
+
+	testPolygon(square,4,table);
+
+	// self-intersecting, filled with the even-odd rule
+
+	testPolygon(star,5,table);
+
+	// random polygons, some partly off the panel
+
+	srand(1);
+
+	for(attempt=0;attempt<200;attempt++) {
+
+		count=3+attempt % 38;
+
+		for(i=0;i<count;i++)
+			points[i]=Point(rand() % 300-30,rand() % 380-30);
+
+		testPolygon(points,count,table);
+	}
+
+	// the default table holds 16 vertices and nothing is drawn for more
+
+	{
+		static ILI9325_Portrait_64K_Host gl;
+		GramSnapshot<ILI9325HostAccessMode> blank;
+
+		gl.setBackground(ColourNames::BLACK);
+		gl.clearScreen();
+		blank.save(gl.getWidth(),gl.getHeight());
+
+		gl.setForeground(ColourNames::RED);
+		gl.fillPolygon(points,17);
+		CHECK(blank.countDifferences()==0);
+
+		gl.fillPolygon(points,16);
+		CHECK(blank.countDifferences()!=0);
+	}
+
+	return HostTest::getFailures();
+}
@@ -0,0 +1,132 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+/**
+ * @file TerminalTest.cpp
+ * @brief Check that batched terminal output matches output written a character at a time
+ */
+
+#include <stdio.h>
+#include "HostSimulation.h"
+#include "drv/accessModes/ProfilingAccessMode.h"
+#include "Font_apple.h"
+#include "HostTest.h"
+
+using namespace lcd;
+
+typedef ProfilingAccessMode<ILI9325HostAccessMode,Gpio16LatchCostTable,ili9325::ILI932X_RW_GRAM> ProfiledMode;
+typedef GraphicsLibrary<ILI9325<PORTRAIT,COLOURS_16BIT,ProfiledMode>,ProfiledMode> TPortraitGraphicsLibrary;
+typedef GraphicsLibrary<ILI9325<LANDSCAPE,COLOURS_16BIT,ProfiledMode>,ProfiledMode> TLandscapeGraphicsLibrary;
+
+enum {
+	LINES = 60,
+	FOREGROUND = 0xffffff,
+	BACKGROUND = 0x000000
+};
+
+
+/*
+ * Write a log of about 80 character lines that wrap, with carriage returns that overwrite the start of a line.
+ * The batched log uses the string, number and character output methods, each of which flushes when it is done.
+ * The per-character log flushes every character on its own, which is how the terminal wrote before it collected
+ * characters into runs.
+ */
+
+template<class TTerminal>
+void writeLog(TTerminal& terminal,bool perCharacter) {
+
+	char line[100];
+	const char *ptr;
+	int32_t i;
+
+	for(i=0;i<LINES;i++) {
+
+		if(perCharacter) {
+
+			snprintf(line,sizeof(line),"log line %d: the quick brown fox jumps over the lazy dog and keeps going\nabc\rXYz\n",static_cast<int>(i));
+
+			for(ptr=line;*ptr;ptr++) {
+				terminal.writeCharacter(*ptr);
+				terminal.flush();
+			}
+		}
+		else {
+			terminal << "log line " << i << ": the quick brown fox jumps over the lazy dog and keeps going\n";
+			terminal.writeString("abc\rXY");
+			terminal << 'z' << '\n';
+		}
+	}
+}
+
+
+/*
+ * Write the log both ways. The GRAM must be identical and the batched run must send far fewer commands.
+ */
+
+template<class TGraphicsLibrary,class TTerminal>
+void testTerminal(TGraphicsLibrary& gl,const Font& font,uint32_t maxCommandsPercent) {
+
+	GramSnapshot<ILI9325HostAccessMode> reference;
+	BusProfile perCharacter,batched;
+
+	gl.initialise();
+	gl.setForeground(FOREGROUND);
+	gl.setBackground(BACKGROUND);
+
+	TTerminal terminal(&gl,&font);
+
+	terminal.clearScreen();
+
+	{
+		BusProfileScope<ProfiledMode> scope(perCharacter);
+		writeLog(terminal,true);
+	}
+
+	reference.save(gl.getWidth(),gl.getHeight());
+	terminal.clearScreen();
+
+	{
+		BusProfileScope<ProfiledMode> scope(batched);
+		writeLog(terminal,false);
+	}
+
+	printf("per character: %u commands %u cycles, batched: %u commands %u cycles\n",
+			perCharacter.Commands,perCharacter.getTotalCycles(),
+			batched.Commands,batched.getTotalCycles());
+
+	CHECK(reference.countDifferences()==0);
+	CHECK(batched.Commands*100<perCharacter.Commands*maxCommandsPercent);
+	CHECK(batched.getTotalCycles()<perCharacter.getTotalCycles());
+}
+
+
+int main() {
+
+	static TPortraitGraphicsLibrary portrait;
+	static TLandscapeGraphicsLibrary landscape;
+	Font_APPLE8 font;
+
+	testTerminal<TLandscapeGraphicsLibrary,TerminalLandscapeImpl<TLandscapeGraphicsLibrary> >(landscape,font,15);
+	testTerminal<TPortraitGraphicsLibrary,TerminalPortraitImpl<TPortraitGraphicsLibrary> >(portrait,font,40);
+
+	return HostTest::getFailures();
+}
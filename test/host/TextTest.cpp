@@ -0,0 +1,170 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+/**
+ * @file TextTest.cpp
+ * @brief Check batched bitmap text against a character at a time renderer
+ */
+
+#include "HostSimulation.h"
+#include "drv/accessModes/ProfilingAccessMode.h"
+#include "Font_apple.h"
+#include "Font_tama_ss01.h"
+#include "HostTest.h"
+
+using namespace lcd;
+
+typedef ProfilingAccessMode<ILI9325HostAccessMode,Gpio16LatchCostTable,ili9325::ILI932X_RW_GRAM> ProfiledMode;
+
+enum {
+	LINES = 20,
+	LINE_LENGTH = 26,
+	FOREGROUND = 0xffff00,
+	BACKGROUND = 0x000080
+};
+
+
+/*
+ * Write a string one character at a time with a window and a full pixel write for every pixel,
+ * the way writeString() did before it batched characters and colour runs. The spacing columns
+ * are cleared to the background. There is no clipping so the string must fit on the panel.
+ */
+
+template<class TGraphicsLibrary>
+void writeStringByCharacter(TGraphicsLibrary& gl,const Point& p,const Font& font,const char *str) {
+
+	typename TGraphicsLibrary::UnpackedColour foreground,background;
+	uint16_t index;
+	uint8_t x,y;
+	Point pos(p);
+	FontChar fc;
+
+	gl.unpackColour(FOREGROUND,foreground);
+	gl.unpackColour(BACKGROUND,background);
+
+	for(;*str;str++) {
+
+		font.getCharacter(*str,fc);
+
+		gl.moveTo(Rectangle(pos.X,pos.Y,fc.PixelWidth,font.getHeight()));
+		gl.beginWriting();
+
+		for(y=0,index=0;y<font.getHeight();y++)
+			for(x=0;x<fc.PixelWidth;x++,index++)
+				gl.writePixel((fc.Data[index >> 3] & (1 << (index & 7)))!=0 ? foreground : background);
+
+		if(font.getCharacterSpacing())
+			gl.clearRectangle(Rectangle(pos.X+fc.PixelWidth,pos.Y,font.getCharacterSpacing(),font.getHeight()));
+
+		pos.X+=fc.PixelWidth+font.getCharacterSpacing();
+	}
+}
+
+
+/*
+ * Fill a line with a spread of the printable characters
+ */
+
+void makeLine(char *line,uint8_t number,uint8_t length) {
+
+	uint8_t i;
+
+	for(i=0;i<length;i++)
+		line[i]=32+(number*7+i*3) % 95;
+
+	line[length]='\0';
+}
+
+
+/*
+ * Write the lines with both renderers and check that they leave the same pixels. Returns the
+ * bus traffic of each.
+ */
+
+template<class TGraphicsLibrary,class TAccessMode>
+void testText(const Font& font,uint8_t lines,uint8_t length,BusProfile& byCharacter,BusProfile& batched) {
+
+	static TGraphicsLibrary gl;
+	GramSnapshot<ILI9325HostAccessMode> reference;
+	char line[LINE_LENGTH+1];
+	uint8_t i;
+
+	// the portrait and landscape libraries share the GRAM model so set up its orientation again
+
+	gl.initialise();
+	gl.setBackground(BACKGROUND);
+	gl.clearScreen();
+	gl.setForeground(FOREGROUND);
+
+	{
+		BusProfileScope<TAccessMode> scope(byCharacter);
+
+		for(i=0;i<lines;i++) {
+			makeLine(line,i,length);
+			writeStringByCharacter(gl,Point(3,i*font.getHeight()),font,line);
+		}
+	}
+
+	reference.save(gl.getWidth(),gl.getHeight());
+	gl.clearScreen();
+
+	{
+		BusProfileScope<TAccessMode> scope(batched);
+
+		for(i=0;i<lines;i++) {
+			makeLine(line,i,length);
+			gl.writeString(Point(3,i*font.getHeight()),font,line);
+		}
+	}
+
+	CHECK(reference.countDifferences()==0);
+}
+
+
+int main() {
+
+	typedef GraphicsLibrary<ILI9325<PORTRAIT,COLOURS_16BIT,ProfiledMode>,ProfiledMode> TPortrait;
+	typedef GraphicsLibrary<ILI9325<LANDSCAPE,COLOURS_16BIT,ProfiledMode>,ProfiledMode> TLandscape;
+
+	BusProfile byCharacter,batched,unused1,unused2;
+	Font_APPLE8 apple;
+	Font_TAMA_SS0117 tama;
+
+	// 520 characters, 7 commands for each one against 7 for each batch of 16
+
+	testText<TPortrait,ProfiledMode>(apple,LINES,LINE_LENGTH,byCharacter,batched);
+
+	printf("by character: %u commands, %u cycles\n",byCharacter.Commands,byCharacter.getTotalCycles());
+	printf("batched:      %u commands, %u cycles\n",batched.Commands,batched.getTotalCycles());
+
+	CHECK(byCharacter.Commands==LINES*LINE_LENGTH*7);
+	CHECK(batched.Commands==LINES*2*7);
+	CHECK(batched.getTotalCycles()*100<byCharacter.getTotalCycles()*45);
+
+	// proportional widths and spacing columns, kept inside the panel
+
+	testText<TLandscape,ProfiledMode>(apple,LINES,LINE_LENGTH,unused1,unused2);
+	testText<TPortrait,ProfiledMode>(tama,LINES,LINE_LENGTH-4,unused1,unused2);
+	testText<TLandscape,ProfiledMode>(tama,LINES-2,LINE_LENGTH,unused1,unused2);
+
+	return HostTest::getFailures();
+}
@@ -0,0 +1,128 @@
+/*
+  XMEM LCD Library for the Arduino
+
+  Copyright 2012,2013 Andrew Brown
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+/**
+ * @file WindowShadowTest.cpp
+ * @brief Check that window register shadowing leaves the same pixels with fewer commands
+ */
+
+#include "HostSimulation.h"
+#include "drv/accessModes/ProfilingAccessMode.h"
+#include "Font_apple.h"
+#include "HostTest.h"
+
+using namespace lcd;
+
+typedef ProfilingAccessMode<ILI9325HostAccessMode,Gpio16LatchCostTable,ili9325::ILI932X_RW_GRAM> ProfiledMode;
+
+
+/*
+ * Rectangle outlines and lines set up a new window for every edge or column but many of the
+ * window registers keep their values from one to the next. The shadow saves about 24% of the
+ * commands.
+ */
+
+template<class TGraphicsLibrary>
+uint32_t drawOutlines() {
+
+	static TGraphicsLibrary gl;
+	BusProfile profile;
+
+	gl.setBackground(0x102030);
+	gl.clearScreen();
+	gl.setForeground(ColourNames::RED);
+
+	{
+		BusProfileScope<ProfiledMode> scope(profile);
+
+		gl.drawRectangle(Rectangle(5,5,100,50));
+		gl.drawRectangle(Rectangle(20,100,30,120));
+		gl.drawLine(Point(0,0),Point(200,100));
+		gl.drawLine(Point(10,300),Point(60,60));
+	}
+
+	return profile.Commands;
+}
+
+
+/*
+ * A string is written through one window so there is less for the shadow to save, about 19%
+ */
+
+template<class TGraphicsLibrary>
+uint32_t drawText() {
+
+	static TGraphicsLibrary gl;
+	Font_APPLE8 font;
+	BusProfile profile;
+
+	gl.setBackground(0x102030);
+	gl.clearScreen();
+	gl.setForeground(ColourNames::WHITE);
+
+	{
+		BusProfileScope<ProfiledMode> scope(profile);
+
+		gl << font << Point(0,0) << "Hello world, this is text";
+		gl << Point(0,10) << "and this is more";
+	}
+
+	return profile.Commands;
+}
+
+
+template<Orientation TOrientation>
+void testShadowing() {
+
+	typedef GraphicsLibrary<ILI9325<TOrientation,COLOURS_16BIT,ProfiledMode,WINDOW_SHADOW_OFF>,ProfiledMode> Unshadowed;
+	typedef GraphicsLibrary<ILI9325<TOrientation,COLOURS_16BIT,ProfiledMode,WINDOW_SHADOW_ON>,ProfiledMode> Shadowed;
+
+	GramSnapshot<ILI9325HostAccessMode> reference;
+	uint32_t unshadowed,shadowed;
+	int16_t width,height;
+
+	width=TOrientation==PORTRAIT ? 240 : 320;
+	height=TOrientation==PORTRAIT ? 320 : 240;
+
+	unshadowed=drawOutlines<Unshadowed>();
+	reference.save(width,height);
+	shadowed=drawOutlines<Shadowed>();
+
+	CHECK(reference.countDifferences()==0);
+	CHECK(shadowed*100<=unshadowed*77);
+
+	unshadowed=drawText<Unshadowed>();
+	reference.save(width,height);
+	shadowed=drawText<Shadowed>();
+
+	CHECK(reference.countDifferences()==0);
+	CHECK(shadowed*100<=unshadowed*81);
+}
+
+
+int main() {
+
+	testShadowing<PORTRAIT>();
+	testShadowing<LANDSCAPE>();
+
+	return HostTest::getFailures();
+}
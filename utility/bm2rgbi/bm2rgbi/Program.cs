@@ -39,7 +39,7 @@ namespace bm2rgbi {
 
         if(args.Compress) {
           Console.WriteLine("Compressing converted bitmap");
-          compress(args.OutputBitmapFilename);
+          compress(args.OutputBitmapFilename,args.WindowSize);
         }
 
         Console.WriteLine("Completed OK");
@@ -51,16 +51,18 @@ namespace bm2rgbi {
 
 
     /// <summary>
-    /// Compress the target
+    /// Compress the target. The size of the history window that the decoder needs is appended
+    /// to the LZG data as a big-endian 32-bit number so that the decoder can check that it has
+    /// enough memory before it starts.
     /// </summary>
 
-    private void compress(string filename) {
+    private void compress(string filename,int windowSize) {
       
       string procpath,tempfile;
-      ProcessStartInfo psi;
-      Process p;
       FileInfo fi;
-      long oldlength,percent;
+      long oldlength,newlength,percent;
+      int level,needed;
+      byte[] data;
 
       // get our executable location
 
@@ -75,9 +77,55 @@ namespace bm2rgbi {
       fi=new FileInfo(filename);
       oldlength=fi.Length;
 
-      // run the compressor
+      // the default window only fits level 1 output. A larger window lets us try the higher
+      // levels, which search further back, and keep the first one that fits.
+
+      data=null;
+      needed=0;
+
+      for(level=windowSize>ProgramArgs.DefaultWindowSize ? 9 : 1;level>=1;level--) {
+
+        runCompressor(procpath,level,filename,tempfile);
+
+        data=File.ReadAllBytes(tempfile);
+        needed=getWindowSize(data);
+
+        if(needed<=windowSize)
+          break;
+      }
+
+      File.Delete(tempfile);
+
+      if(needed>windowSize)
+        throw new Exception("The compressed bitmap needs a "+needed+" byte window, more than the "+windowSize+" bytes allowed");
+
+      // write the compressed data and the window size trailer over the original
+
+      using(FileStream fs=new FileStream(filename,FileMode.Create,FileAccess.Write,FileShare.None)) {
+        fs.Write(data,0,data.Length);
+        fs.WriteByte((byte)(needed >> 24));
+        fs.WriteByte((byte)(needed >> 16));
+        fs.WriteByte((byte)(needed >> 8));
+        fs.WriteByte((byte)needed);
+        newlength=fs.Length;
+      }
+
+      percent=(oldlength-newlength)*100/oldlength;
+      Console.WriteLine("Compression completed: "+oldlength+" down to "+newlength+" ("+percent+"%) bytes, "+needed+" byte window");
+    }
+
+
+    /// <summary>
+    /// Run lzg.exe at the given level
+    /// </summary>
+
+    private void runCompressor(string procpath,int level,string filename,string tempfile) {
+
+      ProcessStartInfo psi;
+      Process p;
+      FileInfo fi;
 
-      psi=new ProcessStartInfo(Path.Combine(procpath,"lzg.exe"),"-1 "+filename+" "+tempfile);
+      psi=new ProcessStartInfo(Path.Combine(procpath,"lzg.exe"),"-"+level+" "+filename+" "+tempfile);
       psi.CreateNoWindow=true;
       psi.WindowStyle=ProcessWindowStyle.Hidden;
 
@@ -93,12 +141,65 @@ namespace bm2rgbi {
       fi=new FileInfo(tempfile);
       if(fi.Length==0)
         throw new Exception("The compression process (lzg.exe) failed");
+    }
+
+
+    /// <summary>
+    /// Walk the LZG stream and find the furthest back that any copy reaches. That's the
+    /// smallest history window that can decode it. Method 0 streams are stored uncompressed,
+    /// have no markers and need no window.
+    /// </summary>
+
+    private int getWindowSize(byte[] data) {
+
+      int pos,end,offset,maxOffset;
+      byte marker1,marker2,marker3,marker4,symbol,b;
+
+      // the method byte is the last byte of the header
+
+      if(data[15]==0)
+        return 0;
 
-      File.Delete(filename);
-      File.Move(tempfile,filename);
+      // the encoded size in the header does not include the 16 byte header
+
+      end=16+((data[7] << 24) | (data[8] << 16) | (data[9] << 8) | data[10]);
+
+      marker1=data[16];
+      marker2=data[17];
+      marker3=data[18];
+      marker4=data[19];
+
+      pos=20;
+      maxOffset=0;
+
+      while(pos<end) {
+
+        symbol=data[pos++];
+
+        if(symbol!=marker1 && symbol!=marker2 && symbol!=marker3 && symbol!=marker4)
+          continue;
+
+        // a zero following a marker is a literal marker symbol
+
+        if((b=data[pos++])==0)
+          continue;
+
+        if(symbol==marker1) {
+          offset=(((b & 0xe0) << 11) | (data[pos] << 8) | data[pos+1])+2056;
+          pos+=2;
+        }
+        else if(symbol==marker2)
+          offset=(((b & 0xe0) << 3) | data[pos++])+8;
+        else if(symbol==marker3)
+          offset=(b & 0x3f)+8;
+        else
+          offset=(b >> 5)+1;
+
+        if(offset>maxOffset)
+          maxOffset=offset;
+      }
 
-      percent=(oldlength-fi.Length)*100/oldlength;
-      Console.WriteLine("Compression completed: "+oldlength+" down to "+fi.Length+" ("+percent+"%) bytes");
+      return maxOffset;
     }
 
 
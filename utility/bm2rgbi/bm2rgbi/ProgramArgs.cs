@@ -16,6 +16,14 @@ namespace bm2rgbi {
     public string OutputBitmapFilename { get; private set; }
     public IBitmapConverter TargetDevice { get; private set; }
     public bool Compress { get; private set; }
+    public int WindowSize { get; private set; }
+
+
+  /// <summary>
+  /// The window that the Arduino decoder uses by default. It covers every LZG copy except a distant copy.
+  /// </summary>
+
+    public const int DefaultWindowSize=2056;
 
 
   /// <summary>
@@ -27,7 +35,7 @@ namespace bm2rgbi {
       int depth;
       string device;
 
-      if(args.Length!=4 && args.Length!=5)
+      if(args.Length<4 || args.Length>6)
         usage();
 
       InputBitmapFilename=args[0];
@@ -35,11 +43,16 @@ namespace bm2rgbi {
       device=args[2];
       depth=int.Parse(args[3]);
 
-      if(args.Length==5) {
+      this.WindowSize=DefaultWindowSize;
+
+      if(args.Length>=5) {
         if(args[4].Equals("-c"))
           this.Compress=true;
         else
           usage();
+
+        if(args.Length==6)
+          this.WindowSize=int.Parse(args[5]);
       }
       else
         this.Compress=false;
@@ -94,8 +107,9 @@ namespace bm2rgbi {
     
     private void usage() {
 
-      Console.WriteLine("Usage: bm2rgbi input-image-file output-image-file target-device target-colour-depth [-c]\n");
+      Console.WriteLine("Usage: bm2rgbi input-image-file output-image-file target-device target-colour-depth [-c [window-size]]\n");
       Console.WriteLine("-c : compress the output in LZG format");
+      Console.WriteLine("window-size : the largest history window in bytes that the decoder may use (default "+DefaultWindowSize+")");
       Console.WriteLine("Supported devices and colours:");
       Console.WriteLine("  ili9325 64");
       Console.WriteLine("  ili9325 262");
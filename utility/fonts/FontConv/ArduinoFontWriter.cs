@@ -127,6 +127,54 @@ namespace FontConv {
       }
 
       _sourceWriter.Write("  };\n\n");
+
+      WriteFontIndex();
+    }
+
+
+  /*
+   * write the code to position index and width table that give constant time lookup and measuring
+   */
+
+    private void WriteFontIndex() {
+
+      _sourceWriter.Write("  // character index for "+_font.Identifier+"\n\n");
+      _sourceWriter.Write("  extern const uint8_t __attribute__((progmem)) "+GetIndexName()+"[] PROGMEM={ ");
+
+      foreach(int index in GetCharacterIndex())
+        _sourceWriter.Write(index+",");
+
+      _sourceWriter.Write("};\n\n");
+
+      _sourceWriter.Write("  // character widths for "+_font.Identifier+"\n\n");
+      _sourceWriter.Write("  extern const uint8_t __attribute__((progmem)) "+GetWidthsName()+"[] PROGMEM={ ");
+
+      foreach(char c in _font.Characters())
+        _sourceWriter.Write(GetCharWidth(c)+",");
+
+      _sourceWriter.Write("};\n\n");
+    }
+
+
+  /*
+   * index declarations for the header
+   */
+
+    override protected string GetIndexDeclarations() {
+      return "  extern const uint8_t "+GetIndexName()+"[];\n"
+            +"  extern const uint8_t "+GetWidthsName()+"[];\n";
+    }
+
+    override protected string GetIndexArguments() {
+      return ","+GetIndexName()+","+GetCharacterIndex().Count+","+GetWidthsName();
+    }
+
+    private string GetIndexName() {
+      return _font.Identifier+"_INDEX";
+    }
+
+    private string GetWidthsName() {
+      return _font.Identifier+"_WIDTHS";
     }
   }
 }
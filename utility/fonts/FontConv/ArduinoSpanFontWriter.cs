@@ -0,0 +1,89 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Windows.Forms;
+using System.Xml;
+
+
+namespace FontConv {
+  
+  /*
+   * Class for writing out Arduino fonts that store each character row as runs of foreground
+   * pixels. The library draws these with SpanFont and never writes the background.
+   */
+
+  public class ArduinoSpanFontWriter : ArduinoFontWriter {
+
+    /*
+     * Constructor
+     */
+
+    public ArduinoSpanFontWriter(SizedFont sf,StreamWriter headerWriter,StreamWriter sourceWriter,XmlElement parent,Control refControl)
+      : base(sf,headerWriter,sourceWriter,parent,refControl) {
+    }
+
+
+  /*
+   * the generated class derives from SpanFont
+   */
+
+    override protected string GetFontClassName() {
+      return "SpanFont";
+    }
+
+
+  /*
+   * write font span declarations. each row is a count byte followed by (x,length) pairs.
+   */
+
+    override protected void WriteFontBytes() {
+      
+      List<int> row;
+      bool[,] values;
+      int x,y,start;
+
+      _sourceWriter.Write("  // span definitions for "+_font.Identifier+"\n\n");
+
+      row=new List<int>();
+
+      foreach(char c in _font.Characters()) {
+
+        _sourceWriter.Write("  const uint8_t __attribute__((progmem)) "+GetBytesName(c)+"[] PROGMEM={ ");
+
+        values=FontUtil.GetCharacterBitmap(_refControl,_font.GdiFont,c,_font.XOffset,_font.YOffset,_font.ExtraLines);
+          
+        for(y=0;y<values.GetLength(1);y++) {
+
+          // find the runs of set pixels on this row
+
+          row.Clear();
+
+          for(x=0;x<values.GetLength(0);) {
+
+            if(!values[x,y]) {
+              x++;
+              continue;
+            }
+
+            start=x;
+            while(x<values.GetLength(0) && values[x,y])
+              x++;
+
+            row.Add(start);
+            row.Add(x-start);
+          }
+
+          // count followed by the pairs
+
+          _sourceWriter.Write((row.Count/2).ToString()+",");
+
+          foreach(int b in row)
+            _sourceWriter.Write(b.ToString()+",");
+        }
+
+        _sourceWriter.Write("};\n");
+      }
+      _sourceWriter.Write("\n");
+    }
+  }
+}
@@ -1,4 +1,5 @@
 ﻿using System;
+using System.Collections.Generic;
 using System.Drawing;
 using System.Drawing.Text;
 using System.IO;
@@ -86,6 +87,10 @@ namespace FontConv {
               fw=new ArduinoFontWriter(sf,headerWriter,sourceWriter,root,refControl);
               break;
 
+            case TargetDevice.ARDUINO_SPANS:
+              fw=new ArduinoSpanFontWriter(sf,headerWriter,sourceWriter,root,refControl);
+              break;
+
             case TargetDevice.STM32PLUS:
               fw=new Stm32plusFontWriter(sf,headerWriter,sourceWriter,root,refControl);
               break;
@@ -180,6 +185,56 @@ namespace FontConv {
     }
 
 
+  /*
+   * get the index declaration names. derivations that emit a glyph index return the declarations
+   * for the header and the extra constructor arguments. the default is no index.
+   */
+
+    virtual protected string GetIndexDeclarations() {
+      return "";
+    }
+
+    virtual protected string GetIndexArguments() {
+      return "";
+    }
+
+
+  /*
+   * get the name of the library class that the generated font class derives from
+   */
+
+    virtual protected string GetFontClassName() {
+      return "Font";
+    }
+
+
+  /*
+   * get the position in the character array of each code from the first character to the last,
+   * with 255 for the codes that are not in the font
+   */
+
+    protected List<int> GetCharacterIndex() {
+
+      List<int> table=new List<int>();
+      int code,first,index;
+
+      first=_font.GetFirstCharacter();
+      index=0;
+
+      foreach(char c in _font.Characters()) {
+
+        code=Convert.ToUInt16(c);
+
+        while(table.Count<code-first)
+          table.Add(255);
+
+        table.Add(index++);
+      }
+
+      return table;
+    }
+
+
     /*
      * Write the font declaration
      */
@@ -195,12 +250,13 @@ namespace FontConv {
 
       _headerWriter.Write("  // helper so the user can just do 'new fontname' without having to know the parameters\n\n");
 
-      _headerWriter.Write("  extern const struct FontChar "+GetCharName()+"[];\n\n");
+      _headerWriter.Write("  extern const struct FontChar "+GetCharName()+"[];\n");
+      _headerWriter.Write(GetIndexDeclarations()+"\n");
 
-      _headerWriter.Write("  class Font_"+_font.Name+_font.Size+" : public Font {\n");
+      _headerWriter.Write("  class Font_"+_font.Name+_font.Size+" : public "+GetFontClassName()+" {\n");
       _headerWriter.Write("    public:\n");
       _headerWriter.Write("      Font_"+_font.Name+_font.Size+"()\n");
-      _headerWriter.Write("        : Font("+firstChar+","+charCount+","+height+","+spacing+","+GetCharName()+") {\n");
+      _headerWriter.Write("        : "+GetFontClassName()+"("+firstChar+","+charCount+","+height+","+spacing+","+GetCharName()+GetIndexArguments()+") {\n");
       _headerWriter.Write("      }\n");
       _headerWriter.Write("  };\n");
     }
@@ -61,6 +61,7 @@
       this._saveFileDialog = new System.Windows.Forms.SaveFileDialog();
       this._btnStm32plus = new System.Windows.Forms.RadioButton();
       this._btnArduino = new System.Windows.Forms.RadioButton();
+      this._btnArduinoSpans = new System.Windows.Forms.RadioButton();
       this.groupBox4 = new System.Windows.Forms.GroupBox();
       this._openFontFileDialog = new System.Windows.Forms.OpenFileDialog();
       this._logo = new System.Windows.Forms.PictureBox();
@@ -428,14 +429,26 @@
       this._btnArduino.Text = "Arduino";
       this._btnArduino.UseVisualStyleBackColor = true;
       // 
+      // _btnArduinoSpans
+      // 
+      this._btnArduinoSpans.AutoSize = true;
+      this._btnArduinoSpans.Location = new System.Drawing.Point(10, 61);
+      this._btnArduinoSpans.Name = "_btnArduinoSpans";
+      this._btnArduinoSpans.Size = new System.Drawing.Size(93, 17);
+      this._btnArduinoSpans.TabIndex = 2;
+      this._btnArduinoSpans.TabStop = true;
+      this._btnArduinoSpans.Text = "Arduino spans";
+      this._btnArduinoSpans.UseVisualStyleBackColor = true;
+      // 
       // groupBox4
       // 
       this.groupBox4.Anchor = ((System.Windows.Forms.AnchorStyles)((System.Windows.Forms.AnchorStyles.Top | System.Windows.Forms.AnchorStyles.Right)));
       this.groupBox4.Controls.Add(this._btnStm32plus);
       this.groupBox4.Controls.Add(this._btnArduino);
+      this.groupBox4.Controls.Add(this._btnArduinoSpans);
       this.groupBox4.Location = new System.Drawing.Point(954, 74);
       this.groupBox4.Name = "groupBox4";
-      this.groupBox4.Size = new System.Drawing.Size(97, 68);
+      this.groupBox4.Size = new System.Drawing.Size(108, 89);
       this.groupBox4.TabIndex = 5;
       this.groupBox4.TabStop = false;
       this.groupBox4.Text = "Target";
@@ -522,6 +535,7 @@
     private System.Windows.Forms.SaveFileDialog _saveFileDialog;
     private System.Windows.Forms.RadioButton _btnStm32plus;
     private System.Windows.Forms.RadioButton _btnArduino;
+    private System.Windows.Forms.RadioButton _btnArduinoSpans;
     private System.Windows.Forms.GroupBox groupBox4;
     private System.Windows.Forms.OpenFileDialog _openFontFileDialog;
     private System.Windows.Forms.Button _btnSelectAlpha;
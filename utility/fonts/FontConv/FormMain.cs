@@ -363,6 +363,8 @@ namespace FontConv
 
         if(_btnArduino.Checked)
           td=TargetDevice.ARDUINO;
+        else if(_btnArduinoSpans.Checked)
+          td=TargetDevice.ARDUINO_SPANS;
         else if(_btnStm32plus.Checked)
           td=TargetDevice.STM32PLUS;
         else
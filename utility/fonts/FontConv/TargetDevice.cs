@@ -7,6 +7,7 @@ namespace FontConv {
 
   public enum TargetDevice {
     STM32PLUS,
-    ARDUINO
+    ARDUINO,
+    ARDUINO_SPANS
   };
 }
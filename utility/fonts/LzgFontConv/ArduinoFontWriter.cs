@@ -115,6 +115,64 @@ namespace LzgFontConv {
       }
 
       writer.Write("  };\n\n");
+
+      WriteFontIndex(writer);
+    }
+
+
+    /// <summary>
+    /// write the code to position index and width table that give constant time lookup and measuring
+    /// </summary>
+
+    private void WriteFontIndex(TextWriter writer) {
+
+      writer.Write("  // character index for "+GetFontNameAndSize()+"\n\n");
+      writer.Write("  extern const uint8_t __attribute__((progmem)) "+GetIndexName()+"[] PROGMEM={ ");
+
+      foreach(int index in GetCharacterIndex())
+        writer.Write(index+",");
+
+      writer.Write("};\n\n");
+
+      writer.Write("  // character widths for "+GetFontNameAndSize()+"\n\n");
+      writer.Write("  extern const uint8_t __attribute__((progmem)) "+GetWidthsName()+"[] PROGMEM={ ");
+
+      foreach(CharDef cd in _charDefs.Definitions)
+        writer.Write(cd.Size.Width+",");
+
+      writer.Write("};\n\n");
+    }
+
+
+    /// <summary>
+    /// declarations of the index tables for the header
+    /// </summary>
+
+    protected override string GetIndexDeclarations() {
+      return "  extern const uint8_t "+GetIndexName()+"[];\n"
+            +"  extern const uint8_t "+GetWidthsName()+"[];\n";
+    }
+
+
+    /// <summary>
+    /// the index tables as extra constructor arguments
+    /// </summary>
+
+    protected override string GetIndexArguments() {
+      return ","+GetIndexName()+","+GetCharacterIndex().Count+","+GetWidthsName();
+    }
+
+
+    /// <summary>
+    /// names of the index tables
+    /// </summary>
+
+    private string GetIndexName() {
+      return "FDEF_"+GetFontName()+"_INDEX";
+    }
+
+    private string GetWidthsName() {
+      return "FDEF_"+GetFontName()+"_WIDTHS";
     }
   }
 }
@@ -142,17 +142,59 @@ namespace LzgFontConv {
       
       writer.Write("  // helper so the user can just do 'new fontname' without having to know the parameters\n\n");
 
-      writer.Write("  extern const struct FontChar FDEF_"+GetFontName()+"_CHAR[];\n\n");
+      writer.Write("  extern const struct FontChar FDEF_"+GetFontName()+"_CHAR[];\n");
+      writer.Write(GetIndexDeclarations()+"\n");
 
       writer.Write("  class Font_"+GetFontNameAndSize()+" : public LzgFont {\n");
       writer.Write("    public:\n");
       writer.Write("      Font_"+GetFontNameAndSize()+"()\n");
-      writer.Write("        : LzgFont("+GetFirstCharacter()+","+this.FontDef.Characters.Length+","+GetFontHeight()+","+this.FontDef.Spacing+",FDEF_"+GetFontName()+"_CHAR"+") {\n");
+      writer.Write("        : LzgFont("+GetFirstCharacter()+","+this.FontDef.Characters.Length+","+GetFontHeight()+","+this.FontDef.Spacing+",FDEF_"+GetFontName()+"_CHAR"+GetIndexArguments()+") {\n");
       writer.Write("      }\n");
       writer.Write("  };\n");
     }
 
 
+    /// <summary>
+    /// header declarations for a glyph index. derivations that emit an index override this
+    /// together with GetIndexArguments. the default is no index.
+    /// </summary>
+
+    protected virtual string GetIndexDeclarations() {
+      return "";
+    }
+
+
+    /// <summary>
+    /// extra font constructor arguments for a glyph index
+    /// </summary>
+
+    protected virtual string GetIndexArguments() {
+      return "";
+    }
+
+
+    /// <summary>
+    /// get the position in the character array of each code from the first character to the last,
+    /// with 255 for the codes that are not in the font
+    /// </summary>
+
+    protected List<int> GetCharacterIndex() {
+
+      List<int> table=new List<int>();
+      int index;
+
+      for(index=0;index<this.FontDef.Characters.Length;index++) {
+
+        while(table.Count<this.FontDef.Characters[index]-GetFirstCharacter())
+          table.Add(255);
+
+        table.Add(index);
+      }
+
+      return table;
+    }
+
+
     /// <summary>
     /// get just the font name
     /// </summary>